@@ -0,0 +1,254 @@
+/**
+ * @file    devices.c
+ * @brief   Devices accessible through the VFS
+ *
+ * @note    Data is moved directly between the caller buffer (normally the
+ *          newlib FILE buffer) and the device. There is no intermediate copy
+ *          except for the LCD, which holds the text of the field being written
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#undef errno
+extern int errno;
+
+#include "em_device.h"
+#include "vfs.h"
+#include "devices.h"
+#include "uart.h"
+#include "lcd.h"
+
+/**
+ * @brief   UART0
+ *
+ * @note    read blocks until at least one char is received and then returns
+ *          the chars already in the input buffer until a line end
+ */
+///@{
+static int uart_read(File_t *f, char *ptr, int len) {
+int n = 0;
+char c;
+
+    if( len <= 0 )
+        return 0;
+
+    c = UART_GetChar();
+    do {
+        ptr[n++] = c;
+        if( (c == '\n') || (c == '\r') )
+            break;
+    } while( (n < len) && ((c = UART_GetCharNoWait()) != 0) );
+    return n;
+}
+
+static int uart_write(File_t *f, const char *ptr, int len) {
+int i;
+
+    for(i=0;i<len;i++)
+        UART_SendChar(ptr[i]);
+    return len;
+}
+
+static const Device_t uart0 = {
+    .name   = "/dev/uart0",
+    .read   = uart_read,
+    .write  = uart_write,
+    .istty  = 1
+};
+///@}
+
+/**
+ * @brief   Segment LCD
+ *
+ * @note    Chars are written in the alphanumeric field (7 positions)
+ * @note    A new line or carriage return starts a new field. A form feed clears it
+ * @note    The LCD is a low energy peripheral. Its clock is LFACLK, taken from
+ *          LFRCO when no source was selected before
+ * @note    Special symbols are not supported by lcd.c. Their requests fail
+ *          with ENOSYS
+ */
+///@{
+#define LCDFIELDSIZE 7
+
+static char lcdfield[LCDFIELDSIZE+1];
+static int  lcdcol = 0;
+
+static int lcd_open(File_t *f, int flags) {
+static int initialized = 0;
+
+    if( !initialized ) {
+        /* Enable clock for low energy peripherals interface */
+        CMU->HFCORECLKEN0 |= CMU_HFCORECLKEN0_LE;
+        /* Use LFRCO for LFA clock branch, when it has no source */
+        if( (CMU->LFCLKSEL&(_CMU_LFCLKSEL_LFA_MASK|CMU_LFCLKSEL_LFAE)) == 0 ) {
+            CMU->OSCENCMD = CMU_OSCENCMD_LFRCOEN;
+            while( (CMU->STATUS&CMU_STATUS_LFRCORDY) == 0 ) {}
+            CMU->LFCLKSEL = (CMU->LFCLKSEL&~_CMU_LFCLKSEL_LFA_MASK)|CMU_LFCLKSEL_LFA_LFRCO;
+        }
+        CMU->LFACLKEN0 |= CMU_LFACLKEN0_LCD;            // Enable LFACLK for LCD
+        while( CMU->SYNCBUSY&CMU_SYNCBUSY_LFACLKEN0 ) {}
+        LCD_Init();
+        initialized = 1;
+    }
+    return 0;
+}
+
+static int lcd_write(File_t *f, const char *ptr, int len) {
+int i;
+
+    for(i=0;i<len;i++) {
+        switch(ptr[i]) {
+        case '\n':
+        case '\r':
+            lcdcol = 0;
+            break;
+        case '\f':
+            lcdcol = 0;
+            memset(lcdfield,0,sizeof(lcdfield));
+            break;
+        default:
+            if( lcdcol == 0 )
+                memset(lcdfield,0,sizeof(lcdfield));
+            if( lcdcol < LCDFIELDSIZE )
+                lcdfield[lcdcol++] = ptr[i];
+        }
+    }
+    LCD_WriteAlphanumericField(lcdfield);
+    return len;
+}
+
+static int lcd_ioctl(File_t *f, int request, void *arg) {
+
+    switch(request) {
+    case IOCTL_LCD_CLEAR:
+        LCD_Clear();
+        lcdcol = 0;
+        memset(lcdfield,0,sizeof(lcdfield));
+        break;
+    case IOCTL_LCD_NUMERIC:
+        LCD_WriteNumericField((char *) arg);
+        break;
+    case IOCTL_LCD_SPECIAL_ON:
+    case IOCTL_LCD_SPECIAL_OFF:
+        errno = ENOSYS;
+        return -1;
+    default:
+        errno = EINVAL;
+        return -1;
+    }
+    return 0;
+}
+
+static const Device_t lcd = {
+    .name   = "/dev/lcd",
+    .open   = lcd_open,
+    .write  = lcd_write,
+    .ioctl  = lcd_ioctl
+};
+///@}
+
+/**
+ * @brief   RAM disk
+ *
+ * @note    Contents is kept while the board is powered. Opening with O_TRUNC
+ *          empties it
+ */
+///@{
+static char ramdisk[RAMDISKSIZE];
+static int  ramsize = 0;
+
+static int ram_open(File_t *f, int flags) {
+
+    if( flags&O_TRUNC )
+        ramsize = 0;
+    if( flags&O_APPEND )
+        f->pos = ramsize;
+    return 0;
+}
+
+static int ram_read(File_t *f, char *ptr, int len) {
+
+    if( len > ramsize-f->pos )
+        len = ramsize-f->pos;
+    if( len <= 0 )
+        return 0;
+    memcpy(ptr,ramdisk+f->pos,len);
+    f->pos += len;
+    return len;
+}
+
+static int ram_write(File_t *f, const char *ptr, int len) {
+
+    if( f->flags&O_APPEND )
+        f->pos = ramsize;
+    if( len > RAMDISKSIZE-f->pos )
+        len = RAMDISKSIZE-f->pos;
+    if( len <= 0 ) {
+        errno = ENOSPC;
+        return -1;
+    }
+    memcpy(ramdisk+f->pos,ptr,len);
+    f->pos += len;
+    if( f->pos > ramsize )
+        ramsize = f->pos;
+    return len;
+}
+
+static int ram_lseek(File_t *f, int offset, int whence) {
+int pos;
+
+    switch(whence) {
+    case SEEK_SET:  pos = offset;           break;
+    case SEEK_CUR:  pos = f->pos+offset;    break;
+    case SEEK_END:  pos = ramsize+offset;   break;
+    default:        pos = -1;               break;
+    }
+    if( (pos < 0) || (pos > RAMDISKSIZE) ) {
+        errno = EINVAL;
+        return -1;
+    }
+    f->pos = pos;
+    return pos;
+}
+
+static int ram_ioctl(File_t *f, int request, void *arg) {
+
+    switch(request) {
+    case IOCTL_RAM_SIZE:
+        *(int *) arg = ramsize;
+        break;
+    case IOCTL_RAM_DATA:
+        *(char **) arg = ramdisk;
+        break;
+    default:
+        errno = EINVAL;
+        return -1;
+    }
+    return 0;
+}
+
+static const Device_t ram0 = {
+    .name   = "/dev/ram0",
+    .open   = ram_open,
+    .read   = ram_read,
+    .write  = ram_write,
+    .ioctl  = ram_ioctl,
+    .lseek  = ram_lseek
+};
+///@}
+
+/**
+ * @brief   Device table
+ *
+ * @note    First device is the console
+ */
+
+const Device_t * const VFS_Devices[] = {
+    &uart0,
+    &lcd,
+    &ram0,
+    0
+};
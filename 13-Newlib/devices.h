@@ -0,0 +1,29 @@
+#ifndef DEVICES_H
+#define DEVICES_H
+/**
+ * @file    devices.h
+ * @brief   Devices accessible through the VFS
+ *
+ * @note    /dev/uart0  UART0 (console). Used for stdin, stdout and stderr
+ * @note    /dev/lcd    Segment LCD. Text is shown in the alphanumeric field
+ * @note    /dev/ram0   RAM disk. Seekable
+ */
+
+/// Size of RAM disk in bytes
+#ifndef RAMDISKSIZE
+#define RAMDISKSIZE     4096
+#endif
+
+/**
+ * @brief   ioctl requests
+ */
+///@{
+#define IOCTL_LCD_CLEAR         1       ///< Clear LCD. arg not used
+#define IOCTL_LCD_NUMERIC       2       ///< Write string pointed by arg in numeric field
+#define IOCTL_LCD_SPECIAL_ON    3       ///< Turn on special symbol. Not supported (ENOSYS)
+#define IOCTL_LCD_SPECIAL_OFF   4       ///< Turn off special symbol. Not supported (ENOSYS)
+#define IOCTL_RAM_SIZE          5       ///< Store in int pointed by arg the number of bytes written
+#define IOCTL_RAM_DATA          6       ///< Store in char * pointed by arg the RAM disk address
+///@}
+
+#endif // DEVICES_H
@@ -0,0 +1,23 @@
+#ifndef EFM32GG990F1024_H
+#define EFM32GG990F1024_H
+/**
+ * @file    efm32gg990f1024.h
+ * @brief   Host replacement of the device header for the pool benchmark
+ *
+ * @note    em_device.h includes this file instead of the one in the Gecko SDK,
+ *          because the host folder is first in the include path
+ *
+ * @note    Only the CMSIS intrinsics used by pool.c are provided. The
+ *          benchmark has no interrupts, so exclusive accesses always succeed
+ *
+ * @note    As on the Cortex-M, they access 32 bit words. pool.c keeps pointers
+ *          in them, so the pools must be below 4 GB (see Makefile)
+ */
+
+#include <stdint.h>
+
+static inline uint32_t __LDREXW(volatile uint32_t *a)               { return *a; }
+static inline uint32_t __STREXW(uint32_t v, volatile uint32_t *a)   { *a = v; return 0; }
+static inline void     __CLREX(void)                                { }
+
+#endif // EFM32GG990F1024_H
@@ -0,0 +1,223 @@
+/**
+ * @file    poolbench.c
+ * @brief   Host benchmark of pool_alloc/pool_free against malloc/free
+ *
+ * @note    First checks the pool: all blocks can be allocated, then
+ *          pool_alloc returns 0, pool_free refuses blocks of other pools and
+ *          pointers inside a block, and the high water mark is kept.
+ *
+ * @note    Then measures the time of an allocation plus a free (ns), the
+ *          minimum of RUNS runs, for three block sizes and three patterns:
+ *          - pair:   a block is allocated and freed at once
+ *          - batch:  all COUNT blocks are allocated, then all are freed
+ *          - random: a random slot of COUNT is allocated when empty and
+ *                    freed when not
+ *          The first word of each block is written, so the compiler does not
+ *          remove the malloc/free pairs.
+ *
+ * @note    Times are of the host. On the board, pool_alloc and pool_free are
+ *          a few LDREX/STREX loops, while newlib malloc walks its free lists.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "pool.h"
+
+/// Blocks in each pool (and slots of the random pattern)
+#define COUNT           (64)
+
+/// Allocations and frees of each run
+#define OPS             (4000000)
+
+/// Runs. The fastest is reported
+#define RUNS            (5)
+
+/**
+ * @brief   Pools of the three block sizes
+ */
+///@{
+static DECLARE_POOL(area16,16,COUNT);
+static DECLARE_POOL(area64,64,COUNT);
+static DECLARE_POOL(area256,256,COUNT);
+///@}
+
+/**
+ * @brief   Allocator under test
+ */
+typedef struct {
+    const char  *name;
+    pool        p;                      ///< 0 for malloc
+    int         size;
+} Allocator_t;
+
+static void        *slots[COUNT];
+static volatile unsigned sink;
+static int          failures = 0;
+
+/**
+ * @brief   Allocates a block and writes its first word
+ */
+
+static inline void *
+alloc(Allocator_t *a) {
+void *b = a->p ? pool_alloc(a->p) : malloc(a->size);
+
+    *(volatile unsigned *) b = 1;
+    return b;
+}
+
+/**
+ * @brief   Frees a block
+ */
+
+static inline void
+release(Allocator_t *a, void *b) {
+
+    sink += *(volatile unsigned *) b;
+    if( a->p )
+        (void) pool_free(a->p,b);
+    else
+        free(b);
+}
+
+/**
+ * @brief   Patterns. Each one does OPS allocations and frees
+ */
+///@{
+static void
+pair(Allocator_t *a) {
+int i;
+
+    for(i=0;i<OPS;i++)
+        release(a,alloc(a));
+}
+
+static void
+batch(Allocator_t *a) {
+int i,k;
+
+    for(i=0;i<OPS;i+=COUNT) {
+        for(k=0;k<COUNT;k++)
+            slots[k] = alloc(a);
+        for(k=0;k<COUNT;k++) {
+            release(a,slots[k]);
+            slots[k] = 0;
+        }
+    }
+}
+
+static void
+scatter(Allocator_t *a) {
+uint32_t r = 1;
+int i,k;
+
+    for(i=0;i<2*OPS;i++) {
+        r = r*1664525+1013904223;       // LCG (Numerical Recipes)
+        k = (int) (r>>26);              // 0 to 63
+        if( slots[k] ) {
+            release(a,slots[k]);
+            slots[k] = 0;
+        } else {
+            slots[k] = alloc(a);
+        }
+    }
+    for(k=0;k<COUNT;k++) {
+        if( slots[k] ) {
+            release(a,slots[k]);
+            slots[k] = 0;
+        }
+    }
+}
+///@}
+
+/**
+ * @brief   Returns the fastest of RUNS runs of f in ns per allocation and free
+ */
+
+static double
+measure(void (*f)(Allocator_t *), Allocator_t *a) {
+struct timespec t0,t1;
+double ns,best = 0;
+int r;
+
+    for(r=0;r<RUNS;r++) {
+        clock_gettime(CLOCK_MONOTONIC,&t0);
+        f(a);
+        clock_gettime(CLOCK_MONOTONIC,&t1);
+        ns = ((t1.tv_sec-t0.tv_sec)*1e9+(t1.tv_nsec-t0.tv_nsec))/OPS;
+        if( (r == 0) || (ns < best) )
+            best = ns;
+    }
+    return best;
+}
+
+/**
+ * @brief   Prints a failed check
+ */
+
+static void
+check(int ok, const char *what) {
+
+    if( !ok ) {
+        printf("FAIL: %s\n",what);
+        failures++;
+    }
+}
+
+/**
+ * @brief   Checks the pool of 16 byte blocks
+ */
+
+static void
+verify(pool p) {
+char *b[COUNT];
+int i;
+
+    for(i=0;i<COUNT;i++)
+        b[i] = pool_alloc(p);
+    check(b[0] && b[COUNT-1],"all blocks allocated");
+    check(b[1]-b[0] == pool_blocksize(p),"blocks are consecutive");
+    check(pool_alloc(p) == 0,"pool_alloc returns 0 when exhausted");
+    check(pool_exhausted(p),"pool_exhausted");
+    check(pool_used(p) == COUNT,"pool_used");
+    check(pool_free(p,b[0]+4) == -1,"pointer inside a block refused");
+    check(pool_free(p,area64) == -1,"block of other pool refused");
+    for(i=0;i<COUNT;i++)
+        check(pool_free(p,b[i]) == 0,"block freed");
+    check(pool_used(p) == 0,"pool_used after free");
+    check(pool_highwater(p) == COUNT,"pool_highwater");
+    check(pool_alloc(p) == b[COUNT-1],"last freed is first allocated");
+    (void) pool_free(p,b[COUNT-1]);
+}
+
+int main(void) {
+Allocator_t a[6] = {
+    { "pool",   0, 16  }, { "malloc", 0, 16  },
+    { "pool",   0, 64  }, { "malloc", 0, 64  },
+    { "pool",   0, 256 }, { "malloc", 0, 256 }
+};
+int i;
+
+    if( (uintptr_t) &area256[sizeof(area256)/sizeof(unsigned)] > UINT32_MAX ) {
+        printf("FAIL: pools above 4 GB. Link with -no-pie\n");
+        return 1;
+    }
+    a[0].p = pool_init(area16,16,COUNT);
+    a[2].p = pool_init(area64,64,COUNT);
+    a[4].p = pool_init(area256,256,COUNT);
+
+    verify(a[0].p);
+    if( failures )
+        return failures;
+
+    printf("ns per allocation and free (fastest of %d runs of %d)\n",RUNS,OPS);
+    printf("allocator  size      pair     batch    random\n");
+    for(i=0;i<6;i++) {
+        printf("%-8s  %5d  %8.2f  %8.2f  %8.2f\n",a[i].name,a[i].size,
+                measure(pair,&a[i]),measure(batch,&a[i]),measure(scatter,&a[i]));
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file    hrtime.c
+ * @brief   Monotonic high resolution clock
+ *
+ * @note    Time in cycles is ticks*(LOAD+1) + (LOAD-VAL), since SysTick counts
+ *          down from LOAD to 0. The tick counter and VAL must be read as a
+ *          pair. If the counter reaches 0 while they are read, the SysTick
+ *          interrupt is pending but the tick counter was not incremented yet.
+ *          This is detected by the PENDSTSET bit of ICSR.
+ *
+ * @note    Reading is done with interrupts disabled for a few cycles, so it is
+ *          consistent when called from tasks and from interrupt routines.
+ *          COUNTFLAG is not used, because reading CTRL clears it.
+ */
+
+#include <stdint.h>
+#include "em_device.h"
+#include "hrtime.h"
+
+/**
+ * @brief   Macros to enhance portability
+ */
+#define ENTER_ATOMIC()  uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define EXIT_ATOMIC()   __set_PRIMASK(primask)
+
+/// Number of SysTick interrupts since reset
+static volatile uint64_t ticks = 0;
+
+/**
+ * @brief   Increments tick counter. Must be called from SysTick_Handler
+ */
+
+void HRTime_Tick(void) {
+
+    ticks++;
+}
+
+/**
+ * @brief   Returns number of ticks since reset
+ */
+
+uint64_t HRTime_GetTicks(void) {
+uint64_t t;
+
+    ENTER_ATOMIC();
+    t = ticks;
+    EXIT_ATOMIC();
+    return t;
+}
+
+/**
+ * @brief   Returns number of core clock cycles since reset
+ *
+ * @note    Accurate while SysTick interrupts are not delayed for more than
+ *          one tick period
+ */
+
+uint64_t HRTime_GetCycles(void) {
+uint64_t t;
+uint32_t val,load;
+
+    ENTER_ATOMIC();
+    t    = ticks;
+    load = SysTick->LOAD;
+    val  = SysTick->VAL;
+    if( SCB->ICSR&SCB_ICSR_PENDSTSET_Msk ) {
+        // Counter reached 0, but SysTick_Handler did not run yet
+        t++;
+        val = SysTick->VAL;
+    }
+    EXIT_ATOMIC();
+
+    return t*(load+1) + (load-val);
+}
+
+/**
+ * @brief   Returns number of microseconds since reset
+ */
+
+uint64_t HRTime_GetMicroseconds(void) {
+
+    return HRTime_GetCycles()/(SystemCoreClock/1000000);
+}
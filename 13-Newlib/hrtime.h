@@ -0,0 +1,22 @@
+#ifndef HRTIME_H
+#define HRTIME_H
+/**
+ * @file    hrtime.h
+ * @brief   Monotonic high resolution clock
+ *
+ * @note    Combines a tick counter, incremented in SysTick_Handler, with the
+ *          current value of the SysTick counter. Resolution is one core clock
+ *          cycle (about 21 ns at 48 MHz).
+ *
+ * @note    HRTime_Tick must be called from SysTick_Handler and SysTick must
+ *          be configured with SysTick_Config before use
+ */
+
+#include <stdint.h>
+
+void        HRTime_Tick(void);
+uint64_t    HRTime_GetTicks(void);
+uint64_t    HRTime_GetCycles(void);
+uint64_t    HRTime_GetMicroseconds(void);
+
+#endif // HRTIME_H
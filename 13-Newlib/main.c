@@ -17,6 +17,7 @@
 
 #include "led.h"
 #include "uart.h"
+#include "hrtime.h"
 
 
 /*************************************************************************//**
@@ -24,12 +25,10 @@
  */
 const int TickDivisor = 1000; // milliseconds
 
-volatile uint64_t tick = 0;
-
 void SysTick_Handler (void) {
 static int counter = 0;
 
-    tick++;
+    HRTime_Tick();
 
     if( counter == 0 ) {
         counter = TickDivisor;
@@ -41,9 +40,9 @@ static int counter = 0;
 
 
 void Delay(int delay) {
-uint64_t l = tick+delay;
+uint64_t l = HRTime_GetTicks()+delay;
 
-    while(tick<l) {}
+    while(HRTime_GetTicks()<l) {}
 
 }
 
@@ -59,6 +58,7 @@ uint64_t l = tick+delay;
 
 int main(void) {
 char line[100];
+FILE *lcd;
 
     /* Configure LEDs */
     LED_Init(LED0|LED1);
@@ -77,11 +77,18 @@ char line[100];
 
     __enable_irq();
 
+    /* LCD is accessed through the VFS. No buffering, so it is updated at once */
+    lcd = fopen("/dev/lcd","w");
+    if( lcd )
+        setvbuf(lcd,0,_IONBF,0);
+
     printf("\r\n\n\n\rHello\n\r");
     while (1) {
         printf("\r\n\n\n\rWhat is your name?\n");
         fgets(line,99,stdin);
         printf("Hello %s\n",line);
+        if( lcd )
+            fprintf(lcd,"\f%s",line);
     }
 
 }
@@ -0,0 +1,126 @@
+/**
+ * @file    pool.c
+ *
+ * @note    Pool of fixed size blocks
+ * @note    Uses a global data defined by DECLARE_POOL macro
+ * @note    It does not use malloc
+ * @note    Block size and count must be defined in DECLARE_POOL and in pool_init (Ugly)
+ * @note    pool_alloc and pool_free can be called from interrupt routines.
+ *          They do not disable interrupts, but use LDREX/STREX instead
+ *
+ * @note    The free list is a LIFO. ABA problem does not arise on a single core
+ *          Cortex-M, because the exclusive monitor is cleared at every exception
+ *          entry and return. So if an interrupt routine touches the list between
+ *          LDREX and STREX, the STREX fails and the operation is retried.
+ */
+
+#include <stdint.h>
+#include "em_device.h"
+#include "pool.h"
+
+/**
+ * @brief   Macros to enhance portability
+ */
+#define LOAD_EXCLUSIVE(A)       __LDREXW((volatile uint32_t *)(A))
+#define STORE_EXCLUSIVE(V,A)    __STREXW((uint32_t)(V),(volatile uint32_t *)(A))
+#define CLEAR_EXCLUSIVE()       __CLREX()
+
+
+/**
+ * @brief   Atomically adds d to used counter and updates high water mark
+ */
+
+static void
+pool_count(pool p, int d) {
+int n,h;
+
+    do {
+        n = (int) LOAD_EXCLUSIVE(&p->used) + d;
+    } while( STORE_EXCLUSIVE(n,&p->used) );
+
+    if( d < 0 )
+        return;
+
+    do {
+        h = (int) LOAD_EXCLUSIVE(&p->highwater);
+        if( n <= h ) {
+            CLEAR_EXCLUSIVE();
+            return;
+        }
+    } while( STORE_EXCLUSIVE(n,&p->highwater) );
+}
+
+/**
+ * @brief   initializes a pool area
+ *
+ * @note    All blocks are linked in the free list
+ */
+
+pool
+pool_init(void *area, int blocksize, int count) {
+pool p = (pool) area;
+int words = POOL_BLOCKWORDS(blocksize);
+unsigned *b;
+int i;
+
+    p->blocksize = words*sizeof(unsigned);
+    p->capacity  = count;
+    p->used      = 0;
+    p->highwater = 0;
+    p->free      = 0;
+
+    // Link from last to first, so first block is allocated first
+    for(i=count-1;i>=0;i--) {
+        b = p->data+i*words;
+        *(void **) b = p->free;
+        p->free = b;
+    }
+    return p;
+}
+
+/**
+ * @brief   Get a block from pool
+ *
+ * @note    return 0 when there is no free block
+ * @note    O(1). Can be called from interrupt routines
+ */
+
+void *
+pool_alloc(pool p) {
+void **b;
+
+    do {
+        b = (void **) LOAD_EXCLUSIVE(&p->free);
+        if( b == 0 ) {
+            CLEAR_EXCLUSIVE();
+            return 0;
+        }
+    } while( STORE_EXCLUSIVE(*b,&p->free) );
+
+    pool_count(p,1);
+    return b;
+}
+
+/**
+ * @brief   Return a block to pool
+ *
+ * @note    return -1 when block does not belong to pool
+ * @note    O(1). Can be called from interrupt routines
+ */
+
+int
+pool_free(pool p, void *b) {
+unsigned *w = (unsigned *) b;
+int offset = w - p->data;
+
+    if( (w < p->data) || (offset >= POOL_BLOCKWORDS(p->blocksize)*p->capacity)
+        || (offset%POOL_BLOCKWORDS(p->blocksize)) )
+        return -1;
+
+    do {
+        *(void **) b = (void *) LOAD_EXCLUSIVE(&p->free);
+    } while( STORE_EXCLUSIVE(b,&p->free) );
+
+    pool_count(p,-1);
+    return 0;
+}
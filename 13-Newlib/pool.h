@@ -0,0 +1,45 @@
+#ifndef POOL_H
+#define POOL_H
+/**
+ *  @file   pool.h
+ */
+
+
+/**
+ *  @brief  Data structure to store info about a pool of fixed size blocks,
+ *          including the blocks
+ *
+ * @note    Uses x[0] hack. This structure is a header
+ * @note    First element is a pointer to force data alignement
+ * @note    Free blocks are linked through their first word
+ */
+
+struct pool_s {
+    void    * volatile free;    // pointer to first free block
+    int     blocksize;          // size of a block in bytes (rounded up to words)
+    int     capacity;           // number of blocks in data
+    volatile int used;          // number of blocks allocated
+    volatile int highwater;     // maximum number of blocks allocated at same time
+    unsigned data[];            // flexible array
+};
+
+typedef struct pool_s *pool;
+
+/// Number of words used by a block. It must hold at least a pointer
+#define POOL_BLOCKWORDS(BLOCKSIZE) \
+    ((((BLOCKSIZE)<sizeof(void *)?sizeof(void *):(BLOCKSIZE))+sizeof(unsigned)-1)/sizeof(unsigned))
+
+#define DECLARE_POOL(NAME,BLOCKSIZE,COUNT) unsigned NAME[(sizeof(struct pool_s)+sizeof(unsigned)-1)/sizeof(unsigned) \
+                                                         +POOL_BLOCKWORDS(BLOCKSIZE)*(COUNT)]
+
+pool    pool_init(void *area, int blocksize, int count);
+void   *pool_alloc(pool p);
+int     pool_free(pool p, void *b);
+
+#define pool_capacity(P) ((P)->capacity)
+#define pool_blocksize(P) ((P)->blocksize)
+#define pool_used(P) ((P)->used)
+#define pool_highwater(P) ((P)->highwater)
+#define pool_exhausted(P) ((P)->free==0)
+
+#endif
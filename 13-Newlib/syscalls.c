@@ -5,8 +5,11 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <sys/stat.h>
+#include <sys/time.h>
 #include <sys/times.h>
+#include <time.h>
 
 /**
  * @brief errno
@@ -51,6 +54,16 @@ static inline char * GetStackPointer(void) { return (char *) __get_MSP(); }
  */
 #include "syscalls.h"
 
+/**
+ * @brief   File descriptors are mapped to devices by the VFS
+ */
+#include "vfs.h"
+
+/**
+ * @brief   High resolution clock used by _times and _gettimeofday
+ */
+#include "hrtime.h"
+
 /**
  * @brief Interface to a serial interface for a minimal implementation
  *
@@ -59,8 +72,6 @@ static inline char * GetStackPointer(void) { return (char *) __get_MSP(); }
 #include "uart.h"
 
 void SerialInit(void)           { UART_Init();                }
-void SerialWrite(char c)        { UART_SendChar(c);           }
-int  SerialRead(void)           { return UART_GetChar();  }
 int  SerialStatus(void)         { return UART_GetStatus();    }
 //@}
 
@@ -87,10 +98,10 @@ void _exit(void) {
 /**
  * @brief   close
  *
- * @note    Close a file. Minimal implementation.
+ * @note    Close a file. Releases the entry in the VFS file table.
  */
 int _close(int file) {
-    return -1;
+    return VFS_Close(file);
 }
 
 /**
@@ -130,14 +141,18 @@ int _fork(void) {
 /**
  * @brief   fstat
  *
- * @note    Status of an open file. For consistency with other minimal implementations
- *          in these examples, all files are regarded as character special devices.
+ * @note    Status of an open file. Seekable devices are regarded as block special
+ *          devices and the others as character special devices.
  *          The sys/stat.h header file required is distributed in the include subdirectory
  *          for this C library.
  */
 
 int _fstat(int file, struct stat *st) {
-    st->st_mode = S_IFCHR;
+const Device_t *d = VFS_GetDevice(file);
+
+    if( !d )
+        return -1;
+    st->st_mode = d->lseek ? S_IFBLK : S_IFCHR;
     return 0;
 }
 
@@ -156,12 +171,11 @@ int _getpid(void) {
  * @brief   isatty
  *
  * @note    Query whether output stream is a terminal.
- *          For consistency with the other minimal implementations,
- *          which only support output to stdout, this minimal implementation is suggested.
+ *          Only the UART is a terminal.
  */
 
 int _isatty(int file) {
-    return 1;
+    return VFS_IsTTY(file);
 }
 
 /**
@@ -188,31 +202,31 @@ int _link(char *old, char *new) {
 /**
  * @brief   lseek
  *
- * @note    Set position in a file. Minimal implementation.
+ * @note    Set position in a file. Only block devices (e.g. /dev/ram0) are seekable.
  */
 
 int _lseek(int file, int ptr, int dir) {
-    return 0;
+    return VFS_Lseek(file,ptr,dir);
 }
 
 /**
  * @brief   open
  *
- * @note    Open a file. Minimal implementation.
+ * @note    Open a file. Name must be a device in VFS device table (e.g. /dev/lcd).
  */
 
 int _open(const char *name, int flags, int mode) {
-    return -1;
+    return VFS_Open(name,flags,mode);
 }
 
 /**
  * @brief   read
  *
- * @note    Read from a file. Minimal implementation.
+ * @note    Read from a file. The device does the work.
  */
 
 int _read(int file, char *ptr, int len) {
-    return 0;
+    return VFS_Read(file,ptr,len);
 }
 
 /**
@@ -245,22 +259,55 @@ char *prev_heap_end;
 /**
  * @brief   stat
  *
- * @note    Status of a file (by name). Minimal implementation.
+ * @note    Status of a file (by name). Only devices in VFS device table exist.
  */
 
 int _stat(char *file, struct stat *st) {
-    st->st_mode = S_IFCHR;
-    return 0;
+const Device_t * const *d;
+
+    for(d=VFS_Devices;*d;d++) {
+        if( strcmp((*d)->name,file) == 0 ) {
+            st->st_mode = (*d)->lseek ? S_IFBLK : S_IFCHR;
+            return 0;
+        }
+    }
+    errno = ENOENT;
+    return -1;
 }
 
 /**
  * @brief   times
  *
- * @note    Timing information for current process. Minimal implementation.
+ * @note    Timing information for current process.
+ * @note    All time is user time, measured in CLOCKS_PER_SEC units. clock() uses it
  */
 
 int _times(struct tms *buf) {
-    return -1;
+clock_t t;
+
+    t = (clock_t) (HRTime_GetCycles()/(SystemCoreClock/CLOCKS_PER_SEC));
+    buf->tms_utime  = t;
+    buf->tms_stime  = 0;
+    buf->tms_cutime = 0;
+    buf->tms_cstime = 0;
+    return t;
+}
+
+/**
+ * @brief   gettimeofday
+ *
+ * @note    Time since reset with microsecond resolution. There is no time zone
+ */
+
+int _gettimeofday(struct timeval *tv, void *tz) {
+uint64_t us;
+
+    if( tv ) {
+        us = HRTime_GetMicroseconds();
+        tv->tv_sec  = us/1000000;
+        tv->tv_usec = us%1000000;
+    }
+    return 0;
 }
 
 /**
@@ -298,10 +345,5 @@ int _wait(int *status) {
  */
 
 int _write(int file, char *ptr, int len) {
-    int todo;
-
-    for (todo = 0; todo < len; todo++) {
-        SerialWrite(*ptr++);
-    }
-    return len;
+    return VFS_Write(file,ptr,len);
 }
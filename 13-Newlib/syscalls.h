@@ -7,6 +7,7 @@
  */
 #include <stdlib.h>
 #include <sys/stat.h>
+#include <sys/time.h>
 #include <sys/times.h>
 
 void _exit(void);
@@ -17,6 +18,7 @@ int _execve(char *name, char **argv, char **env);
 int _fork(void);
 int _fstat(int file, struct stat *st);
 int _getpid(void);
+int _gettimeofday(struct timeval *tv, void *tz);
 int _isatty(int file);
 int _kill(int pid, int sig);
 int _link(char *old, char *new);
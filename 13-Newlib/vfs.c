@@ -0,0 +1,199 @@
+/**
+ * @file    vfs.c
+ * @brief   Minimal virtual file system for newlib file descriptors
+ *
+ * @note    File descriptors 0, 1 and 2 (stdin, stdout and stderr) are
+ *          statically assigned to the first device in VFS_Devices
+ * @note    Errors are reported in errno, like the system calls
+ */
+
+#include <string.h>
+#include <errno.h>
+#undef errno
+extern int errno;
+
+#include "vfs.h"
+
+/**
+ *  @var    files
+ *  @brief  File table. Index is the file descriptor
+ *
+ *  @note   The first device in VFS_Devices is the console
+ */
+static File_t files[VFS_MAXFILES] = {
+    { 0, 0, 0 },
+    { 0, 1, 0 },
+    { 0, 1, 0 }
+};
+
+/**
+ * @brief   Returns a pointer to entry in file table or 0 when fd is invalid
+ *
+ * @note    Binds stdin, stdout and stderr to console on first use
+ */
+
+static File_t *
+getfile(int fd) {
+File_t *f;
+
+    if( (fd < 0) || (fd >= VFS_MAXFILES) ) {
+        errno = EBADF;
+        return 0;
+    }
+    f = &files[fd];
+    if( (f->device == 0) && (fd <= 2) )
+        f->device = VFS_Devices[0];
+    if( f->device == 0 ) {
+        errno = EBADF;
+        return 0;
+    }
+    return f;
+}
+
+/**
+ * @brief   Opens a device
+ *
+ * @note    Linear search in device table, but it is only done here
+ * @note    Descriptors 0 to 2 are never returned. They belong to console
+ */
+
+int VFS_Open(const char *name, int flags, int mode) {
+const Device_t * const *d;
+int fd;
+
+    for(d=VFS_Devices;*d;d++) {
+        if( strcmp((*d)->name,name) == 0 )
+            break;
+    }
+    if( *d == 0 ) {
+        errno = ENOENT;
+        return -1;
+    }
+
+    for(fd=3;fd<VFS_MAXFILES;fd++) {
+        if( files[fd].device == 0 )
+            break;
+    }
+    if( fd == VFS_MAXFILES ) {
+        errno = ENFILE;
+        return -1;
+    }
+
+    files[fd].flags = flags;
+    files[fd].pos   = 0;
+    if( (*d)->open && ((*d)->open(&files[fd],flags) < 0) ) {
+        return -1;
+    }
+    files[fd].device = *d;
+
+    return fd;
+}
+
+/**
+ * @brief   Closes a file
+ */
+
+int VFS_Close(int fd) {
+File_t *f = getfile(fd);
+int rc = 0;
+
+    if( !f )
+        return -1;
+    if( fd <= 2 )
+        return 0;
+
+    if( f->device->close )
+        rc = f->device->close(f);
+    f->device = 0;
+    return rc;
+}
+
+/**
+ * @brief   Reads from a file
+ */
+
+int VFS_Read(int fd, char *ptr, int len) {
+File_t *f = getfile(fd);
+
+    if( !f )
+        return -1;
+    if( !f->device->read ) {
+        errno = EINVAL;
+        return -1;
+    }
+    return f->device->read(f,ptr,len);
+}
+
+/**
+ * @brief   Writes to a file
+ */
+
+int VFS_Write(int fd, const char *ptr, int len) {
+File_t *f = getfile(fd);
+
+    if( !f )
+        return -1;
+    if( !f->device->write ) {
+        errno = EINVAL;
+        return -1;
+    }
+    return f->device->write(f,ptr,len);
+}
+
+/**
+ * @brief   Device specific control
+ *
+ * @note    There is no ioctl system call in newlib. Use it with fileno(fp)
+ */
+
+int VFS_Ioctl(int fd, int request, void *arg) {
+File_t *f = getfile(fd);
+
+    if( !f )
+        return -1;
+    if( !f->device->ioctl ) {
+        errno = ENOTTY;
+        return -1;
+    }
+    return f->device->ioctl(f,request,arg);
+}
+
+/**
+ * @brief   Set position in a file
+ *
+ * @note    Character devices are not seekable and always return 0
+ */
+
+int VFS_Lseek(int fd, int offset, int whence) {
+File_t *f = getfile(fd);
+
+    if( !f )
+        return -1;
+    if( !f->device->lseek )
+        return 0;
+    return f->device->lseek(f,offset,whence);
+}
+
+/**
+ * @brief   Returns 1 when file is a terminal
+ */
+
+int VFS_IsTTY(int fd) {
+File_t *f = getfile(fd);
+
+    if( !f )
+        return 0;
+    return f->device->istty;
+}
+
+/**
+ * @brief   Returns device of an open file or 0
+ */
+
+const Device_t *VFS_GetDevice(int fd) {
+File_t *f = getfile(fd);
+
+    if( !f )
+        return 0;
+    return f->device;
+}
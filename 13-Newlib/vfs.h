@@ -0,0 +1,60 @@
+#ifndef VFS_H
+#define VFS_H
+/**
+ * @file    vfs.h
+ * @brief   Minimal virtual file system for newlib file descriptors
+ *
+ * @note    A device is found by its path (e.g. /dev/uart0) only when opened.
+ *          After that, the file descriptor is an index into the file table
+ *          and every access is O(1).
+ */
+
+/// Maximum number of open files (including stdin, stdout and stderr)
+#ifndef VFS_MAXFILES
+#define VFS_MAXFILES    8
+#endif
+
+typedef struct File_s File_t;
+
+/**
+ * @typedef Device_t
+ * @brief   Information about a device
+ *
+ * @note    Any function pointer can be 0, when the operation is not supported
+ * @note    Functions return -1 on error, like the system calls
+ */
+typedef struct {
+    const char *name;                                   ///< Path (e.g. /dev/uart0)
+    int     (*open)(File_t *f, int flags);              ///< Called when a file is opened
+    int     (*close)(File_t *f);                        ///< Called when a file is closed
+    int     (*read)(File_t *f, char *ptr, int len);     ///< Read at most len chars
+    int     (*write)(File_t *f, const char *ptr, int len);///< Write len chars
+    int     (*ioctl)(File_t *f, int request, void *arg);///< Device specific control
+    int     (*lseek)(File_t *f, int offset, int whence);///< Set position (only block devices)
+    int     istty;                                      ///< Set when device is a terminal
+} Device_t;
+
+/**
+ * @brief   Information about an open file
+ */
+struct File_s {
+    const Device_t  *device;            ///< Device. 0 when entry is free
+    int             flags;              ///< Flags used in open
+    int             pos;                ///< Position (only for block devices)
+};
+
+/**
+ * @brief   Device table. Terminated by a null pointer. Defined in devices.c
+ */
+extern const Device_t * const VFS_Devices[];
+
+int VFS_Open(const char *name, int flags, int mode);
+int VFS_Close(int fd);
+int VFS_Read(int fd, char *ptr, int len);
+int VFS_Write(int fd, const char *ptr, int len);
+int VFS_Ioctl(int fd, int request, void *arg);
+int VFS_Lseek(int fd, int offset, int whence);
+int VFS_IsTTY(int fd);
+const Device_t *VFS_GetDevice(int fd);
+
+#endif // VFS_H
@@ -0,0 +1,173 @@
+/**
+ * @file        bench_tt.c
+ * @brief       port of the common benchmark (bench.h) to the time-triggered kernel
+ *
+ * @note        The kernel runs with SysTick, as in main.c, until there are
+ *              BENCH_SAMPLES samples of the co-operative switch:
+ *              - coop:     end of BenchFirst until start of BenchSecond,
+ *                          both released in the same tick. This is the cost of
+ *                          Task_Dispatch between two tasks
+ *              - preempt:  release of the pre-emptive task in Task_Update until
+ *                          it runs in PendSV (Task_GetLatency)
+ *              - tick:     release of BenchFirst in the tick interrupt until it
+ *                          runs in the main loop (Task_GetLatency)
+ *              The pre-emptive task is released in the other ticks, so it does
+ *              not delay BenchFirst.
+ *
+ * @note        Tasks are only released by the tick, so isr (BENCH_IRQn waking
+ *              a task) is n/a. The tick row, not in the other kernels, is the
+ *              nearest measurement and is reported under its own name.
+ *
+ * @note        There are no queues nor semaphores. The message test uses the
+ *              char FIFO of the UART driver (buffer.c), one char at a time.
+ *              sem is n/a. Tasks have no stack and the task table is static
+ *              (TASK_N entries), so task is n/a.
+ *
+ * @note        Must be called before the tasks of the application are added
+ *              and before SysTick is configured. Clears the tasks table
+ *
+ * @note        Needs TASK_PROFILE. Without it the file is empty, so the other
+ *              builds are not affected
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "em_device.h"
+
+#include "tt_tasks.h"
+#include "buffer.h"
+#include "uart.h"
+#include "bench.h"
+
+// Bench_Start uses the latency statistics. main.c refuses BENCHMARK without them
+#if TASK_PROFILE
+
+/// Period of the benchmark tasks (ticks). Co-operative and pre-emptive tasks alternate
+#define PERIOD  (2)
+
+/**
+ * @brief   Global variables
+ */
+///@{
+static BenchStat_t          coop;
+static volatile uint32_t    firstend = 0;       ///< cycle counter at end of BenchFirst
+static volatile int         firstran = 0;
+static volatile uint32_t    preemptive = 0;     ///< runs of BenchPreemptive
+///@}
+
+/// Message FIFO
+DECLARE_BUFFER_AREA(msgarea,BENCH_MSGSIZE);
+
+/**
+ * @brief   Writes a line when the output buffer has space for it
+ */
+
+static void
+Write(const char *s) {
+
+    while( UART_GetTxSpace() < strlen(s) ) {}
+    UART_SendString((char *) s);
+}
+
+/**
+ * @brief   Copies the latency of a task into a statistics
+ */
+
+static void
+fromprofile(BenchStat_t *stat, const TaskProfile_t *p) {
+
+    stat->n   = p->count;
+    stat->min = p->min;
+    stat->max = p->max;
+    stat->sum = p->sum;
+}
+
+/**
+ * @brief   Benchmark tasks
+ */
+///@{
+static void
+BenchFirst(void) {
+
+    firstran = 1;
+    firstend = BENCH_NOW();
+}
+
+static void
+BenchSecond(void) {
+uint32_t now = BENCH_NOW();
+
+    if( firstran && coop.n < BENCH_SAMPLES )
+        Bench_Add(&coop,now-firstend);
+    firstran = 0;
+}
+
+static void
+BenchPreemptive(void) {
+
+    preemptive++;
+}
+///@}
+
+/**
+ * @brief   Sends a message to the FIFO and gets it back, char by char
+ */
+
+static void
+Message(void) {
+BenchStat_t stat;
+buffer fifo;
+uint32_t c;
+int i,k;
+
+    fifo = buffer_init(msgarea,BENCH_MSGSIZE);
+    Bench_Clear(&stat);
+    for(i=0;i<BENCH_SAMPLES;i++) {
+        c = BENCH_NOW();
+        for(k=0;k<BENCH_MSGSIZE;k++)
+            (void) buffer_insert(fifo,(char) k);
+        for(k=0;k<BENCH_MSGSIZE;k++)
+            (void) buffer_remove(fifo);
+        Bench_Add(&stat,BENCH_NOW()-c);
+    }
+    Bench_Report("message",&stat);
+}
+
+/**
+ * @details The tick is stopped at the end. main configures it again
+ */
+
+void Bench_Start(void) {
+BenchStat_t stat;
+int first,preempt;
+
+    __enable_irq();
+    Bench_Init("tt",Write);
+
+    Task_Init();
+    Bench_Clear(&coop);
+    first   = Task_Add(BenchFirst,PERIOD,0);
+    (void) Task_Add(BenchSecond,PERIOD,0);
+    preempt = Task_AddPreemptive(BenchPreemptive,PERIOD,1);
+
+    SysTick_Config(SystemCoreClock/TASK_TICK_HZ);
+    while( coop.n < BENCH_SAMPLES )
+        Task_Dispatch();
+    SysTick->CTRL = 0;
+    SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+
+    Bench_Report("coop",&coop);
+    fromprofile(&stat,Task_GetLatency(preempt));
+    Bench_Report("preempt",&stat);
+    Bench_Report("isr",0);
+    fromprofile(&stat,Task_GetLatency(first));
+    Bench_Report("tick",&stat);
+    Task_Init();
+
+    Message();
+    Bench_Report("sem",0);
+    Bench_ReportMemory(0);
+    Bench_End();
+}
+
+#endif
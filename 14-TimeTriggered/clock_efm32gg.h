@@ -61,4 +61,7 @@ void     ClockConfigureForFrequency(uint32_t freq);
 void     ClockSetHFClockDivisor(uint32_t div);
 void     ClockSetPrescalers(uint32_t corediv, uint32_t perdiv);
 
+uint32_t GetHFPeripheralClockFrequency(void);
+uint32_t GetHFCoreClockFrequency(void);
+
 #endif //SYSTEM_EFM32GG_EXT_H
@@ -0,0 +1,448 @@
+/**
+ * @file    ttgen.c
+ * @brief   Generates a static cyclic executive table for tt_tasks.c
+ *
+ * @note    Runs on the host at build time:
+ *
+ *              ttgen schedule.def tt_schedule.c
+ *
+ * @note    Input format (one directive per line, # starts a comment):
+ *
+ *              tick     <period of tick interrupt in us>
+ *              reserve  <us of each tick used by interrupts and pre-emptive task>
+ *              task     <function> <period in ticks> <offset in ticks> <WCET in us>
+ *
+ * @note    The minor cycle is the greatest common divisor of all periods and
+ *          offsets, so every release is at the start of a minor cycle (frame).
+ *          The major cycle is the least common multiple of the periods.
+ *          Tasks of a frame run in the order they are defined.
+ *
+ * @note    Schedulability is checked by simulating two major cycles of the
+ *          non-preemptive execution done by Task_Dispatch, with each task
+ *          taking its WCET and each tick losing reserve us. A task must
+ *          complete before its next release (deadline equal to period) and
+ *          the remaining work at the end of both major cycles must be the
+ *          same. Otherwise, nothing is written and the exit code is 1, so the
+ *          build stops.
+ *
+ * @note    A frame can end after the next one is released (e.g. a long task).
+ *          The maximum number of frames pending at a release is written in
+ *          the table, so Task_Update counts only unexpected delays as overruns.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+
+/// Limits
+///@{
+#define MAXTASKS    (64)
+#define MAXNAME     (64)
+#define MAXLINE     (256)
+#define MAXINDEX    (65535)             ///< frame indexes are uint16_t
+#define MAXTICKS    (1UL<<24)           ///< longest major cycle simulated
+///@}
+
+/**
+ * @brief   Task as defined in input file
+ */
+typedef struct {
+    char        name[MAXNAME];
+    uint32_t    period;                 ///< in ticks
+    uint32_t    offset;                 ///< in ticks
+    uint32_t    wcet;                   ///< in us
+    uint64_t    response;               ///< worst response time found (us)
+    int         line;                   ///< line in input file
+} Task_t;
+
+/**
+ * @brief   Job (a release of a task) in the simulation
+ */
+typedef struct {
+    int         task;
+    uint64_t    release;                ///< in ticks
+    uint32_t    remaining;              ///< in us
+} Job_t;
+
+static Task_t   tasks[MAXTASKS];
+static int      ntasks = 0;
+static uint32_t tick = 0;
+static uint32_t reserve = 0;
+
+static uint32_t minor;                  ///< in ticks
+static uint32_t frames;                 ///< minor cycles in major cycle
+static uint32_t nlist;                  ///< releases in major cycle
+static uint32_t backlog;                ///< maximum frames pending at a release
+
+static const char *input;
+
+/**
+ * @brief   Prints an error and exits
+ */
+
+static void
+fail(int line, const char *msg, const char *name) {
+
+    if( line )
+        fprintf(stderr,"%s:%d: ",input,line);
+    else
+        fprintf(stderr,"%s: ",input);
+    if( name )
+        fprintf(stderr,"%s: ",name);
+    fprintf(stderr,"%s\n",msg);
+    exit(1);
+}
+
+static uint64_t
+gcd(uint64_t a, uint64_t b) {
+uint64_t t;
+
+    while( b ) {
+        t = a%b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/**
+ * @brief   Returns 1 when s is a C identifier
+ */
+
+static int
+isname(const char *s) {
+
+    if( !isalpha((unsigned char) *s) && (*s != '_') )
+        return 0;
+    while( *++s ) {
+        if( !isalnum((unsigned char) *s) && (*s != '_') )
+            return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief   Reads the input file
+ */
+
+static void
+readdef(void) {
+FILE *f;
+char line[MAXLINE];
+char word[MAXNAME];
+char name[MAXNAME];
+char *p;
+unsigned long v1,v2,v3;
+int n,ln = 0;
+Task_t *t;
+
+    f = fopen(input,"r");
+    if( !f )
+        fail(0,"cannot open",0);
+    while( fgets(line,sizeof(line),f) ) {
+        ln++;
+        if( (p=strchr(line,'#')) )
+            *p = '\0';
+        if( sscanf(line,"%63s",word) != 1 )
+            continue;
+        if( strcmp(word,"tick") == 0 ) {
+            if( sscanf(line,"%*s %lu %n",&v1,&n) != 1 || line[n] || v1 == 0 )
+                fail(ln,"tick must be a positive number of us",0);
+            tick = v1;
+        } else if( strcmp(word,"reserve") == 0 ) {
+            if( sscanf(line,"%*s %lu %n",&v1,&n) != 1 || line[n] )
+                fail(ln,"reserve must be a number of us",0);
+            reserve = v1;
+        } else if( strcmp(word,"task") == 0 ) {
+            if( sscanf(line,"%*s %63s %lu %lu %lu %n",name,&v1,&v2,&v3,&n) != 4 || line[n] )
+                fail(ln,"expected: task <function> <period> <offset> <wcet>",0);
+            if( ntasks == MAXTASKS )
+                fail(ln,"too many tasks",0);
+            if( !isname(name) )
+                fail(ln,"not a C identifier",name);
+            if( v1 == 0 || v1 > UINT32_MAX )
+                fail(ln,"period must be positive",name);
+            if( v2 >= v1 )
+                fail(ln,"offset must be less than period",name);
+            if( v3 == 0 || v3 > UINT32_MAX )
+                fail(ln,"WCET must be positive",name);
+            t = &tasks[ntasks++];
+            strcpy(t->name,name);
+            t->period = v1;
+            t->offset = v2;
+            t->wcet   = v3;
+            t->line   = ln;
+        } else {
+            fail(ln,"unknown directive",word);
+        }
+    }
+    fclose(f);
+    if( tick == 0 )
+        fail(0,"tick not defined",0);
+    if( reserve >= tick )
+        fail(0,"reserve must be less than tick",0);
+    if( ntasks == 0 )
+        fail(0,"no tasks",0);
+}
+
+/**
+ * @brief   Computes minor and major cycles and the size of the table
+ */
+
+static void
+cycles(void) {
+uint64_t g = 0, h = 1;
+uint64_t n = 0;
+int i;
+
+    for(i=0;i<ntasks;i++) {
+        g = gcd(g,tasks[i].period);
+        g = gcd(g,tasks[i].offset);
+        h = h/gcd(h,tasks[i].period)*tasks[i].period;
+        if( h > MAXTICKS )
+            fail(tasks[i].line,"major cycle too long",tasks[i].name);
+    }
+    if( h/g > MAXINDEX )
+        fail(0,"major cycle has too many minor cycles",0);
+    minor  = g;
+    frames = h/g;
+    for(i=0;i<ntasks;i++)
+        n += h/tasks[i].period;
+    if( n > MAXINDEX )
+        fail(0,"too many releases in major cycle",0);
+    nlist = n;
+}
+
+/**
+ * @brief   Returns 1 when task i is released in frame f
+ */
+
+static int
+released(int i, uint32_t f) {
+
+    return ((uint64_t) f*minor)%tasks[i].period == tasks[i].offset;
+}
+
+/**
+ * @brief   Simulates two major cycles of Task_Dispatch
+ *
+ * @note    Jobs run in release order (frames in order, tasks of a frame in
+ *          definition order) and are not preempted
+ */
+
+static void
+simulate(void) {
+Job_t *jobs;
+uint32_t *frameend;
+uint32_t head = 0, tail = 0;
+uint32_t oldest = 0;
+uint64_t t,g,h,used,r,finish,deadline;
+uint64_t work[2] = {0,0};
+uint64_t load = 0;
+uint32_t k;
+int i;
+char msg[128];
+
+    for(i=0;i<ntasks;i++)
+        load += (uint64_t) tasks[i].wcet*(frames*(uint64_t) minor/tasks[i].period);
+    if( load > (uint64_t) frames*minor*(tick-reserve) )
+        fail(0,"utilization above 100 %",0);
+
+    jobs     = malloc(2*nlist*sizeof(Job_t));
+    frameend = malloc(2*frames*sizeof(uint32_t));
+    if( !jobs || !frameend )
+        fail(0,"out of memory",0);
+
+    h = (uint64_t) frames*minor;
+    for(t=0;t<2*h;t++) {
+        if( t == h ) {
+            for(k=head;k<tail;k++)
+                work[0] += jobs[k].remaining;
+        }
+        if( t%minor == 0 ) {
+            // Frame release
+            g = t/minor;
+            while( (oldest < g) && (head >= frameend[oldest]) )
+                oldest++;
+            if( g-oldest > backlog )
+                backlog = g-oldest;
+            for(i=0;i<ntasks;i++) {
+                if( released(i,g%frames) ) {
+                    jobs[tail].task      = i;
+                    jobs[tail].release   = t;
+                    jobs[tail].remaining = tasks[i].wcet;
+                    tail++;
+                }
+            }
+            frameend[g] = tail;
+        }
+        // Processing during tick t
+        used = reserve;
+        while( (head < tail) && (used < tick) ) {
+            r = jobs[head].remaining;
+            if( r > tick-used )
+                r = tick-used;
+            jobs[head].remaining -= r;
+            used += r;
+            if( jobs[head].remaining == 0 ) {
+                i        = jobs[head].task;
+                finish   = t*tick+used;
+                deadline = (jobs[head].release+tasks[i].period)*tick;
+                if( finish > deadline ) {
+                    snprintf(msg,sizeof(msg),"released at tick %llu misses its deadline by %llu us",
+                            (unsigned long long) jobs[head].release,
+                            (unsigned long long) (finish-deadline));
+                    fail(tasks[i].line,msg,tasks[i].name);
+                }
+                if( finish-jobs[head].release*tick > tasks[i].response )
+                    tasks[i].response = finish-jobs[head].release*tick;
+                head++;
+            }
+        }
+    }
+    for(k=head;k<tail;k++)
+        work[1] += jobs[k].remaining;
+    if( work[1] > work[0] )
+        fail(0,"pending work grows every major cycle",0);
+
+    free(jobs);
+    free(frameend);
+}
+
+/**
+ * @brief   Returns file name without directory
+ */
+
+static const char *
+basename(const char *path) {
+const char *p = strrchr(path,'/');
+
+    return p ? p+1 : path;
+}
+
+/**
+ * @brief   Writes a numeric field of the table with a comment
+ */
+
+static void
+field(FILE *f, uint32_t v, const char *comment) {
+char s[16];
+
+    snprintf(s,sizeof(s),"%lu,",(unsigned long) v);
+    fprintf(f,"    %-12s// %s\n",s,comment);
+}
+
+/**
+ * @brief   Writes the table
+ */
+
+static void
+writetable(const char *output) {
+FILE *f;
+uint64_t load = 0;
+uint32_t fr,n;
+int i,j,c;
+
+    for(i=0;i<ntasks;i++)
+        load += (uint64_t) tasks[i].wcet*(frames*(uint64_t) minor/tasks[i].period);
+    load = load*1000/((uint64_t) frames*minor*tick);
+
+    f = fopen(output,"w");
+    if( !f ) {
+        fprintf(stderr,"%s: cannot create\n",output);
+        exit(1);
+    }
+
+    fprintf(f,"/**\n");
+    fprintf(f," * @file    %s\n",basename(output));
+    fprintf(f," * @brief   Static cyclic executive table\n");
+    fprintf(f," *\n");
+    fprintf(f," * @note    Generated by gen/ttgen from %s. Do not edit\n",input);
+    fprintf(f," *\n");
+    fprintf(f," * @note    Tick %lu us (%lu us reserved). Minor cycle %lu ticks.\n",
+                (unsigned long) tick,(unsigned long) reserve,(unsigned long) minor);
+    fprintf(f," *          Major cycle %lu ticks. Utilization %lu.%lu %%\n",
+                (unsigned long) (frames*minor),(unsigned long) (load/10),(unsigned long) (load%10));
+    fprintf(f," *\n");
+    fprintf(f," *          | Task                 | Period | Offset |  WCET (us) | Response (us) |\n");
+    fprintf(f," *          |----------------------|--------|--------|------------|---------------|\n");
+    for(i=0;i<ntasks;i++) {
+        fprintf(f," *          | %-20s | %6lu | %6lu | %10lu | %13llu |\n",
+                tasks[i].name,(unsigned long) tasks[i].period,(unsigned long) tasks[i].offset,
+                (unsigned long) tasks[i].wcet,(unsigned long long) tasks[i].response);
+    }
+    fprintf(f," */\n\n");
+
+    fprintf(f,"#include <stdint.h>\n");
+    fprintf(f,"#include \"tt_tasks.h\"\n");
+    fprintf(f,"#include \"tt_schedule.h\"\n\n");
+    fprintf(f,"#if (1000000/TASK_TICK_HZ) != %lu\n",(unsigned long) tick);
+    fprintf(f,"#error \"Table generated for another tick period. Change %s\"\n",input);
+    fprintf(f,"#endif\n\n");
+
+    for(i=0;i<ntasks;i++) {
+        for(j=0;j<i;j++) {
+            if( strcmp(tasks[i].name,tasks[j].name) == 0 )
+                break;
+        }
+        if( j == i )
+            fprintf(f,"void %s(void);\n",tasks[i].name);
+    }
+
+    fprintf(f,"\n/// Tasks of frame k are list[frame[k]] to list[frame[k+1]-1]\n");
+    fprintf(f,"static const uint16_t frame[%lu] = {",(unsigned long) frames+1);
+    n = 0;
+    for(fr=0;fr<=frames;fr++) {
+        fprintf(f,"%s%5lu,",(fr%10)?"":"\n    ",(unsigned long) n);
+        if( fr < frames ) {
+            for(i=0;i<ntasks;i++)
+                n += released(i,fr);
+        }
+    }
+    fprintf(f,"\n};\n\n");
+
+    fprintf(f,"/// Task functions in execution order\n");
+    fprintf(f,"static void (* const list[%lu])(void) = {",(unsigned long) nlist);
+    c = 0;
+    for(fr=0;fr<frames;fr++) {
+        for(i=0;i<ntasks;i++) {
+            if( released(i,fr) )
+                fprintf(f,"%s%s,",(c++%4)?" ":"\n    ",tasks[i].name);
+        }
+    }
+    fprintf(f,"\n};\n\n");
+
+    fprintf(f,"const TaskSchedule_t TT_Schedule = {\n");
+    field(f,minor,"minor cycle (ticks)");
+    field(f,frames,"minor cycles in major cycle");
+    field(f,backlog,"maximum frames pending at a release");
+    fprintf(f,"    frame,\n");
+    fprintf(f,"    list\n");
+    fprintf(f,"};\n");
+
+    if( fclose(f) ) {
+        fprintf(stderr,"%s: write error\n",output);
+        remove(output);
+        exit(1);
+    }
+
+    fprintf(stderr,"%s: minor cycle %lu ticks, %lu frames, %lu releases, utilization %lu.%lu %%\n",
+                output,(unsigned long) minor,(unsigned long) frames,(unsigned long) nlist,
+                (unsigned long) (load/10),(unsigned long) (load%10));
+}
+
+int main(int argc, char *argv[]) {
+
+    if( argc != 3 ) {
+        fprintf(stderr,"Usage: %s <schedule.def> <output.c>\n",argv[0]);
+        return 1;
+    }
+    input = argv[1];
+    readdef();
+    cycles();
+    simulate();
+    writetable(argv[2]);
+    return 0;
+}
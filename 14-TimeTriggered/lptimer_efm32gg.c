@@ -0,0 +1,117 @@
+/**
+ * @file    lptimer_efm32gg.c
+ * @brief   Low power timer for tickless operation using the RTC of the EFM32GG
+ *
+ * @note    RTC is clocked by LFXO (32768 Hz) without prescaler. The counter is
+ *          24 bit wide and wraps around every 512 s
+ *
+ * @note    Writes to COMP0 are synchronized to the low frequency clock domain and
+ *          take effect up to 3 LFXO cycles later (LPTIMER_MINDELTA)
+ *
+ * @note    On waking from EM2, the HFRCO is selected as HFCLK. When the HFXO
+ *          was used before sleeping, it is restarted and selected again
+ */
+
+#include <stdint.h>
+#include "em_device.h"
+#include "lptimer.h"
+
+/// Interrupt priority. Same as SysTick (lowest)
+#define RTCINTLEVEL     (7)
+
+/// Function called by compare interrupt
+static void (*lptimer_callback)(void) = 0;
+
+/**
+ * @brief   Initializes LFXO and RTC
+ */
+
+void LPTimer_Init(void (*callback)(void)) {
+
+    lptimer_callback = callback;
+
+    /* Enable clock for low energy peripherals interface */
+    CMU->HFCORECLKEN0 |= CMU_HFCORECLKEN0_LE;
+
+    /* Start LFXO and use it for LFA clock branch */
+    if( (CMU->STATUS&CMU_STATUS_LFXOENS) == 0 ) {
+        CMU->OSCENCMD = CMU_OSCENCMD_LFXOEN;
+    }
+    while( (CMU->STATUS&CMU_STATUS_LFXORDY) == 0 ) {}
+    CMU->LFCLKSEL = (CMU->LFCLKSEL&~_CMU_LFCLKSEL_LFA_MASK)|CMU_LFCLKSEL_LFA_LFXO;
+
+    /* No prescaler and enable clock for RTC */
+    CMU->LFAPRESC0 = (CMU->LFAPRESC0&~_CMU_LFAPRESC0_RTC_MASK)|CMU_LFAPRESC0_RTC_DIV1;
+    while( CMU->SYNCBUSY&CMU_SYNCBUSY_LFAPRESC0 ) {}
+    CMU->LFACLKEN0 |= CMU_LFACLKEN0_RTC;
+    while( CMU->SYNCBUSY&CMU_SYNCBUSY_LFACLKEN0 ) {}
+
+    /* Free running counter, interrupt on COMP0 match */
+    RTC->CTRL = 0;
+    while( RTC->SYNCBUSY&RTC_SYNCBUSY_CTRL ) {}
+    RTC->COMP0 = LPTIMER_MASK;
+    RTC->IFC   = _RTC_IFC_MASK;
+    RTC->IEN   = RTC_IEN_COMP0;
+
+    NVIC_SetPriority(RTC_IRQn,RTCINTLEVEL);
+    NVIC_ClearPendingIRQ(RTC_IRQn);
+    NVIC_EnableIRQ(RTC_IRQn);
+
+    RTC->CTRL = RTC_CTRL_EN;
+    while( RTC->SYNCBUSY&RTC_SYNCBUSY_CTRL ) {}
+}
+
+/**
+ * @brief   Returns counter value
+ */
+
+uint32_t LPTimer_Read(void) {
+
+    return RTC->CNT;
+}
+
+/**
+ * @brief   Sets compare value
+ *
+ * @note    Waits for the previous write to be synchronized
+ */
+
+void LPTimer_SetCompare(uint32_t c) {
+
+    while( RTC->SYNCBUSY&RTC_SYNCBUSY_COMP0 ) {}
+    RTC->COMP0 = c&LPTIMER_MASK;
+}
+
+/**
+ * @brief   Sleeps in EM1 or EM2 until an interrupt
+ */
+
+void LPTimer_Sleep(int deep) {
+int hfxo = (CMU->STATUS&CMU_STATUS_HFXOSEL) != 0;
+
+    if( deep ) {
+        SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+    } else {
+        SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+    }
+
+    __DSB();
+    __WFI();
+
+    if( deep && hfxo && !(CMU->STATUS&CMU_STATUS_HFXOSEL) ) {
+        CMU->OSCENCMD = CMU_OSCENCMD_HFXOEN;
+        while( (CMU->STATUS&CMU_STATUS_HFXORDY) == 0 ) {}
+        CMU->CMD = CMU_CMD_HFCLKSEL_HFXO;
+    }
+}
+
+/**
+ * @brief   RTC interrupt routine
+ */
+
+void RTC_IRQHandler(void) {
+
+    RTC->IFC = RTC_IFC_COMP0;
+    if( lptimer_callback )
+        lptimer_callback();
+}
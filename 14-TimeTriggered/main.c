@@ -15,9 +15,46 @@
  * #include "efm32gg995f1024.h"
  */
 #include "em_device.h"
+#include "clock_efm32gg.h"
 #include "led.h"
+#include "uart.h"
+#include "tt_report.h"
 
-#define DIVIDER 1000
+#define DIVIDER TASK_TICK_HZ
+
+/// Uncomment to use the RTC instead of SysTick and sleep between releases
+//#define TICKLESS
+
+#ifdef TICKLESS
+#include "tt_tickless.h"
+#endif
+
+/// Comment to run Sampler as a co-operative task and compare its latency
+#define HYBRID
+
+/// Uncomment to run Blinker, TT_Console and Worker from the table generated from schedule.def
+//#define STATIC_SCHEDULE
+
+#ifdef STATIC_SCHEDULE
+#include "tt_schedule.h"
+#endif
+
+/// Uncomment to measure Task_Update. Results are in TT_BenchResults
+//#define TT_BENCHMARK
+
+#ifdef TT_BENCHMARK
+#include "tt_bench.h"
+#endif
+
+/// Uncomment to run the benchmark common to the kernel examples (bench.h)
+//#define BENCHMARK
+
+#ifdef BENCHMARK
+#include "bench.h"
+#if !TASK_PROFILE
+#error "The benchmark needs TASK_PROFILE"
+#endif
+#endif
 
 /*****************************************************************************
  * @brief  SysTick interrupt handler
@@ -55,13 +92,41 @@ static int8_t state = 0;            // must be static
     }
 }
 
+/*****************************************************************************
+ * @brief  Worker processing routine
+ *
+ * @note   A long co-operative task: busy for about 5 ms every 100 ms
+ */
+
+void Worker(void) {
+volatile uint32_t n = 5*(SystemCoreClock/1000)/8;  // about 8 cycles per iteration
+
+    while( n > 0 ) n--;
+}
+
+/*****************************************************************************
+ * @brief  Sampler processing routine
+ *
+ * @note   A short, latency critical task, called every 5 ms.
+ *         Its latency is shown by the console (p)
+ */
+
+volatile uint32_t samples = 0;
+
+void Sampler(void) {
+
+    samples++;
+}
+
 /*****************************************************************************
  * @brief  Main function
  *
- * @note   Using default clock configuration
- *         HFCLK = HFRCO
+ * @note   Using external crystal oscillator
+ *         HFCLK = HFXO
  *         HFCORECLK = HFCLK
  *         HFPERCLK  = HFCLK
+ *
+ * @note   Typing p on the terminal prints task execution times. r clears them
  */
 
 int main(void) {
@@ -69,12 +134,42 @@ int main(void) {
     /* Configure LEDs */
     LED_Init(LED0|LED1);
 
+    // Set clock source to external crystal: 48 MHz
+    (void) SystemCoreClockSet(CLOCK_HFXO,1,1);
+
+    /* Configure UART */
+    UART_Init();
+
+#ifdef TT_BENCHMARK
+    TT_Benchmark();
+#endif
+
+#ifdef BENCHMARK
+    Bench_Start();
+#endif
+
     /* Initialize Task Kernel */
     Task_Init();
+#ifdef STATIC_SCHEDULE
+    Task_SetSchedule(&TT_Schedule);
+#else
     Task_Add(Blinker,1000,0);
-
+    Task_Add(TT_Console,10,1);
+    Task_Add(Worker,100,2);
+#endif
+#ifdef HYBRID
+    Task_AddPreemptive(Sampler,5,0);
+#else
+    Task_Add(Sampler,5,0);
+#endif
+
+#ifdef TICKLESS
+    /* Configure RTC. EM1, because UART is used */
+    TT_Tickless_Init(0);
+#else
     /* Configure SysTick */
     SysTick_Config(SystemCoreClock/DIVIDER);
+#endif
 
     /* Enable Interrupts */
     __enable_irq();
@@ -82,6 +177,16 @@ int main(void) {
     /* Blink loop */
     while (1) {
         Task_Dispatch();
+#ifdef TICKLESS
+        TT_Tickless_Idle();
+#else
+        // Sleep until next interrupt. A release between the test and WFI
+        // leaves the interrupt pending, so WFI returns immediately
+        __disable_irq();
+        if( !Task_Ready() )
+            __WFI();
+        __enable_irq();
+#endif
     }
 
 }
@@ -0,0 +1,64 @@
+#ifndef EFM32GG990F1024_H
+#define EFM32GG990F1024_H
+/**
+ * @file    efm32gg990f1024.h
+ * @brief   Host replacement of the device header for the simulator
+ *
+ * @note    em_device.h includes this file instead of the one in the Gecko SDK,
+ *          because the sim folder is first in the include path
+ *
+ * @note    Only the CMSIS intrinsics used by the kernel are provided. Interrupts
+ *          are simulated: enabling them runs a pending interrupt routine
+ *
+ * @note    Sim_EnableInterrupts, Sim_WaitForInterrupt and SysTick_Config are
+ *          implemented by the timer simulation linked (lptimer_sim.c for ttsim,
+ *          systick_sim.c for vtsim)
+ *
+ * @note    The DWT cycle counter is the simulated time of systick_sim.c, so
+ *          only vtsim can be built with TASK_PROFILE
+ */
+
+#include <stdint.h>
+
+extern uint32_t SystemCoreClock;
+extern uint32_t Sim_PRIMASK;
+
+void Sim_EnableInterrupts(void);
+void Sim_WaitForInterrupt(void);
+
+static inline uint32_t __get_PRIMASK(void)          { return Sim_PRIMASK; }
+static inline void     __set_PRIMASK(uint32_t m)    { Sim_PRIMASK = m; if( !m ) Sim_EnableInterrupts(); }
+static inline void     __disable_irq(void)          { Sim_PRIMASK = 1; }
+static inline void     __enable_irq(void)           { __set_PRIMASK(0); }
+
+static inline uint32_t __LDREXW(volatile uint32_t *a)               { return *a; }
+static inline uint32_t __STREXW(uint32_t v, volatile uint32_t *a)   { *a = v; return 0; }
+static inline void     __CLREX(void)                                { }
+static inline uint32_t __CLZ(uint32_t x)                            { return x ? __builtin_clz(x) : 32; }
+
+/// System control block. Only ICSR is used (to set PendSV pending)
+typedef struct { volatile uint32_t ICSR; } SCB_Type;
+extern SCB_Type Sim_SCB;
+#define SCB                     (&Sim_SCB)
+#define SCB_ICSR_PENDSVSET_Msk  (1UL<<28)
+
+/// Cycle counter (DWT) and its enable bits. Sim_DWT updates CYCCNT
+typedef struct { volatile uint32_t CTRL; volatile uint32_t CYCCNT; } DWT_Type;
+typedef struct { volatile uint32_t DEMCR; } CoreDebug_Type;
+extern CoreDebug_Type Sim_CoreDebug;
+DWT_Type *Sim_DWT(void);
+#define DWT                         (Sim_DWT())
+#define CoreDebug                   (&Sim_CoreDebug)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1UL<<24)
+#define DWT_CTRL_CYCCNTENA_Msk      (1UL)
+
+typedef enum { PendSV_IRQn = -2 } IRQn_Type;
+#define __NVIC_PRIO_BITS        3
+static inline void     NVIC_SetPriority(IRQn_Type irq, uint32_t p)  { }
+
+static inline void     __DSB(void)                  { }
+static inline void     __WFI(void)                  { Sim_WaitForInterrupt(); }
+
+uint32_t SysTick_Config(uint32_t ticks);
+
+#endif // EFM32GG990F1024_H
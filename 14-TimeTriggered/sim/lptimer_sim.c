@@ -0,0 +1,135 @@
+/**
+ * @file    lptimer_sim.c
+ * @brief   Simulated low power timer
+ *
+ * @note    The counter is the low LPTIMER_MASK bits of Sim_Counts. The compare
+ *          interrupt is set pending when the counter reaches the compare value.
+ *          It runs when interrupts are enabled, after a random latency.
+ *
+ * @note    LPTimer_Sleep advances time up to the next compare match or, with
+ *          probability Sim_SpuriousWakeups, up to a random earlier instant
+ *          (another interrupt woke the processor).
+ */
+
+#include <stdint.h>
+#include "em_device.h"
+#include "lptimer.h"
+#include "lptimer_sim.h"
+
+uint32_t SystemCoreClock = 48000000;
+uint32_t Sim_PRIMASK = 1;
+SCB_Type Sim_SCB;
+
+uint64_t Sim_Counts = 0;
+int Sim_CompareErrors = 0;
+int Sim_SpuriousWakeups = 0;
+int Sim_MaxLatency = 0;
+
+static uint32_t compare = LPTIMER_MASK;
+static int pending = 0;
+static int inisr = 0;
+static void (*lptimer_callback)(void) = 0;
+
+/**
+ * @brief   Linear congruential generator
+ */
+
+uint32_t Sim_Random(void) {
+static uint32_t seed = 1;
+
+    seed = seed*1664525u + 1013904223u;
+    return seed>>8;
+}
+
+/**
+ * @brief   Counts until next compare match (1 to LPTIMER_MASK+1)
+ */
+
+static uint64_t
+tomatch(void) {
+uint32_t d = (compare-(uint32_t) Sim_Counts)&LPTIMER_MASK;
+
+    return d ? d : (uint64_t) LPTIMER_MASK+1;
+}
+
+/**
+ * @brief   Runs pending interrupt, when enabled
+ */
+
+void Sim_EnableInterrupts(void) {
+
+    if( inisr || Sim_PRIMASK || !pending )
+        return;
+    pending = 0;
+    if( Sim_MaxLatency )
+        Sim_Counts += Sim_Random()%(Sim_MaxLatency+1);
+    inisr = 1;
+    if( lptimer_callback )
+        lptimer_callback();
+    inisr = 0;
+}
+
+/**
+ * @brief   Not used. The tickless kernel sleeps with LPTimer_Sleep
+ */
+
+void Sim_WaitForInterrupt(void) {
+
+}
+
+/**
+ * @brief   Advances time by n counts, generating interrupts
+ */
+
+void Sim_Advance(uint64_t n) {
+uint64_t end = Sim_Counts+n;
+uint64_t m;
+
+    while( Sim_Counts < end ) {
+        m = tomatch();
+        if( Sim_Counts+m > end ) {
+            Sim_Counts = end;
+        } else {
+            Sim_Counts += m;
+            pending = 1;
+            Sim_EnableInterrupts();
+        }
+    }
+}
+
+void LPTimer_Init(void (*callback)(void)) {
+
+    lptimer_callback = callback;
+}
+
+uint32_t LPTimer_Read(void) {
+
+    return (uint32_t) Sim_Counts&LPTIMER_MASK;
+}
+
+void LPTimer_SetCompare(uint32_t c) {
+
+    c &= LPTIMER_MASK;
+    if( ((c-(uint32_t) Sim_Counts)&LPTIMER_MASK) < LPTIMER_MINDELTA )
+        Sim_CompareErrors++;
+    compare = c;
+}
+
+/**
+ * @brief   Called with interrupts disabled. Returns with the interrupt pending
+ *          or on a spurious wake up
+ */
+
+void LPTimer_Sleep(int deep) {
+uint64_t m;
+
+    if( pending )
+        return;
+    m = tomatch();
+    if( (int) (Sim_Random()%100) < Sim_SpuriousWakeups ) {
+        Sim_Counts += Sim_Random()%m;
+        return;
+    }
+    Sim_Counts += m;
+    pending = 1;
+}
@@ -0,0 +1,27 @@
+#ifndef LPTIMER_SIM_H
+#define LPTIMER_SIM_H
+/**
+ * @file    lptimer_sim.h
+ * @brief   Simulated low power timer
+ *
+ * @note    Simulated time is kept in low power timer counts
+ */
+
+#include <stdint.h>
+
+/// Simulated time (counts since start)
+extern uint64_t Sim_Counts;
+
+/// Compare values set too close to the counter (would be missed by hardware)
+extern int Sim_CompareErrors;
+
+/// Probability (in %) of waking up by another interrupt
+extern int Sim_SpuriousWakeups;
+
+/// Maximum interrupt latency (in counts)
+extern int Sim_MaxLatency;
+
+void Sim_Advance(uint64_t n);
+uint32_t Sim_Random(void);
+
+#endif // LPTIMER_SIM_H
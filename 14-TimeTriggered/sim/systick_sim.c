@@ -0,0 +1,168 @@
+/**
+ * @file    systick_sim.c
+ * @brief   Simulated SysTick and interrupt priorities in virtual time
+ *
+ * @note    SysTick fires every reload cycles. When it fires, the interrupt is
+ *          set pending and runs as soon as interrupts are enabled and no
+ *          interrupt of same or higher priority is running. A tick that
+ *          happens while the previous one is still pending is lost, as in
+ *          the hardware.
+ *
+ * @note    Priorities follow the board: SysTick pre-empts PendSV, PendSV
+ *          (lowest priority) pre-empts only the main program.
+ */
+
+#include <stdint.h>
+#include "em_device.h"
+#include "systick_sim.h"
+
+uint32_t SystemCoreClock = 48000000;
+uint32_t Sim_PRIMASK = 1;
+SCB_Type Sim_SCB;
+CoreDebug_Type Sim_CoreDebug;
+
+uint64_t Sim_Cycles = 0;
+uint32_t Sim_TickCycles = 0;
+uint32_t Sim_LostTicks = 0;
+
+void SysTick_Handler(void);
+void PendSV_Handler(void);
+
+/// Running level: main program, PendSV or SysTick
+///@{
+#define LEVEL_THREAD    (0)
+#define LEVEL_PENDSV    (1)
+#define LEVEL_SYSTICK   (2)
+///@}
+
+static uint64_t reload = 0;             ///< 0 when SysTick is not running
+static uint64_t nexttick = 0;
+static int tickpending = 0;
+static int level = LEVEL_THREAD;
+static DWT_Type dwt;
+
+/**
+ * @brief   Linear congruential generator
+ */
+
+uint32_t Sim_Random(void) {
+static uint32_t seed = 1;
+
+    seed = seed*1664525u + 1013904223u;
+    return seed>>8;
+}
+
+/**
+ * @brief   Returns the DWT, with CYCCNT set to the simulated time when the
+ *          counter is enabled
+ *
+ * @note    The code takes no simulated time, so the cycles measured are
+ *          those of Sim_Run and of the interrupts
+ */
+
+DWT_Type *Sim_DWT(void) {
+
+    if( (Sim_CoreDebug.DEMCR&CoreDebug_DEMCR_TRCENA_Msk) && (dwt.CTRL&DWT_CTRL_CYCCNTENA_Msk) )
+        dwt.CYCCNT = (uint32_t) Sim_Cycles;
+    return &dwt;
+}
+
+/**
+ * @brief   Sets SysTick pending for each period elapsed
+ */
+
+static void
+count(void) {
+
+    while( reload && (Sim_Cycles >= nexttick) ) {
+        if( tickpending )
+            Sim_LostTicks++;
+        tickpending = 1;
+        nexttick += reload;
+    }
+}
+
+/**
+ * @brief   Advances time by n cycles, without running interrupts
+ */
+
+static void
+advance(uint64_t n) {
+
+    Sim_Cycles += n;
+    count();
+}
+
+/**
+ * @brief   Runs pending interrupts allowed at the current level
+ */
+
+static void
+service(void) {
+int saved;
+
+    while( !Sim_PRIMASK ) {
+        saved = level;
+        if( tickpending && (level < LEVEL_SYSTICK) ) {
+            tickpending = 0;
+            level = LEVEL_SYSTICK;
+            SysTick_Handler();
+            advance(Sim_TickCycles);
+        } else if( (SCB->ICSR&SCB_ICSR_PENDSVSET_Msk) && (level < LEVEL_PENDSV) ) {
+            SCB->ICSR &= ~SCB_ICSR_PENDSVSET_Msk;
+            level = LEVEL_PENDSV;
+            PendSV_Handler();
+        } else {
+            break;
+        }
+        level = saved;
+    }
+}
+
+void Sim_EnableInterrupts(void) {
+
+    service();
+}
+
+/**
+ * @brief   Called with interrupts disabled. Advances time to the next tick
+ *          when nothing is pending
+ */
+
+void Sim_WaitForInterrupt(void) {
+
+    if( tickpending || (SCB->ICSR&SCB_ICSR_PENDSVSET_Msk) || !reload )
+        return;
+    Sim_Cycles = nexttick;
+    count();
+}
+
+/**
+ * @brief   Executes code taking n cycles. Interrupts happening meanwhile
+ *          run at their time and delay the code
+ */
+
+void Sim_Run(uint64_t n) {
+uint64_t d;
+
+    while( n ) {
+        d = n;
+        if( reload && (nexttick-Sim_Cycles < d) )
+            d = nexttick-Sim_Cycles;
+        advance(d);
+        n -= d;
+        service();
+    }
+}
+
+/**
+ * @brief   Starts SysTick with a period of ticks cycles
+ */
+
+uint32_t SysTick_Config(uint32_t ticks) {
+
+    reload      = ticks;
+    nexttick    = Sim_Cycles+ticks;
+    tickpending = 0;
+    return 0;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file    tickbench.c
+ * @brief   Runs the benchmark of Task_Update (tt_bench.c) on the host
+ *
+ * @note    The same tt_bench.c and tt_tasks.c of the board. The DWT cycle
+ *          counter is the time stamp counter of the host (x86) or, on other
+ *          hosts, a nanosecond clock. So the results are host counts, useful
+ *          to compare versions of tt_tasks.c, not cycles of the board.
+ *
+ * @note    Usage: tickbench [runs]
+ *
+ *          The benchmark is run several times (default 20) and, for each
+ *          task count, the run with the lowest mean is printed, to filter
+ *          out the noise of the host.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "em_device.h"
+
+#include "tt_tasks.h"
+#include "tt_bench.h"
+
+uint32_t SystemCoreClock = 48000000;
+uint32_t Sim_PRIMASK = 1;
+SCB_Type Sim_SCB;
+CoreDebug_Type Sim_CoreDebug;
+
+static DWT_Type dwt;
+
+/**
+ * @brief   Returns the DWT, with CYCCNT set to the host counter
+ */
+
+DWT_Type *Sim_DWT(void) {
+#if defined(__x86_64__) || defined(__i386__)
+
+    dwt.CYCCNT = (uint32_t) __rdtsc();
+#else
+struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC,&t);
+    dwt.CYCCNT = (uint32_t) (t.tv_sec*1000000000ull+t.tv_nsec);
+#endif
+    return &dwt;
+}
+
+/**
+ * @brief   No interrupt is simulated. PendSV is only set pending
+ */
+///@{
+void Sim_EnableInterrupts(void) { }
+void Sim_WaitForInterrupt(void) { }
+uint32_t SysTick_Config(uint32_t ticks) { return 0; }
+///@}
+
+int main(int argc, char *argv[]) {
+TT_Bench_t best[16];
+int runs = 20;
+int r,k;
+
+    if( argc > 1 )
+        runs = atoi(argv[1]);
+    if( (runs < 1) || (TT_BenchCount > 16) ) {
+        fprintf(stderr,"Usage: %s [runs]\n",argv[0]);
+        return 1;
+    }
+    for(r=0;r<runs;r++) {
+        TT_Benchmark();
+        for(k=0;k<TT_BenchCount;k++) {
+            if( (r == 0) || (TT_BenchResults[k].mean < best[k].mean) )
+                best[k] = TT_BenchResults[k];
+        }
+    }
+    printf("Task_Update in host counts (best mean of %d runs)\n",runs);
+    printf("Tasks       Min       Max      Mean  Idle dispatch\n");
+    for(k=0;k<TT_BenchCount;k++) {
+        if( best[k].tasks == 0 )
+            continue;
+        printf("%5d %9u %9u %9u %14u\n",best[k].tasks,best[k].min,best[k].max,
+                best[k].mean,best[k].idle);
+    }
+    return 0;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file    ttsim.c
+ * @brief   Host simulation of the tickless time triggered kernel
+ *
+ * @note    Uses the same tt_tasks.c and tt_tickless.c of the board, with a
+ *          simulated low power timer (lptimer_sim.c)
+ *
+ * @note    Verifies that
+ *          - every release happens at its tick, never earlier and at most a few
+ *            counts later (no drift, even after hours)
+ *          - no release is lost (the number of runs of each task is exact)
+ *          - the compare value is never too close to the counter
+ *
+ * @note    Usage: ttsim [-t seconds] [-n tasks] [-w spurious%] [-l latency] [-e exec]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "em_device.h"
+
+#include "tt_tasks.h"
+#include "tt_tickless.h"
+#include "lptimer.h"
+#include "lptimer_sim.h"
+
+/// Maximum number of simulated tasks
+#define SIMTASKS    (16)
+
+/**
+ * @brief   Information about a simulated task
+ */
+typedef struct {
+    uint32_t    period;                 ///< period (ticks)
+    uint32_t    delay;                  ///< initial delay (ticks)
+    uint64_t    next;                   ///< expected release tick
+    uint64_t    runs;                   ///< number of executions
+    uint64_t    maxlate;                ///< maximum lateness (counts)
+    int         early;                  ///< executions before release
+} SimTask_t;
+
+static SimTask_t simtasks[SIMTASKS];
+static int ntasks = 8;
+static int maxexec = 4;
+static int finishing = 0;
+
+/**
+ * @brief   Count where tick t starts
+ */
+
+static uint64_t
+tick2count(uint64_t t) {
+
+    return (t*LPTIMER_HZ+TASK_TICK_HZ-1)/TASK_TICK_HZ;
+}
+
+/**
+ * @brief   Body of all simulated tasks
+ */
+
+static void
+simtask(int k) {
+SimTask_t *t = &simtasks[k];
+uint64_t start = tick2count(t->next);
+
+    if( Sim_Counts < start ) {
+        t->early++;
+    } else if( Sim_Counts-start > t->maxlate ) {
+        t->maxlate = Sim_Counts-start;
+    }
+    t->next += t->period;
+    t->runs++;
+    if( !finishing && maxexec )
+        Sim_Advance(Sim_Random()%(maxexec+1));
+}
+
+#define TASK(K) static void task##K(void) { simtask(K); }
+TASK(0)  TASK(1)  TASK(2)  TASK(3)  TASK(4)  TASK(5)  TASK(6)  TASK(7)
+TASK(8)  TASK(9)  TASK(10) TASK(11) TASK(12) TASK(13) TASK(14) TASK(15)
+
+static void (* const taskfunctions[SIMTASKS])(void) = {
+    task0,  task1,  task2,  task3,  task4,  task5,  task6,  task7,
+    task8,  task9,  task10, task11, task12, task13, task14, task15
+};
+
+/**
+ * @brief   Expected number of releases up to tick T
+ */
+
+static uint64_t
+expected(SimTask_t *t, uint64_t T) {
+
+    if( T < t->delay+1 )
+        return 0;
+    return (T-(t->delay+1))/t->period+1;
+}
+
+int main(int argc, char *argv[]) {
+uint64_t seconds = 3600;
+uint64_t end,T,truetick;
+int opt,k,errors = 0;
+SimTask_t *t;
+
+    while( (opt=getopt(argc,argv,"t:n:w:l:e:")) != -1 ) {
+        switch(opt) {
+        case 't': seconds = strtoull(optarg,0,10);      break;
+        case 'n': ntasks = atoi(optarg);                break;
+        case 'w': Sim_SpuriousWakeups = atoi(optarg);   break;
+        case 'l': Sim_MaxLatency = atoi(optarg);        break;
+        case 'e': maxexec = atoi(optarg);               break;
+        default:
+            fprintf(stderr,"Usage: %s [-t seconds] [-n tasks] [-w spurious%%] [-l latency] [-e exec]\n",argv[0]);
+            return 1;
+        }
+    }
+    if( ntasks < 1 || ntasks > SIMTASKS ) {
+        fprintf(stderr,"Number of tasks must be between 1 and %d\n",SIMTASKS);
+        return 1;
+    }
+
+    Task_Init();
+    for(k=0;k<ntasks;k++) {
+        t = &simtasks[k];
+        t->period = k ? 1+Sim_Random()%2000 : 1;
+        t->delay  = Sim_Random()%1000;
+        t->next   = t->delay+1;
+        Task_Add(taskfunctions[k],t->period,t->delay);
+    }
+    TT_Tickless_Init(1);
+    __enable_irq();
+
+    end = seconds*LPTIMER_HZ;
+    while( Sim_Counts < end ) {
+        Task_Dispatch();
+        TT_Tickless_Idle();
+    }
+
+    /* Dispatch released tasks without advancing time */
+    finishing = 1;
+    __disable_irq();
+    Task_Dispatch();
+
+    T = Task_GetTime();
+    truetick = (Sim_Counts*TASK_TICK_HZ)/LPTIMER_HZ;
+
+    printf("Simulated %llu s: %llu counts, %llu ticks (kernel %llu)\n",
+            (unsigned long long) seconds,(unsigned long long) Sim_Counts,
+            (unsigned long long) truetick,(unsigned long long) T);
+    printf("Task  Period Delay       Runs   Expected  Late(us) Early Overruns\n");
+    for(k=0;k<ntasks;k++) {
+        t = &simtasks[k];
+        printf("%4d %7u %5u %10llu %10llu %9.1f %5d %8d\n",k,t->period,t->delay,
+                (unsigned long long) t->runs,(unsigned long long) expected(t,T),
+                t->maxlate*1e6/LPTIMER_HZ,t->early,Task_GetOverruns(k));
+        if( t->runs != expected(t,T) || t->early )
+            errors++;
+    }
+
+    if( T > truetick || truetick-T >= Task_TicksToNextRelease() ) {
+        printf("Kernel time is not consistent with timer\n");
+        errors++;
+    }
+    if( Sim_CompareErrors ) {
+        printf("%d compare values too close to the counter\n",Sim_CompareErrors);
+        errors++;
+    }
+    printf("%s\n",errors?"FAIL":"PASS");
+    return errors != 0;
+}
@@ -0,0 +1,315 @@
+/**
+ * @file    vtsim.c
+ * @brief   Virtual time simulation of the time triggered kernel
+ *
+ * @note    Runs the same tt_tasks.c of the board with a simulated SysTick
+ *          (systick_sim.c). The main loop is the one of main.c. Each task
+ *          takes a random execution time between its best and worst case,
+ *          during which ticks happen and the pre-emptive task can run.
+ *
+ * @note    Release, start and end of every job are recorded (trace.c) and
+ *          can be written as CSV or as a Chrome trace.
+ *
+ * @note    Usage: vtsim [-t seconds] [-o file] [-j jitter] [-i cycles] [-T task]...
+ *
+ *          -t  simulated time (default 10 s)
+ *          -o  trace file (.json for Chrome trace, otherwise CSV)
+ *          -j  maximum jitter (variation of latency) accepted, in us
+ *          -i  cycles of each tick interrupt (default 150)
+ *          -T  name:period:delay:wcet[:bcet][:p], period and delay in ticks,
+ *              execution times in us. p marks the pre-emptive task.
+ *              Without -T, the task set of main.c is used
+ *
+ * @note    The result is FAIL (exit code 1) when a task overruns, misses its
+ *          deadline (next release), starts before its release, has more
+ *          jitter than accepted or when ticks are lost. So it can be used in CI
+ *
+ * @note    When built with TASK_PROFILE, the DWT cycle counter is the
+ *          simulated time. The profile of each task must then be exactly its
+ *          simulated execution time plus the ticks that interrupted it (not
+ *          the pre-emptive task nor the ticks that interrupted that), and
+ *          Task_GetUtilization must match. Otherwise the result is FAIL
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "em_device.h"
+
+#include "tt_tasks.h"
+#include "systick_sim.h"
+#include "trace.h"
+
+/// Maximum number of simulated tasks
+#define SIMTASKS    (TRACE_TASKS)
+
+/**
+ * @brief   Information about a simulated task
+ */
+typedef struct {
+    char        name[32];
+    uint32_t    period;                 ///< period (ticks)
+    uint32_t    delay;                  ///< initial delay (ticks)
+    uint32_t    wcet;                   ///< worst case execution time (us)
+    uint32_t    bcet;                   ///< best case execution time (us)
+    int         preemptive;
+    int         index;                  ///< index in kernel table
+    uint64_t    next;                   ///< tick of next release
+    uint64_t    job;                    ///< cycles of the running job
+    uint64_t    jobs;                   ///< jobs run
+    uint64_t    sum;                    ///< cycles of all jobs
+    uint64_t    max;                    ///< cycles of longest job
+} SimTask_t;
+
+static SimTask_t simtasks[SIMTASKS];
+static int ntasks = 0;
+static int preemptive = -1;
+
+/// Innermost task running (interrupted by a tick). -1 when none
+static int running = -1;
+
+/// End of simulation (cycles). After it, tasks take no time, so an overloaded
+/// task set does not keep Task_Dispatch running forever
+static uint64_t end;
+
+/// Task set of main.c
+static const char * const defaulttasks[] = {
+    "Blinker:1000:0:20",
+    "TT_Console:10:1:100:10",
+    "Worker:100:2:5000",
+    "Sampler:5:0:2:1:p"
+};
+
+/**
+ * @brief   Tick interrupt. Records the releases of this tick
+ */
+
+void SysTick_Handler(void) {
+uint32_t now;
+int k;
+
+    if( running >= 0 )
+        simtasks[running].job += Sim_TickCycles;
+    Task_Update();
+    now = Task_GetTime();
+    for(k=0;k<ntasks;k++) {
+        if( simtasks[k].next == now ) {
+            Trace_Release(k,Sim_Cycles);
+            simtasks[k].next += simtasks[k].period;
+        }
+    }
+}
+
+/**
+ * @brief   Body of all simulated tasks
+ */
+
+static void
+simtask(void *ctx) {
+SimTask_t *t = ctx;
+uint64_t cycles = 0;
+uint32_t us;
+int k = t-simtasks;
+int outer = running;
+
+    Trace_Start(k,Sim_Cycles);
+    us = t->bcet+Sim_Random()%(t->wcet-t->bcet+1);
+    if( Sim_Cycles < end )
+        cycles = (uint64_t) us*(SystemCoreClock/1000000);
+    t->job = cycles;
+    running = k;
+    Sim_Run(cycles);
+    running = outer;
+    t->jobs++;
+    t->sum += t->job;
+    if( t->job > t->max )
+        t->max = t->job;
+    Trace_End(k,Sim_Cycles);
+}
+
+static void
+preemptivetask(void) {
+
+    simtask(&simtasks[preemptive]);
+}
+
+/**
+ * @brief   Parses name:period:delay:wcet[:bcet][:p]
+ */
+
+static int
+parsetask(const char *s) {
+SimTask_t *t;
+char buf[128];
+char *f[6];
+char *p;
+int n = 0;
+
+    if( ntasks == SIMTASKS )
+        return -1;
+    strncpy(buf,s,sizeof(buf)-1);
+    buf[sizeof(buf)-1] = '\0';
+    for(p=strtok(buf,":");p && (n < 6);p=strtok(0,":"))
+        f[n++] = p;
+    if( n < 4 )
+        return -1;
+    t = &simtasks[ntasks];
+    memset(t,0,sizeof(*t));
+    strncpy(t->name,f[0],sizeof(t->name)-1);
+    t->period = strtoul(f[1],0,10);
+    t->delay  = strtoul(f[2],0,10);
+    t->wcet   = strtoul(f[3],0,10);
+    t->bcet   = t->wcet;
+    if( (n > 4) && (strcmp(f[4],"p") != 0) )
+        t->bcet = strtoul(f[4],0,10);
+    if( strcmp(f[n-1],"p") == 0 ) {
+        if( preemptive >= 0 )
+            return -1;
+        t->preemptive = 1;
+        preemptive = ntasks;
+    }
+    if( (t->period == 0) || (t->bcet > t->wcet) )
+        return -1;
+    t->next = t->delay+1;
+    ntasks++;
+    return 0;
+}
+
+#if TASK_PROFILE
+/**
+ * @brief   Compares the profile of the kernel with the simulated times
+ *
+ * @note    The busy time of Task_GetUtilization is the sum of the jobs of
+ *          all tasks, because the simulated Task_Update takes no time
+ *
+ * @return  number of mismatches
+ */
+
+static int
+checkprofile(double cyclesperus) {
+const TaskProfile_t *p;
+SimTask_t *t;
+uint64_t busy = 0,total;
+int k,expected,errors = 0;
+
+    printf("Task           Jobs   Mean us    Max us  Profile mean us    max us\n");
+    for(k=0;k<ntasks;k++) {
+        t = &simtasks[k];
+        p = Task_GetProfile(t->index);
+        printf("%-12s %6llu %9.1f %9.1f %16.1f %9.1f\n",t->name,(unsigned long long) t->jobs,
+                t->jobs?t->sum/cyclesperus/t->jobs:0.0,t->max/cyclesperus,
+                p->count?p->sum/cyclesperus/p->count:0.0,p->max/cyclesperus);
+        if( (p->count != t->jobs) || (p->sum != t->sum) || (p->max != t->max) ) {
+            printf("%s: profile does not match the simulated times\n",t->name);
+            errors++;
+        }
+        busy += t->sum;
+    }
+    total = (uint64_t) Task_GetTime()*(SystemCoreClock/TASK_TICK_HZ);
+    if( busy > total )
+        busy = total;
+    expected = total ? (int) ((busy*1000)/total) : 0;
+    printf("Utilization %d.%d %% (simulated %d.%d %%)\n",Task_GetUtilization()/10,
+            Task_GetUtilization()%10,expected/10,expected%10);
+    if( Task_GetUtilization() != expected )
+        errors++;
+    return errors;
+}
+#endif
+
+int main(int argc, char *argv[]) {
+uint64_t seconds = 10;
+uint64_t jitter,maxjitter = UINT64_MAX;
+const char *output = 0;
+const TraceStats_t *st;
+SimTask_t *t;
+double cyclesperus;
+int opt,k,errors = 0;
+
+    while( (opt=getopt(argc,argv,"t:o:j:i:T:")) != -1 ) {
+        switch(opt) {
+        case 't': seconds = strtoull(optarg,0,10);                      break;
+        case 'o': output = optarg;                                      break;
+        case 'j': maxjitter = strtoull(optarg,0,10);                    break;
+        case 'i': Sim_TickCycles = strtoul(optarg,0,10);                break;
+        case 'T':
+            if( parsetask(optarg) == 0 )
+                break;
+            fprintf(stderr,"Invalid task %s\n",optarg);
+            return 1;
+        default:
+            fprintf(stderr,"Usage: %s [-t seconds] [-o file] [-j jitter] [-i cycles] "
+                           "[-T name:period:delay:wcet[:bcet][:p]]...\n",argv[0]);
+            return 1;
+        }
+    }
+    if( ntasks == 0 ) {
+        for(k=0;k<(int) (sizeof(defaulttasks)/sizeof(defaulttasks[0]));k++)
+            parsetask(defaulttasks[k]);
+    }
+    if( Sim_TickCycles == 0 )
+        Sim_TickCycles = 150;
+    cyclesperus = SystemCoreClock/1e6;
+    if( maxjitter != UINT64_MAX )
+        maxjitter = (uint64_t) (maxjitter*cyclesperus);
+
+    if( Trace_Open(output,SystemCoreClock) ) {
+        fprintf(stderr,"Cannot create %s\n",output);
+        return 1;
+    }
+
+    Task_Init();
+    for(k=0;k<ntasks;k++) {
+        t = &simtasks[k];
+        Trace_Task(k,t->name);
+        if( t->preemptive )
+            t->index = Task_AddPreemptive(preemptivetask,t->period,t->delay);
+        else
+            t->index = Task_AddCtx(simtask,t,t->period,t->delay);
+    }
+    SysTick_Config(SystemCoreClock/TASK_TICK_HZ);
+    __enable_irq();
+
+    /* Main loop of main.c */
+    end = seconds*SystemCoreClock;
+    while( Sim_Cycles < end ) {
+        Task_Dispatch();
+        __disable_irq();
+        if( !Task_Ready() )
+            __WFI();
+        __enable_irq();
+    }
+    __disable_irq();
+
+    if( Trace_Close() ) {
+        fprintf(stderr,"Error writing %s\n",output);
+        errors++;
+    }
+
+    printf("Simulated %llu s, %u ticks\n",(unsigned long long) seconds,Task_GetTime());
+    printf("Task           Period  Releases      Jobs  Lat min  Lat max   Jitter  Resp max  Over Miss\n");
+    for(k=0;k<ntasks;k++) {
+        t  = &simtasks[k];
+        st = Trace_GetStats(k);
+        jitter = st->maxlatency-st->minlatency;
+        printf("%-12s %8u %9llu %9llu %8.1f %8.1f %8.1f %9.1f %5d %4llu%s\n",t->name,t->period,
+                (unsigned long long) st->releases,(unsigned long long) st->jobs,
+                st->minlatency/cyclesperus,st->maxlatency/cyclesperus,jitter/cyclesperus,
+                st->maxresponse/cyclesperus,Task_GetOverruns(t->index),
+                (unsigned long long) st->missed,t->preemptive?" (pre-emptive)":"");
+        if( Task_GetOverruns(t->index) || st->missed || st->unreleased || (jitter > maxjitter) )
+            errors++;
+    }
+    if( Sim_LostTicks ) {
+        printf("%u ticks lost\n",Sim_LostTicks);
+        errors++;
+    }
+#if TASK_PROFILE
+    errors += checkprofile(cyclesperus);
+#endif
+    printf("%s\n",errors?"FAIL":"PASS");
+    return errors != 0;
+}
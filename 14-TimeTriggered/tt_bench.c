@@ -0,0 +1,94 @@
+/**
+ * @file        tt_bench.c
+ * @brief       measures the cost of Task_Update and of an idle Task_Dispatch
+ *              against the number of tasks
+ *
+ * @note        Task_Update is called directly (not by the interrupt), so
+ *              the measurement does not include interrupt entry and exit
+ *              (12 cycles each on a Cortex-M3)
+ * @note        Periods are pseudo random between 1 and 1000 ticks. Tasks are
+ *              never dispatched, so their run counters just grow
+ * @note        The idle cost is measured with a table where no task is released
+ *              (long initial delay), as the main loop does between ticks
+ * @note        Counts above TASK_N are skipped (tasks is 0 in the results).
+ *              Build with -DTASK_N=256 to measure all of them
+ * @note        Uses the DWT cycle counter
+ */
+
+#include <stdint.h>
+#include "em_device.h"
+#include "tt_tasks.h"
+#include "tt_bench.h"
+
+/// Number of Task_Update calls for each measurement
+#define CALLS   (10000)
+
+/// Task counts to be measured
+static const int taskcount[] = { 1, 10, 50, 100, 200, 250 };
+
+const int TT_BenchCount = sizeof(taskcount)/sizeof(taskcount[0]);
+
+TT_Bench_t TT_BenchResults[sizeof(taskcount)/sizeof(taskcount[0])];
+
+/**
+ * @brief   Dummy task
+ */
+static void nothing(void) { }
+
+/**
+ * @brief   Linear congruential generator (Numerical Recipes constants)
+ */
+static uint32_t
+rnd(void) {
+static uint32_t seed = 1;
+
+    seed = seed*1664525u + 1013904223u;
+    return seed>>8;
+}
+
+/**
+ * @details Each count is measured with a fresh task table
+ */
+
+void TT_Benchmark(void) {
+int k,i;
+uint32_t c,min,max;
+uint64_t sum;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for(k=0;k<TT_BenchCount;k++) {
+        TT_BenchResults[k].tasks = 0;
+        if( taskcount[k] > TASK_N )
+            continue;
+        Task_Init();
+        for(i=0;i<taskcount[k];i++)
+            Task_Add(nothing,1+rnd()%1000,rnd()%1000);
+
+        min = UINT32_MAX;
+        max = 0;
+        sum = 0;
+        for(i=0;i<CALLS;i++) {
+            c = DWT->CYCCNT;
+            Task_Update();
+            c = DWT->CYCCNT-c;
+            if( c < min ) min = c;
+            if( c > max ) max = c;
+            sum += c;
+        }
+        TT_BenchResults[k].tasks = taskcount[k];
+        TT_BenchResults[k].min   = min;
+        TT_BenchResults[k].max   = max;
+        TT_BenchResults[k].mean  = (uint32_t) (sum/CALLS);
+
+        Task_Init();
+        for(i=0;i<taskcount[k];i++)
+            Task_Add(nothing,1000,1000000);
+        c = DWT->CYCCNT;
+        Task_Dispatch();
+        TT_BenchResults[k].idle  = DWT->CYCCNT-c;
+    }
+    Task_Init();
+}
@@ -0,0 +1,36 @@
+#ifndef TT_BENCH_H
+#define TT_BENCH_H
+/**
+ * @file        tt_bench.h
+ * @brief       measures the cost of Task_Update and of an idle Task_Dispatch
+ *              against the number of tasks
+ *
+ * @note        Results are left in TT_BenchResults, to be read with a debugger
+ */
+
+#include <stdint.h>
+
+/**
+ * @typedef TT_Bench_t
+ * @brief   Cycles used by Task_Update and Task_Dispatch for a given number of tasks
+ */
+typedef struct {
+    int         tasks;                  ///< number of tasks in table
+    uint32_t    min;                    ///< minimum cycles per call
+    uint32_t    max;                    ///< maximum cycles per call
+    uint32_t    mean;                   ///< mean cycles per call
+    uint32_t    idle;                   ///< cycles of Task_Dispatch with no task released
+} TT_Bench_t;
+
+extern TT_Bench_t TT_BenchResults[];
+extern const int TT_BenchCount;
+
+/**
+ * @fn      TT_Benchmark
+ * @brief   Fills TT_BenchResults. Clears the tasks table
+ *
+ *          Must be called before SysTick is enabled
+ */
+void TT_Benchmark(void);
+
+#endif // TT_BENCH_H
@@ -0,0 +1,204 @@
+/**
+ * @file        tt_report.c
+ * @brief       prints execution time statistics of tasks on the UART
+ *
+ * @note        All times are in cycles. Mean is rounded down
+ * @note        For each task, three lines are printed: the execution time, the
+ *              latency (from release to start) and the execution time
+ *              histogram. Histogram bin k shows the percentage of executions
+ *              with less than 2^(k+TASK_HIST_SHIFT+1) cycles (and more than
+ *              the previous bin limit)
+ *
+ * @note        When a static table is used, the execution time of its frames
+ *              is printed as Frm
+ *
+ * @note        Without TASK_PROFILE there are no statistics. The commands
+ *              just answer that
+ */
+
+#include <stdint.h>
+#include "tt_tasks.h"
+#include "tt_report.h"
+#include "uart.h"
+
+#if TASK_PROFILE
+
+/// Size of line buffer. Must be less than UART output buffer
+#define LINESIZE    (96)
+
+/**
+ * @brief   Report states
+ */
+typedef enum {
+    REPORT_IDLE,
+    REPORT_HEADER,
+    REPORT_TICK,
+    REPORT_UTILIZATION,
+    REPORT_FRAME,
+    REPORT_TASK,
+    REPORT_LATENCY,
+    REPORT_HISTOGRAM
+} ReportState_t;
+
+/**
+ * @brief   Appends a string
+ */
+
+static char *
+putstr(char *p, const char *s) {
+
+    while( *s ) *p++ = *s++;
+    return p;
+}
+
+/**
+ * @brief   Appends an unsigned decimal number, right aligned in w positions
+ */
+
+static char *
+putnum(char *p, uint64_t v, int w) {
+char digits[21];
+int n = 0;
+
+    do {
+        digits[n++] = '0'+v%10;
+        v /= 10;
+    } while( v );
+    while( w-- > n )
+        *p++ = ' ';
+    while( n )
+        *p++ = digits[--n];
+    return p;
+}
+
+/**
+ * @brief   Appends statistics (count, min, mean, max)
+ */
+
+static char *
+putprofile(char *p, const TaskProfile_t *s) {
+
+    p = putnum(p,s->count,10);
+    p = putnum(p,s->min,10);
+    p = putnum(p,s->count?s->sum/s->count:0,10);
+    p = putnum(p,s->max,10);
+    return p;
+}
+
+/**
+ * @brief   Finds next task with data, starting at index i. Returns TASK_N if none
+ */
+
+static int
+nexttask(int i) {
+
+    while( (i < TASK_N) && (Task_GetProfile(i)->count == 0) && (Task_GetOverruns(i) == 0) )
+        i++;
+    return i;
+}
+
+/**
+ * @details State machine. Reads commands only when it is not printing
+ */
+
+void TT_Console(void) {
+static ReportState_t state = REPORT_IDLE;
+static int task = 0;
+char line[LINESIZE];
+char *p = line;
+const TaskProfile_t *s;
+int k,u;
+
+    switch(state) {
+    case REPORT_IDLE:
+        switch(UART_GetCharNoWait()) {
+        case 'p':
+            state = REPORT_HEADER;
+            break;
+        case 'r':
+            Task_ResetProfile();
+            p = putstr(p,"Statistics cleared\r\n");
+            break;
+        }
+        break;
+    case REPORT_HEADER:
+        p = putstr(p,"\r\nTask     Count       Min      Mean       Max  Overruns\r\n");
+        state = REPORT_TICK;
+        break;
+    case REPORT_TICK:
+        p = putstr(p,"Tick");
+        p = putprofile(p,Task_GetTickProfile());
+        p = putstr(p,"\r\n");
+        state = REPORT_UTILIZATION;
+        break;
+    case REPORT_UTILIZATION:
+        u = Task_GetUtilization();
+        p = putstr(p,"CPU ");
+        p = putnum(p,u/10,3);
+        p = putstr(p,".");
+        p = putnum(p,u%10,1);
+        p = putstr(p," % Idle ");
+        p = putnum(p,(1000-u)/10,3);
+        p = putstr(p,".");
+        p = putnum(p,(1000-u)%10,1);
+        p = putstr(p," %\r\n");
+        state = REPORT_FRAME;
+        break;
+    case REPORT_FRAME:
+        s = Task_GetFrameProfile();
+        if( s->count || Task_GetScheduleOverruns() ) {
+            p = putstr(p," Frm");
+            p = putprofile(p,s);
+            p = putnum(p,Task_GetScheduleOverruns(),10);
+            p = putstr(p,"\r\n");
+        }
+        task = nexttask(0);
+        state = (task<TASK_N) ? REPORT_TASK : REPORT_IDLE;
+        break;
+    case REPORT_TASK:
+        p = putnum(p,task,4);
+        p = putprofile(p,Task_GetProfile(task));
+        p = putnum(p,Task_GetOverruns(task),10);
+        p = putstr(p,"\r\n");
+        state = REPORT_LATENCY;
+        break;
+    case REPORT_LATENCY:
+        p = putstr(p," Lat");
+        p = putprofile(p,Task_GetLatency(task));
+        p = putstr(p,"\r\n");
+        state = REPORT_HISTOGRAM;
+        break;
+    case REPORT_HISTOGRAM:
+        s = Task_GetProfile(task);
+        p = putstr(p,"   %");
+        for(k=0;k<TASK_HIST_N;k++)
+            p = putnum(p,s->count?((uint64_t) s->hist[k]*100)/s->count:0,4);
+        p = putstr(p,"\r\n");
+        task = nexttask(task+1);
+        state = (task<TASK_N) ? REPORT_TASK : REPORT_IDLE;
+        break;
+    }
+
+    if( p != line ) {
+        *p = '\0';
+        UART_SendString(line);
+    }
+}
+
+#else
+
+/**
+ * @details Answers p and r, so the console behaves the same
+ */
+
+void TT_Console(void) {
+
+    switch(UART_GetCharNoWait()) {
+    case 'p':
+    case 'r':
+        UART_SendString((char *) "No statistics (TASK_PROFILE is 0)\r\n");
+        break;
+    }
+}
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef TT_REPORT_H
+#define TT_REPORT_H
+/**
+ * @file        tt_report.h
+ * @brief       prints execution time statistics of tasks on the UART
+ *
+ * @note        Commands (single char):
+ *              - p: prints statistics
+ *              - r: clears statistics
+ */
+
+/**
+ * @fn      TT_Console
+ * @brief   Console task. Must be added with a period of about 10 ms
+ *
+ *          Prints at most one line each time it runs, so it never fills
+ *          the UART output buffer nor runs for long
+ *
+ * @param   void
+ * @return  void
+ */
+void TT_Console(void);
+
+#endif // TT_REPORT_H
@@ -0,0 +1,15 @@
+#ifndef TT_SCHEDULE_H
+#define TT_SCHEDULE_H
+/**
+ * @file        tt_schedule.h
+ * @brief       static cyclic executive table
+ *
+ * @note        tt_schedule.c is generated by gen/ttgen from schedule.def when
+ *              building. It is used with Task_SetSchedule(&TT_Schedule)
+ */
+
+#include "tt_tasks.h"
+
+extern const TaskSchedule_t TT_Schedule;
+
+#endif // TT_SCHEDULE_H
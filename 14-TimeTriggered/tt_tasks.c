@@ -8,8 +8,52 @@
  *              Task_Update must be called by timer interrupt processing
  *              All tasks must complete in less than tick seconds
  *
- * @bug         There is a hazard between tasks[i].run++ in Task_Update (interrupt)
- *              and tasks[i].run-- in Task_Dispatch
+ * @note        Tasks are kept in a timing wheel. Each task is in the slot
+ *              given by its release time (due) modulo WHEEL_SIZE. The lists
+ *              are sorted by due, so Task_Update only touches the tasks
+ *              released in the current tick. Its cost does not depend on TASK_N.
+ *
+ * @note        The run counter is incremented in Task_Update (interrupt) and
+ *              decremented in Task_Dispatch. Both use LDREX/STREX, so no update
+ *              is lost. An interrupt between them clears the exclusive monitor
+ *              and the decrement is retried.
+ *
+ * @note        Released tasks are marked in a two level bitmap: bit i of word w
+ *              (counting from the MSB) is task 32*w+i and bit w of readygroup
+ *              is set when word w is not zero. Task_Dispatch picks the task with
+ *              the lowest index (highest priority) with two __CLZ, so the cost
+ *              of Task_Dispatch and Task_Ready does not depend on TASK_N.
+ *              Task_Update only sets bits. Task_Dispatch clears them with
+ *              interrupts disabled and sets them again when a task still has
+ *              pending releases.
+ *
+ * @note        An overrun happens when a task is released again before its last
+ *              release was dispatched. It is counted for each task and, when
+ *              set, a hook is called from Task_Update.
+ *
+ * @note        Hybrid scheduling (Pont, Chapter 16): one task can be added with
+ *              Task_AddPreemptive. It is not run by Task_Dispatch, but by the
+ *              PendSV interrupt, set pending by Task_Update when it is released.
+ *              PendSV has the lowest priority, so it runs as soon as the tick
+ *              interrupt returns, pre-empting any co-operative task. It must
+ *              be short and must not share data with co-operative tasks without
+ *              disabling interrupts.
+ *
+ * @note        A static cyclic executive table, generated at build time by
+ *              gen/ttgen, can be set with Task_SetSchedule. Task_Update then
+ *              only counts ticks in the minor cycle and releases a frame at its
+ *              end. Task_Dispatch walks the list of tasks of each released
+ *              frame. Nothing is computed per tick or per task.
+ *
+ * @note        For tickless operation, Task_TicksToNextRelease gives how long the
+ *              processor can sleep and Task_UpdateMany accounts for the ticks
+ *              elapsed while sleeping.
+ *
+ * @note        When TASK_PROFILE is set, the execution time of each task and of
+ *              Task_Update is measured with the DWT cycle counter. Time spent in
+ *              interrupts (Task_Update and the pre-emptive task in PendSV)
+ *              while a task runs is not charged to it.
+ *              The latency (from release to start) is measured too.
  *
  * @see         https://www.safetty.net/products/publications/pttes
  * @see         http://www.riosscheduler.org/
@@ -19,32 +63,368 @@
  * @date        20/10/2017
  */
 
-
+#include <stdint.h>
+#include "em_device.h"
 #include "tt_tasks.h"
 
-/// Maximum number of tasks
-#define TASK_N  (10)
-
+/// Number of slots in timing wheel. Must be a power of 2
+#ifndef WHEEL_SIZE
+#define WHEEL_SIZE (256)
+#endif
+#define WHEEL_MASK (WHEEL_SIZE-1)
 
 /// To allow easy redefining
 #define INT int
 
+/// Number of words in ready bitmap. readygroup has one bit for each
+#define READY_WORDS ((TASK_N+31)/32)
+
+#if READY_WORDS > 32
+#error "TASK_N must be at most 1024"
+#endif
+
+/**
+ * @brief   Macros to enhance portability
+ */
+#define ENTER_ATOMIC() uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define EXIT_ATOMIC()  __set_PRIMASK(primask)
+#define TRIGGER_PREEMPTIVE()    (SCB->ICSR = SCB_ICSR_PENDSVSET_Msk)
+#define LOAD_EXCLUSIVE(A)       __LDREXW((volatile uint32_t *)(A))
+#define STORE_EXCLUSIVE(V,A)    __STREXW((uint32_t)(V),(volatile uint32_t *)(A))
+
+/// Kind of task in a table entry
+///@{
+#define KIND_FREE   (0)                 ///< entry not used
+#define KIND_PLAIN  (1)                 ///< added with Task_Add
+#define KIND_CTX    (2)                 ///< added with Task_AddCtx
+///@}
+
+/**
+ * @typedef TaskCode_t
+ * @brief   Task function. The member used is given by the kind of task
+ */
+typedef union {
+    void    (*plain)(void);             ///< KIND_PLAIN
+    void    (*withctx)(void *);         ///< KIND_CTX
+} TaskCode_t;
+
+/**
+ * @brief   Task table, as one array for each field
+ *
+ * @note    Task_Update only uses due, period, next and run. Each one is a
+ *          dense array, so the other fields (functions, contexts and
+ *          statistics) are not in the way and index i is the task number,
+ *          as used by the ready bitmap
+ * @note    Wheel lists hold index+1, so 0 (cleared BSS) is the end of a list
+ */
+///@{
+static uint32_t         due[TASK_N];        ///< tick of next release
+static INT              period[TASK_N];     ///< period (in ticks). when 0, task is run once
+static uint16_t         next[TASK_N];       ///< next task (index+1) in the same wheel slot
+static volatile INT     run[TASK_N];        ///< run counter. when above 1, task is delayed
+static volatile INT     overruns[TASK_N];   ///< releases that found the task not yet dispatched
+static uint8_t          kind[TASK_N];       ///< KIND_FREE, KIND_PLAIN or KIND_CTX
+static TaskCode_t       code[TASK_N];       ///< pointer to function with task code
+static void            *context[TASK_N];    ///< argument of KIND_CTX tasks
+#if TASK_PROFILE
+static TaskProfile_t    profile[TASK_N];    ///< execution time statistics
+static TaskProfile_t    latency[TASK_N];    ///< time from release to start
+static uint32_t         released[TASK_N];   ///< cycle counter at oldest pending release
+#endif
+///@}
+
+/**
+ *  @var    wheel
+ *  @brief  Lists of tasks (index+1), sorted by due. A task is in slot due&WHEEL_MASK
+ */
+static uint16_t wheel[WHEEL_SIZE];
+
+/**
+ *  @var    ready
+ *  @brief  Bitmap of released tasks. Task i is bit 31-i%32 of word i/32
+ */
+static volatile uint32_t ready[READY_WORDS];
+
+/**
+ *  @var    readygroup
+ *  @brief  Bit 31-w is set when ready[w] is not zero
+ */
+static volatile uint32_t readygroup = 0;
+
+/**
+ *  @var    now
+ *  @brief  Tick counter. Incremented by Task_Update
+ */
+static volatile uint32_t now = 0;
+
+/**
+ *  @var    overrunhook
+ *  @brief  Called by Task_Update on an overrun. Can be 0
+ */
+static void (*overrunhook)(TASKS_INT index) = 0;
+
+/**
+ *  @var    preemptive
+ *  @brief  Task run by PendSV. -1 when there is none
+ */
+static volatile INT preemptive = -1;
+
 /**
- * @typedef Task_t
- * @brief   Information about a task
+ *  @var    schedule
+ *  @brief  Static cyclic executive table. 0 when not used
  */
-typedef struct {
-    void    (*function)(void);          ///< pointer to function with task code
-    INT     counter;                    ///< counter (in ticks). when 0, task should be run
-    INT     period;                     ///< period (in ticks). when 0, task in run once
-    INT     run;                        ///< run counter. when above 1, task is delayed
-} Task_t;
+static const TaskSchedule_t * volatile schedule = 0;
 
 /**
- *  @var    tasks
- *  @brief  Task table
+ *  @var    framerun
+ *  @brief  Frames released and not yet completely dispatched
  */
-static Task_t  tasks[TASK_N];
+static volatile INT framerun = 0;
+
+/**
+ *  @var    frameoverruns
+ *  @brief  Frame releases that found more than schedule->backlog frames pending
+ */
+static volatile INT frameoverruns = 0;
+
+/**
+ *  @var    frametick
+ *  @brief  Ticks since start of current minor cycle. Changed by Task_Update
+ */
+static uint32_t frametick = 0;
+
+/**
+ *  @var    frame
+ *  @brief  Next frame to be dispatched
+ */
+static uint32_t frame = 0;
+
+#if TASK_PROFILE
+/**
+ *  @var    frameprofile
+ *  @brief  Execution time of the frames of the static table
+ */
+static TaskProfile_t frameprofile;
+
+/**
+ *  @var    tickprofile
+ *  @brief  Execution time of Task_Update
+ */
+static TaskProfile_t tickprofile;
+
+/**
+ *  @var    tickcycles
+ *  @brief  Cycles spent in Task_Update since last reset. Used to discount
+ *          interrupt time from tasks
+ */
+static volatile uint64_t tickcycles = 0;
+
+/**
+ *  @var    preemptcycles
+ *  @brief  Cycles spent in PendSV (without Task_Update) since last reset. Used
+ *          to discount the pre-emptive task from co-operative tasks
+ */
+static volatile uint64_t preemptcycles = 0;
+
+/**
+ *  @var    profileticks
+ *  @brief  Ticks since last reset
+ */
+static volatile uint32_t profileticks = 0;
+
+/**
+ * @brief   Enables the DWT cycle counter
+ */
+
+static void
+profile_init(void) {
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief   Adds a sample to the statistics
+ *
+ * @note    Histogram bin k holds samples with less than 2^(k+TASK_HIST_SHIFT+1) cycles.
+ *          The last one holds all longer samples
+ */
+
+static void
+profile_add(TaskProfile_t *p, uint32_t c) {
+int k;
+
+    k = 31-(int) __CLZ(c|1)-TASK_HIST_SHIFT;
+    if( k < 0 )
+        k = 0;
+    if( k >= TASK_HIST_N )
+        k = TASK_HIST_N-1;
+    p->hist[k]++;
+    if( (p->count == 0) || (c < p->min) )
+        p->min = c;
+    if( c > p->max )
+        p->max = c;
+    p->sum += c;
+    p->count++;
+}
+
+/**
+ * @brief   Returns the cycles spent in Task_Update and in PendSV
+ *
+ * @note    64 bit values. Read with interrupts disabled
+ */
+
+static uint64_t
+interruptcycles(void) {
+uint64_t c;
+
+    ENTER_ATOMIC();
+    c = tickcycles+preemptcycles;
+    EXIT_ATOMIC();
+    return c;
+}
+
+/**
+ * @brief   Clears the statistics
+ */
+
+static void
+profile_clear(TaskProfile_t *p) {
+int k;
+
+    p->count = 0;
+    p->min   = 0;
+    p->max   = 0;
+    p->sum   = 0;
+    for(k=0;k<TASK_HIST_N;k++)
+        p->hist[k] = 0;
+}
+#endif
+
+/**
+ * @brief   Atomically adds d to a run counter and returns its previous value
+ */
+
+static INT
+run_add(volatile INT *run, INT d) {
+INT r;
+
+    do {
+        r = (INT) LOAD_EXCLUSIVE(run);
+    } while( STORE_EXCLUSIVE(r+d,run) );
+    return r;
+}
+
+/**
+ * @brief   Atomically sets bits of a word
+ */
+
+static void
+bits_set(volatile uint32_t *w, uint32_t m) {
+uint32_t v;
+
+    do {
+        v = LOAD_EXCLUSIVE(w);
+    } while( STORE_EXCLUSIVE(v|m,w) );
+}
+
+/**
+ * @brief   Marks task i as released
+ *
+ * @note    The word is set before the group, so a group bit always has a
+ *          word with bits set
+ */
+
+static void
+ready_set(INT i) {
+
+    bits_set(&ready[i>>5],0x80000000UL>>(i&31));
+    bits_set(&readygroup,0x80000000UL>>(i>>5));
+}
+
+/**
+ * @brief   Unmarks task i
+ */
+
+static void
+ready_clear(INT i) {
+uint32_t w = i>>5;
+
+    ENTER_ATOMIC();
+    ready[w] &= ~(0x80000000UL>>(i&31));
+    if( ready[w] == 0 )
+        readygroup &= ~(0x80000000UL>>w);
+    EXIT_ATOMIC();
+}
+
+/**
+ * @brief   Returns the released task with the lowest index. TASK_N if none
+ *
+ * @note    Bits are only cleared by the caller, so the word of a group bit
+ *          read as set cannot be zero
+ */
+
+static INT
+ready_first(void) {
+uint32_t g = readygroup;
+uint32_t w;
+
+    if( !g )
+        return TASK_N;
+    w = __CLZ(g);
+    return (INT) (w*32+__CLZ(ready[w]));
+}
+
+/**
+ * @brief   Inserts a task in its wheel slot
+ *
+ * @note    Tasks with the same due keep the insertion order
+ * @note    Must be called with interrupts disabled (or from Task_Update)
+ */
+
+static void
+wheel_insert(INT i) {
+uint16_t *p = &wheel[due[i]&WHEEL_MASK];
+
+    while( *p && (int32_t) (due[*p-1] - due[i]) <= 0 )
+        p = &next[*p-1];
+    next[i] = *p;
+    *p = i+1;
+}
+
+/**
+ * @brief   Removes a task from its wheel slot, when it is there
+ *
+ * @note    Must be called with interrupts disabled
+ */
+
+static void
+wheel_remove(INT i) {
+uint16_t *p = &wheel[due[i]&WHEEL_MASK];
+
+    while( *p && (*p != i+1) )
+        p = &next[*p-1];
+    if( *p )
+        *p = next[i];
+    next[i] = 0;
+}
+
+/**
+ * @brief   Advances time by n ticks without releasing tasks
+ *
+ * @note    There must be no release in the next n ticks
+ */
+
+static void
+skip(uint32_t n) {
+
+    now += n;
+    if( schedule )
+        frametick += n;
+#if TASK_PROFILE
+    profileticks += n;
+#endif
+}
 
 /**
  * @details Uses Task_Delete
@@ -56,6 +436,13 @@ int i;
     for(i=0; i<TASK_N; i++ ) {
         Task_Delete(i);
     }
+    Task_SetSchedule(0);
+    // PendSV must not pre-empt other interrupts
+    NVIC_SetPriority(PendSV_IRQn,(1<<__NVIC_PRIO_BITS)-1);
+#if TASK_PROFILE
+    profile_init();
+    Task_ResetProfile();
+#endif
 
 }
 
@@ -64,70 +451,484 @@ int i;
  */
 void Task_Delete(TASKS_INT index) {
 
-    tasks[index].function = 0;
-    tasks[index].counter  = 0;
-    tasks[index].period   = 0;
-    tasks[index].run      = 0;
+    ENTER_ATOMIC();
+    if( kind[index] != KIND_FREE )
+        wheel_remove(index);
+    ready_clear(index);
+    if( index == preemptive )
+        preemptive = -1;
+    kind[index]     = KIND_FREE;
+    code[index].plain = 0;
+    context[index]  = 0;
+    period[index]   = 0;
+    run[index]      = 0;
+    overruns[index] = 0;
+    due[index]      = 0;
+    EXIT_ATOMIC();
 
 }
 
 /**
- * @details No check is done on input parameters
+ * @brief   Adds a task of kind k to the first free entry
+ *
+ * @note    Task is released first d+1 ticks later and then every p ticks
  */
 
-int Task_Add(  void (*f)(void), TASKS_INT p, TASKS_INT d) {
+static int
+add(uint8_t k, TaskCode_t f, void *ctx, TASKS_INT p, TASKS_INT d) {
 int i = 0;
 
-    while( (i<TASK_N) && (tasks[i].function) ) i++;
+    while( (i<TASK_N) && (kind[i] != KIND_FREE) ) i++;
 
     if( i == TASK_N )
         // No more space for this task
         return -1;
 
-    tasks[i].function = f;
-    tasks[i].period   = p;
-    tasks[i].counter  = d;
-    tasks[i].run      = 0;
+    ENTER_ATOMIC();
+    kind[i]     = k;
+    code[i]     = f;
+    context[i]  = ctx;
+    period[i]   = p;
+    run[i]      = 0;
+    overruns[i] = 0;
+#if TASK_PROFILE
+    profile_clear(&profile[i]);
+    profile_clear(&latency[i]);
+#endif
+    due[i]      = now+d+1;
+    wheel_insert(i);
+    EXIT_ATOMIC();
 
     return i;
 }
 
 /**
- * @details none
+ * @details No check is done on input parameters
+ */
+
+int Task_Add(  void (*f)(void), TASKS_INT p, TASKS_INT d) {
+TaskCode_t c;
+
+    c.plain = f;
+    return add(KIND_PLAIN,c,0,p,d);
+}
+
+/**
+ * @details No check is done on input parameters
+ */
+
+int Task_AddCtx(void (*f)(void *), void *ctx, TASKS_INT p, TASKS_INT d) {
+TaskCode_t c;
+
+    c.withctx = f;
+    return add(KIND_CTX,c,ctx,p,d);
+}
+
+/**
+ * @details Only the head of the current slot is examined. Released tasks
+ *          are moved to the slot of their next release
  */
 
 void Task_Update(void) {
-int i;
+uint16_t *slot;
+const TaskSchedule_t *s = schedule;
+uint32_t n;
+INT i;
+#if TASK_PROFILE
+uint32_t c0 = DWT->CYCCNT;
+#endif
+
+    n = ++now;
+    if( s && (++frametick == s->minor) ) {
+        frametick = 0;
+        if( run_add(&framerun,1) > (INT) s->backlog )
+            frameoverruns++;
+    }
+    slot = &wheel[n&WHEEL_MASK];
+    while( *slot && (due[i=*slot-1] == n) ) {
+        *slot = next[i];
+        if( run_add(&run[i],1) > 0 ) {
+            overruns[i]++;
+            if( overrunhook )
+                overrunhook(i);
+        }
+#if TASK_PROFILE
+        else {
+            released[i] = DWT->CYCCNT;
+        }
+#endif
+        if( i == preemptive )
+            TRIGGER_PREEMPTIVE();
+        else
+            ready_set(i);
+        if( period[i] ) {
+            due[i] += period[i];
+            wheel_insert(i);
+        } else {
+            next[i] = 0;
+        }
+    }
+
+#if TASK_PROFILE
+    n = DWT->CYCCNT-c0;
+    profile_add(&tickprofile,n);
+    tickcycles += n;
+    profileticks++;
+#endif
+}
+
+/**
+ * @brief   Calls the function of task i, with its context when it has one
+ */
+
+static void
+call(INT i) {
+
+    if( kind[i] == KIND_CTX )
+        code[i].withctx(context[i]);
+    else
+        code[i].plain();
+}
+
+/**
+ * @brief   Runs a released task once
+ *
+ * @note    When profiling, cycles spent in Task_Update and in PendSV while
+ *          the task runs are discounted. After an overrun, the latency of the next pending
+ *          release is measured from now
+ */
+
+static void
+execute(INT i) {
+#if TASK_PROFILE
+uint32_t c0;
+uint64_t t0;
+
+    t0 = interruptcycles();
+    c0 = DWT->CYCCNT;
+    profile_add(&latency[i],c0-released[i]);
+    (void) run_add(&run[i],-1);
+    if( run[i] )
+        released[i] = c0;
+    call(i);
+    profile_add(&profile[i],DWT->CYCCNT-c0-(uint32_t) (interruptcycles()-t0));
+#else
+    (void) run_add(&run[i],-1);
+    call(i);
+#endif
+}
+
+/**
+ * @brief   Runs the tasks of the next frame of the static table
+ *
+ * @note    The frame is counted as pending until its last task returns
+ */
+
+static void
+runframe(const TaskSchedule_t *s) {
+uint32_t k,begin,end;
+#if TASK_PROFILE
+uint32_t c0;
+uint64_t t0;
 
-    for( i=0; i<TASK_N; i++ ) {
+    t0 = interruptcycles();
+    c0 = DWT->CYCCNT;
+#endif
+    begin = s->frame[frame];
+    end   = s->frame[frame+1];
+    for(k=begin;k<end;k++)
+        s->list[k]();
+    frame = (frame+1 == s->frames) ? 0 : frame+1;
+    (void) run_add(&framerun,-1);
+#if TASK_PROFILE
+    // Empty frames are not counted
+    if( end != begin )
+        profile_add(&frameprofile,DWT->CYCCNT-c0-(uint32_t) (interruptcycles()-t0));
+#endif
+}
+
+/**
+ * @details Skips ticks without releases, so the cost depends on the number
+ *          of releases and not on n
+ */
+
+void Task_UpdateMany(uint32_t n) {
+uint32_t k;
 
-        if ( tasks[i].function ) {
-            if( tasks[i].counter == 0 ) {
-                tasks[i].run++;             // DANGER: hazard
-                tasks[i].counter = tasks[i].period;
-            } else {
-                tasks[i].counter--;
-            }
+    while( n ) {
+        k = Task_TicksToNextRelease();
+        if( k > n ) {
+            skip(n);
+            return;
         }
+        skip(k-1);
+        Task_Update();
+        n -= k;
     }
+}
+
+/**
+ * @details Only one pre-emptive task is allowed. It is marked as pre-emptive
+ *          before a tick can release it, so it is never run by Task_Dispatch
+ */
+
+int Task_AddPreemptive(void (*f)(void), TASKS_INT p, TASKS_INT d) {
+int i = -1;
 
+    ENTER_ATOMIC();
+    if( preemptive < 0 ) {
+        i = Task_Add(f,p,d);
+        if( i >= 0 )
+            preemptive = i;
+    }
+    EXIT_ATOMIC();
+    return i;
 }
 
 /**
- * @details updates counters e set fun variable
+ * @details The first frame is released by the next Task_Update
  */
 
-void Task_Dispatch(void) {
+void Task_SetSchedule(const TaskSchedule_t *s) {
+
+    ENTER_ATOMIC();
+    schedule      = s;
+    framerun      = 0;
+    frameoverruns = 0;
+    frametick     = s ? s->minor-1 : 0;
+    frame         = 0;
+#if TASK_PROFILE
+    profile_clear(&frameprofile);
+#endif
+    EXIT_ATOMIC();
+}
+
+/**
+ * @details none
+ */
+
+int Task_GetScheduleOverruns(void) {
+
+    return frameoverruns;
+}
+
+/**
+ * @details Called by PendSV_Handler. Runs all pending releases
+ *
+ * @note    When profiling, the cycles spent here, less those of Task_Update,
+ *          are added to preemptcycles
+ */
+
+void Task_RunPreemptive(void) {
+INT i = preemptive;
+#if TASK_PROFILE
+uint32_t c0;
+uint64_t t0;
+#endif
+
+    if( i < 0 )
+        return;
+#if TASK_PROFILE
+    t0 = Task_GetTickCycles();
+    c0 = DWT->CYCCNT;
+#endif
+    while( run[i] ) {
+        execute(i);
+        if( period[i] == 0 ) {
+            Task_Delete(i);
+            break;
+        }
+    }
+#if TASK_PROFILE
+    preemptcycles += DWT->CYCCNT-c0-(uint32_t) (Task_GetTickCycles()-t0);
+#endif
+}
+
+/**
+ * @brief   PendSV interrupt handler
+ *
+ * @note    Set pending by Task_Update when the pre-emptive task is released
+ */
+
+void PendSV_Handler(void) {
+
+    Task_RunPreemptive();
+}
+
+/**
+ * @details Looks at the head of every slot. The head has the lowest due of the slot
+ */
+
+uint32_t Task_TicksToNextRelease(void) {
+const TaskSchedule_t *s = schedule;
+uint32_t min = TASK_NEVER;
+uint32_t d;
 int i;
 
-    for( i=0; i<TASK_N; i++ ) {
-        if( tasks[i].run ) {
-            tasks[i].run--;
-            tasks[i].function();
-            if( tasks[i].period == 0 ) {// Run once tasks
-                Task_Delete(i);
-            }
+    if( s )
+        min = s->minor-frametick;
+    for(i=0;i<WHEEL_SIZE;i++) {
+        if( wheel[i] ) {
+            d = due[wheel[i]-1]-now;
+            if( d < min )
+                min = d;
+        }
+    }
+    return min;
+}
+
+/**
+ * @details The pre-emptive task is not considered. It is run by PendSV
+ */
+
+int Task_Ready(void) {
+
+    return (readygroup != 0) || (framerun != 0);
+}
+
+/**
+ * @details none
+ */
+
+uint32_t Task_GetTime(void) {
+
+    return now;
+}
+
+/**
+ * @details Runs first the frames of the static table, then the released
+ *          tasks, in index order. A task released while another runs is
+ *          run in the same call, before tasks with higher index
+ */
+
+void Task_Dispatch(void) {
+const TaskSchedule_t *s = schedule;
+INT i;
+
+    while( s && framerun ) {
+        runframe(s);
+    }
+    while( (i=ready_first()) < TASK_N ) {
+        ready_clear(i);
+        execute(i);
+        if( period[i] == 0 ) {      // Run once tasks
+            Task_Delete(i);
+        } else if( run[i] ) {       // Pending releases
+            ready_set(i);
         }
     }
 
 }
+
+/**
+ * @details No check is done in index parameter (Must be less than TASK_N)
+ */
+
+int Task_GetOverruns(TASKS_INT index) {
+
+    return overruns[index];
+}
+
+/**
+ * @details The hook runs inside the timer interrupt. It must be short
+ */
+
+void Task_SetOverrunHook(void (*hook)(TASKS_INT index)) {
+
+    overrunhook = hook;
+}
+
+#if TASK_PROFILE
+/**
+ * @details 64 bit value. Read with interrupts disabled
+ */
+
+uint64_t Task_GetTickCycles(void) {
+uint64_t c;
+
+    ENTER_ATOMIC();
+    c = tickcycles;
+    EXIT_ATOMIC();
+    return c;
+}
+
+/**
+ * @details No check is done in index parameter (Must be less than TASK_N)
+ */
+
+const TaskProfile_t *Task_GetProfile(TASKS_INT index) {
+
+    return &profile[index];
+}
+
+/**
+ * @details none
+ */
+
+const TaskProfile_t *Task_GetLatency(TASKS_INT index) {
+
+    return &latency[index];
+}
+
+/**
+ * @details none
+ */
+
+const TaskProfile_t *Task_GetFrameProfile(void) {
+
+    return &frameprofile;
+}
+
+/**
+ * @details none
+ */
+
+const TaskProfile_t *Task_GetTickProfile(void) {
+
+    return &tickprofile;
+}
+
+/**
+ * @details Busy time is the sum of the time of the co-operative tasks, frames
+ *          of the static table, Task_Update and PendSV. The pre-emptive task
+ *          is counted by PendSV only.
+ *          Total time is the number of ticks times the tick period
+ */
+
+int Task_GetUtilization(void) {
+uint64_t busy,total;
+int i;
+
+    total = (uint64_t) profileticks*(SystemCoreClock/TASK_TICK_HZ);
+    if( total == 0 )
+        return 0;
+    busy = interruptcycles()+frameprofile.sum;
+    for(i=0;i<TASK_N;i++) {
+        if( (kind[i] != KIND_FREE) && (i != preemptive) )
+            busy += profile[i].sum;
+    }
+    if( busy > total )
+        busy = total;
+    return (int) ((busy*1000)/total);
+}
+
+/**
+ * @details Interrupts are disabled while clearing. Tasks are not running
+ */
+
+void Task_ResetProfile(void) {
+int i;
+
+    ENTER_ATOMIC();
+    for(i=0;i<TASK_N;i++) {
+        profile_clear(&profile[i]);
+        profile_clear(&latency[i]);
+    }
+    profile_clear(&tickprofile);
+    profile_clear(&frameprofile);
+    tickcycles    = 0;
+    preemptcycles = 0;
+    profileticks  = 0;
+    EXIT_ATOMIC();
+}
+#endif
@@ -14,6 +14,60 @@
  * @date        20/10/2017
  */
 
+#include <stdint.h>
+
+/// Maximum number of tasks. The host simulations and benchmark use 256
+#ifndef TASK_N
+#define TASK_N  (16)
+#endif
+
+/// Tick frequency (Hz)
+#ifndef TASK_TICK_HZ
+#define TASK_TICK_HZ (1000)
+#endif
+
+/// Returned by Task_TicksToNextRelease when there is no task
+#define TASK_NEVER  (0xFFFFFFFFu)
+
+/// Set to 0 to remove execution time measurement
+#ifndef TASK_PROFILE
+#define TASK_PROFILE 1
+#endif
+
+/// Number of bins in execution time histogram
+#define TASK_HIST_N     (12)
+/// First bin holds times below 2^(TASK_HIST_SHIFT+1) cycles
+#define TASK_HIST_SHIFT (6)
+
+
+/**
+ * @typedef TaskProfile_t
+ * @brief   Execution time statistics (in cycles)
+ *
+ * @note    Mean is sum/count
+ */
+typedef struct {
+    uint32_t    count;                  ///< number of samples
+    uint32_t    min;                    ///< best case
+    uint32_t    max;                    ///< worst case
+    uint64_t    sum;                    ///< sum of all samples
+    uint32_t    hist[TASK_HIST_N];      ///< bin k: less than 2^(k+TASK_HIST_SHIFT+1) cycles
+} TaskProfile_t;
+
+/**
+ * @typedef TaskSchedule_t
+ * @brief   Static cyclic executive table, generated by gen/ttgen
+ *
+ * @note    The major cycle has frames minor cycles (frames) of minor ticks.
+ *          Tasks of frame k are list[frame[k]] to list[frame[k+1]-1]
+ */
+typedef struct {
+    uint32_t    minor;                  ///< minor cycle (in ticks)
+    uint32_t    frames;                 ///< number of frames in major cycle
+    uint32_t    backlog;                ///< maximum frames pending at a release
+    const uint16_t *frame;              ///< frames+1 indexes into list
+    void        (* const *list)(void);  ///< task functions in execution order
+} TaskSchedule_t;
 
 /**
  * @fn      Task_Init
@@ -45,6 +99,70 @@ void Task_Delete(TASKS_INT index);
  */
 int Task_Add(void (*f)(void), TASKS_INT p, TASKS_INT d);
 
+/**
+ * @fn      Task_AddCtx
+ * @brief   Add a task that receives a context pointer to tasks table
+ *
+ *          Several instances of the same code can run, each one with its
+ *          own state in the structure pointed by ctx
+ *
+ * @param   f          pointer to task function. Called as f(ctx)
+ * @param   ctx        argument of f
+ * @param   p          period (in ticks)
+ * @param   d          initial delay (in ticks)
+ * @return  index of task in tasks table. -1 if there is no more space for this task
+ */
+int Task_AddCtx(void (*f)(void *), void *ctx, TASKS_INT p, TASKS_INT d);
+
+/**
+ * @fn      Task_AddPreemptive
+ * @brief   Add the pre-emptive task to tasks table
+ *
+ *          It is run by the PendSV interrupt as soon as it is released.
+ *          There can be only one. It must be short
+ *
+ * @param   f          pointer to task function
+ * @param   p          period (in ticks)
+ * @param   d          initial delay (in ticks)
+ * @return  index of task in tasks table. -1 if there is no more space or
+ *          there is already a pre-emptive task
+ */
+int Task_AddPreemptive(void (*f)(void), TASKS_INT p, TASKS_INT d);
+
+/**
+ * @fn      Task_RunPreemptive
+ * @brief   Runs the pre-emptive task, if released
+ *
+ *          Called by PendSV_Handler (defined in tt_tasks.c)
+ *
+ * @param   void
+ * @return  void
+ */
+void Task_RunPreemptive(void);
+
+/**
+ * @fn      Task_SetSchedule
+ * @brief   Sets a static cyclic executive table
+ *
+ *          Frame 0 is released by the next Task_Update. Task_Dispatch runs
+ *          the tasks of the released frames before the tasks added with
+ *          Task_Add, which still work
+ *
+ * @param   s          pointer to table. 0 to stop using it
+ * @return  void
+ */
+void Task_SetSchedule(const TaskSchedule_t *s);
+
+/**
+ * @fn      Task_GetScheduleOverruns
+ * @brief   Returns how many times a frame was released with more frames
+ *          pending than found by ttgen
+ *
+ * @param   void
+ * @return  overrun counter
+ */
+int Task_GetScheduleOverruns(void);
+
 /**
  * @fn      Task_Update
  * @brief   Update tasks table enabling execution of tasks in Task_Dispatch
@@ -66,4 +184,133 @@ void Task_Update( void );
  */
 void Task_Dispatch(void);
 
+/**
+ * @fn      Task_UpdateMany
+ * @brief   Same as calling Task_Update n times
+ *
+ *          Used by tickless operation to account for ticks elapsed while sleeping.
+ *          Must be called from the timer interrupt or with interrupts disabled
+ *
+ * @param   n          number of ticks elapsed
+ * @return  void
+ */
+void Task_UpdateMany(uint32_t n);
+
+/**
+ * @fn      Task_TicksToNextRelease
+ * @brief   Returns the number of ticks until the next release of any task
+ *
+ * @param   void
+ * @return  number of ticks (at least 1). TASK_NEVER when there are no tasks
+ */
+uint32_t Task_TicksToNextRelease(void);
+
+/**
+ * @fn      Task_Ready
+ * @brief   Returns 1 when there is a task released and not yet dispatched
+ *
+ * @param   void
+ * @return  1 or 0
+ */
+int Task_Ready(void);
+
+/**
+ * @fn      Task_GetTime
+ * @brief   Returns number of ticks since start
+ *
+ * @param   void
+ * @return  ticks (wraps around)
+ */
+uint32_t Task_GetTime(void);
+
+/**
+ * @fn      Task_GetOverruns
+ * @brief   Returns how many times a task was released before its last
+ *          release was dispatched
+ *
+ * @param   index of task
+ * @return  overrun counter
+ */
+int Task_GetOverruns(TASKS_INT index);
+
+/**
+ * @fn      Task_SetOverrunHook
+ * @brief   Sets a function to be called by Task_Update on an overrun
+ *
+ *          It is called inside the timer interrupt
+ *
+ * @param   hook       pointer to function receiving the task index. 0 to disable
+ * @return  void
+ */
+void Task_SetOverrunHook(void (*hook)(TASKS_INT index));
+
+#if TASK_PROFILE
+/**
+ * @fn      Task_GetProfile
+ * @brief   Returns execution time statistics of a task
+ *
+ * @param   index of task
+ * @return  pointer to statistics
+ */
+const TaskProfile_t *Task_GetProfile(TASKS_INT index);
+
+/**
+ * @fn      Task_GetLatency
+ * @brief   Returns statistics of the time between release and start of a task
+ *
+ * @param   index of task
+ * @return  pointer to statistics
+ */
+const TaskProfile_t *Task_GetLatency(TASKS_INT index);
+
+/**
+ * @fn      Task_GetFrameProfile
+ * @brief   Returns execution time statistics of the frames of the static table
+ *
+ * @param   void
+ * @return  pointer to statistics
+ */
+const TaskProfile_t *Task_GetFrameProfile(void);
+
+/**
+ * @fn      Task_GetTickProfile
+ * @brief   Returns execution time statistics of Task_Update
+ *
+ *          Interrupt entry and exit are not included
+ *
+ * @param   void
+ * @return  pointer to statistics
+ */
+const TaskProfile_t *Task_GetTickProfile(void);
+
+/**
+ * @fn      Task_GetTickCycles
+ * @brief   Returns cycles spent in Task_Update since last reset
+ *
+ * @param   void
+ * @return  number of cycles
+ */
+uint64_t Task_GetTickCycles(void);
+
+/**
+ * @fn      Task_GetUtilization
+ * @brief   Returns CPU utilization since last reset
+ *
+ *          Idle time is the rest
+ *
+ * @param   void
+ * @return  utilization in units of 0.1 %
+ */
+int Task_GetUtilization(void);
+
+/**
+ * @fn      Task_ResetProfile
+ * @brief   Clears all execution time statistics
+ *
+ * @param   void
+ * @return  void
+ */
+void Task_ResetProfile(void);
+#endif
+
 #endif // TT_TASKS_H
@@ -0,0 +1,155 @@
+/**
+ * @file        tt_tickless.c
+ * @brief       tickless operation of the time triggered kernel
+ *
+ * @note        Time is kept as the number of low power timer counts since start,
+ *              extended to 64 bits. The tick count is always derived from it:
+ *
+ *                  ticks = floor(counts*TASK_TICK_HZ/LPTIMER_HZ)
+ *
+ *              and tick n starts at count ceil(n*LPTIMER_HZ/TASK_TICK_HZ). So
+ *              there is no accumulated rounding error (drift), even when a tick
+ *              is not an integer number of counts (1 ms = 32.768 counts).
+ *
+ * @note        When the compare value would be too close to the counter, the
+ *              interrupt is delayed by up to LPTIMER_MINDELTA counts. Releases
+ *              are late by that, but the tick count stays exact.
+ *
+ * @note        The counter must be read at least once per wrap around. It is
+ *              guaranteed by TICKLESS_MAXSLEEP.
+ */
+
+#include <stdint.h>
+#include "em_device.h"
+#include "tt_tasks.h"
+#include "tt_tickless.h"
+#include "lptimer.h"
+
+/**
+ * @brief   Macros to enhance portability
+ */
+#define ENTER_ATOMIC() uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define EXIT_ATOMIC()  __set_PRIMASK(primask)
+
+/// Counts since start
+static uint64_t counts = 0;
+/// Last counter value read
+static uint32_t lastcounter = 0;
+/// Ticks since start, already passed to Task_UpdateMany
+static uint64_t ticks = 0;
+/// Sleep mode
+static int deepsleep = 0;
+
+/**
+ * @brief   Conversion between ticks and low power timer counts
+ */
+///@{
+static inline uint64_t tick2count(uint64_t t) {
+    return (t*LPTIMER_HZ+TASK_TICK_HZ-1)/TASK_TICK_HZ;
+}
+static inline uint64_t count2tick(uint64_t c) {
+    return (c*TASK_TICK_HZ)/LPTIMER_HZ;
+}
+///@}
+
+/**
+ * @brief   Reads the counter and updates counts
+ *
+ * @note    Must be called with interrupts disabled or from the interrupt
+ */
+
+static void
+readcounter(void) {
+uint32_t c = LPTimer_Read();
+
+    counts += (c-lastcounter)&LPTIMER_MASK;
+    lastcounter = c;
+}
+
+/**
+ * @brief   Sets compare for the next release
+ *
+ * @note    Must be called with interrupts disabled or from the interrupt
+ */
+
+static void
+program(void) {
+uint32_t k;
+uint64_t target;
+
+    k = Task_TicksToNextRelease();
+    if( k > TICKLESS_MAXSLEEP )
+        k = TICKLESS_MAXSLEEP;
+    target = tick2count(ticks+k);
+
+    readcounter();
+    if( target < counts+LPTIMER_MINDELTA )
+        target = counts+LPTIMER_MINDELTA;
+    LPTimer_SetCompare((uint32_t) target);
+}
+
+/**
+ * @brief   Called by the low power timer interrupt
+ *
+ * @note    Accounts for all ticks elapsed since last call, then
+ *          sets the compare for the next release
+ */
+
+static void
+update(void) {
+uint64_t t;
+
+    readcounter();
+    t = count2tick(counts);
+    if( t > ticks ) {
+        Task_UpdateMany((uint32_t) (t-ticks));
+        ticks = t;
+    }
+    program();
+}
+
+/**
+ * @details Tasks added before are released at the right time
+ */
+
+void TT_Tickless_Init(int deep) {
+
+    deepsleep = deep;
+    counts    = 0;
+    ticks     = 0;
+    LPTimer_Init(update);
+    lastcounter = LPTimer_Read();
+    ENTER_ATOMIC();
+    program();
+    EXIT_ATOMIC();
+}
+
+/**
+ * @details Interrupts are disabled between the test and the sleep, so a
+ *          release can not be lost. The compare is programmed again, because
+ *          tasks could have been added
+ */
+
+void TT_Tickless_Idle(void) {
+
+    ENTER_ATOMIC();
+    if( !Task_Ready() ) {
+        program();
+        LPTimer_Sleep(deepsleep);
+    }
+    EXIT_ATOMIC();
+}
+
+/**
+ * @details none
+ */
+
+uint64_t TT_Tickless_GetCounts(void) {
+uint64_t c;
+
+    ENTER_ATOMIC();
+    readcounter();
+    c = counts;
+    EXIT_ATOMIC();
+    return c;
+}
@@ -0,0 +1,49 @@
+#ifndef TT_TICKLESS_H
+#define TT_TICKLESS_H
+/**
+ * @file        tt_tickless.h
+ * @brief       tickless operation of the time triggered kernel
+ *
+ * @note        Instead of an interrupt every tick, the low power timer
+ *              (lptimer.h) interrupts only when a task is released. The
+ *              processor sleeps between releases.
+ */
+
+#include <stdint.h>
+
+/// Maximum sleep (in ticks). Must be less than the low power timer wrap around
+#ifndef TICKLESS_MAXSLEEP
+#define TICKLESS_MAXSLEEP   (256*TASK_TICK_HZ)
+#endif
+
+/**
+ * @fn      TT_Tickless_Init
+ * @brief   Starts the low power timer. SysTick must not be used
+ *
+ * @param   deep       1 to sleep in EM2, 0 to sleep in EM1.
+ *                     The UART does not work in EM2
+ * @return  void
+ */
+void TT_Tickless_Init(int deep);
+
+/**
+ * @fn      TT_Tickless_Idle
+ * @brief   Sleeps until the next release, when no task is ready
+ *
+ *          Must be called in the main loop after Task_Dispatch
+ *
+ * @param   void
+ * @return  void
+ */
+void TT_Tickless_Idle(void);
+
+/**
+ * @fn      TT_Tickless_GetCounts
+ * @brief   Returns low power timer counts since TT_Tickless_Init
+ *
+ * @param   void
+ * @return  64 bit count. Does not wrap around
+ */
+uint64_t TT_Tickless_GetCounts(void);
+
+#endif // TT_TICKLESS_H
@@ -0,0 +1,222 @@
+/**
+ * @file        bench_pt.c
+ * @brief       port of the common benchmark (bench.h) to the protothread scheduler
+ *
+ * @note        Each test adds its threads and runs Sched_Dispatch until the
+ *              measuring thread ends:
+ *              - coop:     PT_YIELD in BenchFirst until BenchSecond runs
+ *              - isr:      BENCH_IRQn set pending by BenchSource until
+ *                          BenchWaiter runs. The interrupt signals a semaphore
+ *              - message:  Queue_Put and Queue_Get of a BENCH_MSGSIZE item
+ *              - sem:      Sem_Signal(ping) in BenchPing until it gets pong
+ *                          back from BenchPong
+ *              There are no priorities nor pre-emption, so preempt is n/a.
+ *              Threads have no stack, so task is the size of Thread_t.
+ *
+ * @note        Variables are static, since protothreads do not keep locals.
+ *
+ * @note        Must be called after Sched_Init and Console_Init (the UART is
+ *              used for the output) and before the other threads are added
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "em_device.h"
+
+#include "pt_sched.h"
+#include "pt_sync.h"
+#include "uart.h"
+#include "bench.h"
+
+/// Events (0 to 3 are used by pt_uart.c and console.c)
+///@{
+#define EVENT_ISR       (8)
+#define EVENT_BACK      (9)
+#define EVENT_PING      (10)
+#define EVENT_PONG      (11)
+#define EVENT_QUEUE     (12)
+///@}
+
+/// Messages in the queue
+#define QUEUESIZE       (4)
+
+/**
+ * @brief   Global variables
+ */
+///@{
+static BenchStat_t          stat;
+static volatile uint32_t    stamp = 0;      ///< cycle counter at the start of a sample
+static volatile int         running = 0;    ///< measuring threads not ended
+static Semaphore_t          isrsem, back, ping, pong;
+static Queue_t              queue;
+static uint8_t              queuearea[QUEUESIZE*BENCH_MSGSIZE];
+static uint8_t              message[BENCH_MSGSIZE];
+static int                  count = 0;      ///< messages sent
+///@}
+
+/**
+ * @brief   Writes a line when the output buffer has space for it
+ */
+
+static void
+Write(const char *s) {
+
+    while( UART_GetTxSpace() < strlen(s) ) {}
+    UART_SendString((char *) s);
+}
+
+/**
+ * @brief   Interrupt of the isr test
+ */
+
+void BENCH_IRQHandler(void) {
+
+    Sem_Signal(&isrsem);
+}
+
+/**
+ * @brief   coop threads
+ */
+///@{
+static PT_THREAD(BenchFirst(Thread_t *t)) {
+
+    PT_BEGIN(&t->pt);
+    while( stat.n < BENCH_SAMPLES ) {
+        stamp = BENCH_NOW();
+        PT_YIELD(&t->pt);
+    }
+    running--;
+    PT_END(&t->pt);
+}
+
+static PT_THREAD(BenchSecond(Thread_t *t)) {
+
+    PT_BEGIN(&t->pt);
+    while( stat.n < BENCH_SAMPLES ) {
+        Bench_Add(&stat,BENCH_NOW()-stamp);
+        PT_YIELD(&t->pt);
+    }
+    PT_END(&t->pt);
+}
+///@}
+
+/**
+ * @brief   isr threads. BenchWaiter is added first, so it is already waiting
+ */
+///@{
+static PT_THREAD(BenchWaiter(Thread_t *t)) {
+
+    PT_BEGIN(&t->pt);
+    while( stat.n < BENCH_SAMPLES ) {
+        THREAD_SEM_WAIT(t,&isrsem);
+        Bench_Add(&stat,BENCH_NOW()-stamp);
+        Sem_Signal(&back);
+    }
+    running--;
+    PT_END(&t->pt);
+}
+
+static PT_THREAD(BenchSource(Thread_t *t)) {
+
+    PT_BEGIN(&t->pt);
+    while( stat.n < BENCH_SAMPLES ) {
+        stamp = BENCH_NOW();
+        BENCH_TRIGGER();
+        THREAD_SEM_WAIT(t,&back);
+    }
+    PT_END(&t->pt);
+}
+///@}
+
+/**
+ * @brief   message thread. Never waits
+ */
+
+static PT_THREAD(BenchMessage(Thread_t *t)) {
+uint32_t c;
+
+    PT_BEGIN(&t->pt);
+    for(count=0;count<BENCH_SAMPLES;count++) {
+        c = BENCH_NOW();
+        (void) Queue_Put(&queue,message);
+        (void) Queue_Get(&queue,message);
+        Bench_Add(&stat,BENCH_NOW()-c);
+    }
+    running--;
+    PT_END(&t->pt);
+}
+
+/**
+ * @brief   sem threads. BenchPong never ends and is deleted by Bench_Start
+ */
+///@{
+static PT_THREAD(BenchPing(Thread_t *t)) {
+
+    PT_BEGIN(&t->pt);
+    while( stat.n < BENCH_SAMPLES ) {
+        stamp = BENCH_NOW();
+        Sem_Signal(&ping);
+        THREAD_SEM_WAIT(t,&pong);
+        Bench_Add(&stat,BENCH_NOW()-stamp);
+    }
+    running--;
+    PT_END(&t->pt);
+}
+
+static PT_THREAD(BenchPong(Thread_t *t)) {
+
+    PT_BEGIN(&t->pt);
+    while(1) {
+        THREAD_SEM_WAIT(t,&ping);
+        Sem_Signal(&pong);
+    }
+    PT_END(&t->pt);
+}
+///@}
+
+/**
+ * @brief   Adds the threads of a test and runs them until the measuring one ends
+ *
+ * @note    The first thread is the measuring one. The second one, if not
+ *          ended, is deleted
+ */
+
+static void
+Run(const char *test, char (*f1)(Thread_t *), char (*f2)(Thread_t *)) {
+Thread_t *t2 = 0;
+
+    Bench_Clear(&stat);
+    running = 1;
+    (void) Sched_Add(f1,0);
+    if( f2 )
+        t2 = Sched_Add(f2,0);
+    while( running )
+        Sched_Dispatch();
+    if( t2 && t2->f )
+        Sched_Delete(t2);
+    Bench_Report(test,&stat);
+}
+
+/**
+ * @details Interrupts must be enabled for the UART
+ */
+
+void Bench_Start(void) {
+
+    __enable_irq();
+    Bench_Init("pt",Write);
+
+    Sem_Init(&isrsem,0,EVENT_ISR);
+    Sem_Init(&back,0,EVENT_BACK);
+    Sem_Init(&ping,0,EVENT_PING);
+    Sem_Init(&pong,0,EVENT_PONG);
+    Queue_Init(&queue,queuearea,BENCH_MSGSIZE,QUEUESIZE,EVENT_QUEUE);
+
+    Run("coop",BenchFirst,BenchSecond);
+    Bench_Report("preempt",0);
+    Run("isr",BenchWaiter,BenchSource);
+    Run("message",BenchMessage,0);
+    Run("sem",BenchPing,BenchPong);
+    Bench_ReportMemory(sizeof(Thread_t));
+    Bench_End();
+}
@@ -0,0 +1,43 @@
+/**
+ * @file    blinker.c
+ * @brief   Blinker protothread
+ *
+ * @note    Toggles both LEDs every second
+ */
+
+#include <stdint.h>
+
+#include "led.h"
+#include "blinker.h"
+
+/*****************************************************************************
+ * @brief  Blinker processing routine
+ *
+ * @note   The delay is kept by the scheduler for each thread, so there is no
+ *         global threshold and the thread is not run while waiting
+ */
+
+PT_THREAD(Blinker(Thread_t *t)) {
+
+    PT_BEGIN(&t->pt);
+
+    LED_Write(LED1,LED0);
+
+    while(1) {
+        // Processing
+        LED_Toggle(LED1|LED0);
+        THREAD_DELAY(t,1000);
+
+        LED_Toggle(LED1|LED0);
+        THREAD_DELAY(t,1000);
+
+//        LED_Write(0,LED0|LED1);
+//        THREAD_DELAY(t,1000);
+
+    }
+
+    (void) PT_YIELD_FLAG; // to silence compiler warning
+
+    PT_END(&t->pt);
+
+}
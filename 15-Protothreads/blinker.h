@@ -0,0 +1,15 @@
+#ifndef BLINKER_H
+#define BLINKER_H
+/**
+ * @file    blinker.h
+ * @brief   Blinker protothread
+ *
+ * @note    Kept apart from main.c, so the host simulation (sim) can run it
+ *          unchanged
+ */
+
+#include "pt_sched.h"
+
+PT_THREAD(Blinker(Thread_t *t));
+
+#endif // BLINKER_H
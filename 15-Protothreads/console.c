@@ -0,0 +1,219 @@
+/**
+ * @file    console.c
+ * @brief   Console on the UART, using protothreads
+ *
+ * @note    Three threads:
+ *          - Console echoes the chars received and, at the end of a line,
+ *            puts its first char in the command queue
+ *          - Command gets the commands from the queue and answers them
+ *          - Buttons writes the name of each button pressed
+ *
+ * @note    They wait for the UART interrupts (pt_uart.h) and the GPIO
+ *          interrupts (pt_button.h), so they are not run between keystrokes
+ *          or button presses. The output semaphore keeps the echo and the
+ *          buttons out of the middle of an answer.
+ *
+ * @note    Commands: t (ticks), r (thread runs). Anything else prints the help
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "console.h"
+#include "pt_sync.h"
+#include "pt_uart.h"
+#include "pt_button.h"
+
+/// Events (UART_EVENT_RX and UART_EVENT_TX are used by pt_uart.c, BUTTON_EVENT by pt_button.c)
+///@{
+#define EVENT_COMMAND   (2)
+#define EVENT_OUTPUT    (3)
+///@}
+
+/// Commands waiting to be answered
+#define COMMANDQUEUESIZE (4)
+
+/**
+ * @brief   Context of the Console thread
+ */
+typedef struct {
+    char        line[40];
+    unsigned    n;
+    char        ch;
+} Console_t;
+
+/**
+ * @brief   Context of the Command thread
+ */
+typedef struct {
+    char        command;
+    char        answer[60];
+    const char  *next;                  ///< next char of answer to send
+} Command_t;
+
+/**
+ * @brief   Context of the Buttons thread
+ */
+typedef struct {
+    uint32_t    pressed;                ///< buttons not yet written
+    const char  *next;                  ///< next char of the name to send
+} Buttons_t;
+
+static Console_t    console;
+static Command_t    command;
+static Buttons_t    buttons;
+static Semaphore_t  output;
+static Queue_t      commands;
+static char         commandarea[COMMANDQUEUESIZE];
+
+static const char help[] = "Commands: t (ticks), r (thread runs)\r\n";
+
+/**
+ * @brief   Writes label, n in decimal and CRLF into s
+ */
+
+static void
+format(char *s, const char *label, uint32_t n) {
+char digits[12];
+int i = sizeof(digits)-1;
+
+    digits[i] = '\0';
+    do {
+        digits[--i] = '0'+n%10;
+        n /= 10;
+    } while( n );
+    strcpy(s,label);
+    strcat(s,&digits[i]);
+    strcat(s,"\r\n");
+}
+
+void Console_Init(void) {
+
+    PTUart_Init();
+    Sem_Init(&output,1,EVENT_OUTPUT);
+    Queue_Init(&commands,commandarea,sizeof(char),COMMANDQUEUESIZE,EVENT_COMMAND);
+    PTButton_Init(BUTTON0|BUTTON1);
+    Sched_Add(Console,&console);
+    Sched_Add(Command,&command);
+    Sched_Add(Buttons,&buttons);
+}
+
+/*****************************************************************************
+ * @brief  Console thread
+ *
+ * @note   The line is kept in the context, since protothreads do not keep
+ *         local variables
+ */
+
+PT_THREAD(Console(Thread_t *t)) {
+Console_t *c = t->context;
+
+    PT_BEGIN(&t->pt);
+
+    while(1) {
+        THREAD_WAIT_UART_RX(t);
+        c->ch = (char) UART_GetCharNoWait();
+
+        THREAD_SEM_WAIT(t,&output);
+        THREAD_WAIT_UART_TX_SPACE(t,2);
+        if( (c->ch == '\r') || (c->ch == '\n') ) {
+            UART_SendString("\r\n");
+        } else {
+            UART_SendChar(c->ch);
+            if( c->n < sizeof(c->line)-1 )
+                c->line[c->n++] = c->ch;
+        }
+        Sem_Signal(&output);
+
+        if( ((c->ch == '\r') || (c->ch == '\n')) && (c->n > 0) ) {
+            c->line[c->n] = '\0';
+            c->n = 0;
+            THREAD_QUEUE_PUT(t,&commands,&c->line[0]);
+        }
+    }
+
+    (void) PT_YIELD_FLAG; // to silence compiler warning
+
+    PT_END(&t->pt);
+}
+
+/*****************************************************************************
+ * @brief  Command thread
+ *
+ * @note   The answer is built before any wait, since a switch can not have
+ *         a wait inside (see Duff's device in README). Then it is sent as
+ *         space in the output buffer is freed
+ */
+
+PT_THREAD(Command(Thread_t *t)) {
+Command_t *c = t->context;
+unsigned n;
+
+    PT_BEGIN(&t->pt);
+
+    while(1) {
+        THREAD_QUEUE_GET(t,&commands,&c->command);
+
+        switch(c->command) {
+        case 't':
+            format(c->answer,"Ticks: ",Sched_GetTime());
+            break;
+        case 'r':
+            format(c->answer,"Runs: ",Sched_GetRuns());
+            break;
+        default:
+            strcpy(c->answer,help);
+            break;
+        }
+
+        THREAD_SEM_WAIT(t,&output);
+        c->next = c->answer;
+        while( *c->next ) {
+            THREAD_WAIT_UART_TX_SPACE(t,1);
+            for(n=UART_GetTxSpace();(n > 0) && *c->next;n--)
+                UART_SendChar(*c->next++);
+        }
+        Sem_Signal(&output);
+    }
+
+    (void) PT_YIELD_FLAG; // to silence compiler warning
+
+    PT_END(&t->pt);
+}
+
+/*****************************************************************************
+ * @brief  Buttons thread
+ *
+ * @note   Woken by the GPIO interrupts. Only presses are written. When both
+ *         buttons are pressed before it runs, both names are written
+ */
+
+PT_THREAD(Buttons(Thread_t *t)) {
+Buttons_t *b = t->context;
+
+    PT_BEGIN(&t->pt);
+
+    while(1) {
+        THREAD_WAIT_BUTTON_PRESSED(t,b->pressed);
+
+        THREAD_SEM_WAIT(t,&output);
+        while( b->pressed ) {
+            if( b->pressed&BUTTON0 ) {
+                b->next = "Button 0\r\n";
+                b->pressed &= ~BUTTON0;
+            } else {
+                b->next = "Button 1\r\n";
+                b->pressed &= ~BUTTON1;
+            }
+            while( *b->next ) {
+                THREAD_WAIT_UART_TX_SPACE(t,1);
+                UART_SendChar(*b->next++);
+            }
+        }
+        Sem_Signal(&output);
+    }
+
+    (void) PT_YIELD_FLAG; // to silence compiler warning
+
+    PT_END(&t->pt);
+}
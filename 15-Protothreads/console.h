@@ -0,0 +1,22 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+/**
+ * @file    console.h
+ * @brief   Console on the UART, using protothreads
+ */
+
+#include "pt_sched.h"
+
+/**
+ * @brief   Initializes the UART, the buttons, the semaphore and the queue
+ *          used by the console and adds its threads
+ *
+ * @note    Must be called after Sched_Init
+ */
+void Console_Init(void);
+
+PT_THREAD(Console(Thread_t *t));
+PT_THREAD(Command(Thread_t *t));
+PT_THREAD(Buttons(Thread_t *t));
+
+#endif // CONSOLE_H
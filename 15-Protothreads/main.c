@@ -6,8 +6,6 @@
 
 #include <stdint.h>
 
-#include "tt_tasks.h"
-
 /*
  * Including this file, it is possible to define which processor using command line
  * E.g. -DEFM32GG995F1024
@@ -17,55 +15,29 @@
 #include "em_device.h"
 #include "led.h"
 
-#include "pt.h"
+#include "pt_sched.h"
+#include "blinker.h"
+#include "console.h"
+
+#define DIVIDER SCHED_TICK_HZ
+
+/// Uncomment to run the benchmark common to the kernel examples (bench.h)
+//#define BENCHMARK
 
-#define DIVIDER 1000
+#ifdef BENCHMARK
+#include "bench.h"
+#endif
 
 /*****************************************************************************
  * @brief  SysTick interrupt handler
  *
- * @note   Just calls Task_Update
+ * @note   Just counts the tick. The scheduler wakes the threads whose
+ *         timeout expired
  * @note   Called every 1 ms
  */
 
-uint32_t timer_counter = 0;
 void SysTick_Handler(void) {
-    timer_counter++;
-}
-
-/*****************************************************************************
- * @brief  Blinker processing routine
- *
- */
-
-struct pt pt;
-uint32_t threshold;
-
-#define PT_DELAY(T) threshold = timer_counter+(T); PT_WAIT_UNTIL(pt,timer_counter>=threshold);
-
-PT_THREAD(Blinker(struct pt *pt)) {
-
-    PT_BEGIN(pt);
-
-    LED_Write(LED1,LED0);
-
-    while(1) {
-        // Processing
-        LED_Toggle(LED1|LED0);
-        PT_DELAY(1000);
-
-        LED_Toggle(LED1|LED0);
-        PT_DELAY(1000);
-
-//        LED_Write(0,LED0|LED1);
-//        PT_DELAY(1000);
-
-    }
-
-    (void) PT_YIELD_FLAG; // to silence compiler warning
-
-    PT_END(pt);
-
+    Sched_Tick();
 }
 
 /*****************************************************************************
@@ -87,14 +59,23 @@ int main(void) {
     SysTick_Config(SystemCoreClock/DIVIDER);
 
     /* Initialize Protothreads */
-    PT_INIT(&pt);
+    Sched_Init();
+    Console_Init();
+#ifdef BENCHMARK
+    Bench_Start();
+#endif
+    Sched_Add(Blinker,0);
 
     /* Enable Interrupts */
     __enable_irq();
 
-    /* Blink loop */
+    /* Run ready threads and sleep when there is none */
     while (1) {
-        Blinker(&pt);
+        Sched_Dispatch();
+        __disable_irq();
+        if( !Sched_Ready() )
+            __WFI();
+        __enable_irq();
     }
 
 }
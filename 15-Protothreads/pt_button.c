@@ -0,0 +1,22 @@
+/**
+ * @file        pt_button.c
+ * @brief       Binds the GPIO interrupts of the buttons to the protothread scheduler
+ *
+ * @note        The interrupts only post an event (Sched_Post). The state of
+ *              the buttons is read by the threads, in the wait condition.
+ */
+
+#include <stdint.h>
+#include "pt_button.h"
+
+/**
+ * @brief   Callback called by the GPIO interrupt routines
+ */
+
+static void changed(uint32_t buttons) { Sched_Post(1UL<<BUTTON_EVENT); }
+
+void PTButton_Init(uint32_t buttons) {
+
+    Button_Init(buttons);
+    Button_SetCallback(changed);
+}
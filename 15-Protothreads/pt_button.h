@@ -0,0 +1,37 @@
+#ifndef PT_BUTTON_H
+#define PT_BUTTON_H
+/**
+ * @file        pt_button.h
+ * @brief       Waits for the buttons (button.c) in protothreads
+ *
+ * @note        PTButton_Init sets the callback of the GPIO interrupts to post
+ *              BUTTON_EVENT when a button changes. A thread waiting for it is
+ *              not run until a button is pressed or released.
+ *
+ *                  THREAD_WAIT_BUTTON_PRESSED(t,ctx->pressed);
+ *                  if( ctx->pressed&BUTTON0 )
+ *                      ...
+ *
+ * @note        Event BUTTON_EVENT must not be used for anything else
+ */
+
+#include "pt_sched.h"
+#include "button.h"
+
+/// Event posted by the GPIO interrupts
+#define BUTTON_EVENT    (4)
+
+/**
+ * @brief   Waits until a button is pressed. The buttons pressed are stored
+ *          in V, that must not be a local variable
+ */
+#define THREAD_WAIT_BUTTON_PRESSED(T,V) \
+    THREAD_WAIT_UNTIL((T),BUTTON_EVENT,((V)=Button_ReadPressed())!=0)
+
+/**
+ * @fn      PTButton_Init
+ * @brief   Initializes the buttons and sets the callback that posts the event
+ */
+void PTButton_Init(uint32_t buttons);
+
+#endif // PT_BUTTON_H
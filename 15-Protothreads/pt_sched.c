@@ -0,0 +1,428 @@
+/**
+ * @file        pt_sched.c
+ * @brief       Event driven scheduler for protothreads
+ *
+ * @note        A thread is in at most one list: the ready queue (FIFO) or the
+ *              list of the event it waits for. Threads with a timeout are also
+ *              in a timer heap, a binary heap ordered by wakeup tick, so the
+ *              next timeout is always heap[0]. Adding or removing a timeout
+ *              costs O(log n).
+ *
+ * @note        Interrupt routines only touch two words: Sched_Tick increments
+ *              the tick counter and Sched_Post sets bits of the pending events
+ *              with LDREX/STREX. The lists and the heap are only changed by
+ *              Sched_Dispatch, so they need no locking.
+ *
+ * @note        Sched_Dispatch takes the pending events and moves the threads
+ *              waiting for them to the ready queue, does the same for the
+ *              expired timeouts and runs the first ready thread. The value
+ *              returned by the thread tells what to do with it:
+ *              - PT_WAITING: it goes to the list of its event (if any). If it
+ *                has neither event nor timeout, it is run at the next tick
+ *              - PT_YIELDED: it goes to the end of the ready queue
+ *              - PT_EXITED or PT_ENDED: it is removed
+ *
+ * @note        An event posted while a thread is running its wait condition
+ *              is not lost: the thread is linked to the event list before the
+ *              pending events are taken.
+ *
+ * @note        Tick counts wrap around after 2^32 ticks (about 49 days at
+ *              1 kHz). Timeouts are compared by difference, so they work
+ *              across the wrap around if shorter than 2^31 ticks.
+ */
+
+#include <stdint.h>
+#include "em_device.h"
+#include "pt_sched.h"
+
+/**
+ * @brief   Macros to enhance portability
+ */
+#define LOAD_EXCLUSIVE(A)       __LDREXW((volatile uint32_t *)(A))
+#define STORE_EXCLUSIVE(V,A)    __STREXW((uint32_t)(V),(volatile uint32_t *)(A))
+
+/// Thread flags
+///@{
+#define FLAG_READY      (1)             ///< in ready queue
+#define FLAG_LINKED     (2)             ///< in event list
+#define FLAG_EXPIRED    (4)             ///< timeout expired
+///@}
+
+/**
+ * @brief   Doubly linked list of threads
+ */
+typedef struct {
+    Thread_t    *head;
+    Thread_t    *tail;
+} List_t;
+
+static Thread_t threads[SCHED_N];
+static List_t ready;
+static List_t waiting[SCHED_EVENTS];
+static Thread_t *heap[SCHED_N];
+static int heapn = 0;
+
+static volatile uint32_t ticks = 0;
+static volatile uint32_t pending = 0;
+static uint32_t runs = 0;
+
+/**
+ * @brief   Tells if tick a is before tick b
+ */
+#define BEFORE(A,B) ((int32_t) ((A)-(B)) < 0)
+
+/**
+ * @brief   Appends t to list l
+ */
+
+static void
+list_append(List_t *l, Thread_t *t) {
+
+    t->next = 0;
+    t->prev = l->tail;
+    if( l->tail )
+        l->tail->next = t;
+    else
+        l->head = t;
+    l->tail = t;
+}
+
+/**
+ * @brief   Removes t from list l
+ */
+
+static void
+list_remove(List_t *l, Thread_t *t) {
+
+    if( t->prev )
+        t->prev->next = t->next;
+    else
+        l->head = t->next;
+    if( t->next )
+        t->next->prev = t->prev;
+    else
+        l->tail = t->prev;
+    t->next = t->prev = 0;
+}
+
+/**
+ * @brief   Puts heap element t at position i, moving up while it is before its parent
+ */
+
+static void
+heap_up(int i, Thread_t *t) {
+int p;
+
+    while( i > 0 ) {
+        p = (i-1)/2;
+        if( !BEFORE(t->wakeup,heap[p]->wakeup) )
+            break;
+        heap[i] = heap[p];
+        heap[i]->heap = i;
+        i = p;
+    }
+    heap[i] = t;
+    t->heap = i;
+}
+
+/**
+ * @brief   Puts heap element t at position i, moving down while a child is before it
+ */
+
+static void
+heap_down(int i, Thread_t *t) {
+int c;
+
+    while( (c=2*i+1) < heapn ) {
+        if( (c+1 < heapn) && BEFORE(heap[c+1]->wakeup,heap[c]->wakeup) )
+            c++;
+        if( !BEFORE(heap[c]->wakeup,t->wakeup) )
+            break;
+        heap[i] = heap[c];
+        heap[i]->heap = i;
+        i = c;
+    }
+    heap[i] = t;
+    t->heap = i;
+}
+
+/**
+ * @brief   Inserts t in the timer heap or moves it to its new position
+ */
+
+static void
+heap_insert(Thread_t *t) {
+int i = t->heap;
+
+    if( i < 0 ) {
+        heap_up(heapn++,t);
+    } else if( (i > 0) && BEFORE(t->wakeup,heap[(i-1)/2]->wakeup) ) {
+        heap_up(i,t);
+    } else {
+        heap_down(i,t);
+    }
+}
+
+/**
+ * @brief   Removes t from the timer heap
+ */
+
+static void
+heap_remove(Thread_t *t) {
+Thread_t *last;
+int i = t->heap;
+
+    if( i < 0 )
+        return;
+    t->heap = -1;
+    last = heap[--heapn];
+    if( last == t )
+        return;
+    last->heap = i;
+    heap_insert(last);
+}
+
+/**
+ * @brief   Puts t at the end of the ready queue, if not already there
+ */
+
+static void
+make_ready(Thread_t *t) {
+
+    if( t->flags&FLAG_READY )
+        return;
+    if( t->flags&FLAG_LINKED ) {
+        list_remove(&waiting[t->event],t);
+        t->flags &= ~FLAG_LINKED;
+    }
+    list_append(&ready,t);
+    t->flags |= FLAG_READY;
+}
+
+/**
+ * @brief   Takes pending events and readies the threads waiting for them
+ */
+
+static void
+wake_events(void) {
+uint32_t e;
+int i;
+
+    do {
+        e = LOAD_EXCLUSIVE(&pending);
+    } while( STORE_EXCLUSIVE(0,&pending) );
+
+    while( e ) {
+        i = 31-__CLZ(e);
+        e &= ~(1UL<<i);
+        while( waiting[i].head )
+            make_ready(waiting[i].head);
+    }
+}
+
+/**
+ * @brief   Readies the threads whose timeout expired
+ */
+
+static void
+wake_timeouts(void) {
+uint32_t now = ticks;
+Thread_t *t;
+
+    while( heapn && !BEFORE(now,heap[0]->wakeup) ) {
+        t = heap[0];
+        heap_remove(t);
+        t->flags |= FLAG_EXPIRED;
+        make_ready(t);
+    }
+}
+
+/**
+ * @brief   Runs thread t and puts it where its return value tells
+ */
+
+static void
+run(Thread_t *t) {
+char r;
+
+    runs++;
+    r = t->f(t);
+    if( !t->f )                         // deleted itself
+        return;
+    switch(r) {
+    case PT_WAITING:
+        if( t->event != SCHED_NOEVENT ) {
+            list_append(&waiting[t->event],t);
+            t->flags |= FLAG_LINKED;
+        } else if( t->heap < 0 ) {
+            // Only polling. Run again at next tick
+            t->wakeup = ticks+1;
+            heap_insert(t);
+        }
+        break;
+    case PT_YIELDED:
+        make_ready(t);
+        break;
+    default:
+        Sched_Delete(t);
+        break;
+    }
+}
+
+/**
+ * @details Marks all threads as free
+ */
+
+void Sched_Init(void) {
+int i;
+
+    for(i=0;i<SCHED_N;i++) {
+        threads[i].f = 0;
+        threads[i].heap = -1;
+    }
+    ready.head = ready.tail = 0;
+    for(i=0;i<SCHED_EVENTS;i++)
+        waiting[i].head = waiting[i].tail = 0;
+    heapn = 0;
+    pending = 0;
+}
+
+/**
+ * @details Uses the first free entry
+ */
+
+Thread_t *Sched_Add(char (*f)(Thread_t *), void *ctx) {
+Thread_t *t;
+int i;
+
+    for(i=0;(i<SCHED_N) && threads[i].f;i++) {}
+    if( i == SCHED_N )
+        return 0;
+
+    t = &threads[i];
+    PT_INIT(&t->pt);
+    t->f        = f;
+    t->context  = ctx;
+    t->heap     = -1;
+    t->event    = SCHED_NOEVENT;
+    t->flags    = 0;
+    make_ready(t);
+    return t;
+}
+
+/**
+ * @details Must not be called by interrupt routines
+ */
+
+void Sched_Delete(Thread_t *t) {
+
+    heap_remove(t);
+    if( t->flags&FLAG_READY )
+        list_remove(&ready,t);
+    if( t->flags&FLAG_LINKED )
+        list_remove(&waiting[t->event],t);
+    t->flags = 0;
+    t->f = 0;
+}
+
+/**
+ * @details Only counts. Interrupts wake the processor, and Sched_Dispatch
+ *          finds the expired timeouts
+ */
+
+void Sched_Tick(void) {
+
+    ticks++;
+}
+
+/**
+ * @details Sets the bits with LDREX/STREX, so it can be called by
+ *          interrupts of any priority
+ */
+
+void Sched_Post(uint32_t events) {
+uint32_t v;
+
+    do {
+        v = LOAD_EXCLUSIVE(&pending);
+    } while( STORE_EXCLUSIVE(v|events,&pending) );
+}
+
+/**
+ * @details Events and timeouts are checked before each thread runs, so a
+ *          thread woken by them runs before the threads that yielded
+ */
+
+void Sched_Dispatch(void) {
+Thread_t *t;
+
+    while(1) {
+        if( pending )
+            wake_events();
+        wake_timeouts();
+        t = ready.head;
+        if( !t )
+            break;
+        list_remove(&ready,t);
+        t->flags &= ~FLAG_READY;
+        run(t);
+    }
+}
+
+int Sched_Ready(void) {
+
+    return ready.head || pending || (heapn && !BEFORE(ticks,heap[0]->wakeup));
+}
+
+uint32_t Sched_GetTime(void) {
+
+    return ticks;
+}
+
+uint32_t Sched_GetRuns(void) {
+
+    return runs;
+}
+
+/**
+ * @details Sets timeout for ticks ticks from now
+ */
+
+void Sched_Timeout(Thread_t *t, uint32_t n) {
+
+    Sched_TimeoutAt(t,ticks+n);
+}
+
+/**
+ * @details Sets timeout at tick tick. It expires at once if it is not in the future
+ */
+
+void Sched_TimeoutAt(Thread_t *t, uint32_t tick) {
+
+    t->wakeup = tick;
+    t->flags &= ~FLAG_EXPIRED;
+    heap_insert(t);
+}
+
+/**
+ * @details Removes the timeout, keeping the expired flag
+ */
+
+void Sched_Cancel(Thread_t *t) {
+
+    heap_remove(t);
+}
+
+int Sched_Expired(Thread_t *t) {
+
+    return (t->flags&FLAG_EXPIRED) != 0;
+}
+
+/**
+ * @details The thread is linked to the event list when it returns PT_WAITING
+ */
+
+void Sched_Wait(Thread_t *t, int event) {
+
+    t->event = ((unsigned) event < SCHED_EVENTS) ? event : SCHED_NOEVENT;
+}
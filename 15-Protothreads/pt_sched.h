@@ -0,0 +1,175 @@
+#ifndef PT_SCHED_H
+#define PT_SCHED_H
+/**
+ * @file        pt_sched.h
+ * @brief       Event driven scheduler for protothreads
+ *
+ * @note        Each thread has its own timeout, kept in a timer heap, and can
+ *              wait for one of 32 events, posted by interrupt routines with
+ *              Sched_Post. A waiting thread is only run again when its timeout
+ *              expires or its event is posted. When no thread is ready, the
+ *              processor can sleep.
+ *
+ * @note        A thread is a protothread function receiving its Thread_t:
+ *
+ *                  PT_THREAD(Echo(Thread_t *t)) {
+ *
+ *                      PT_BEGIN(&t->pt);
+ *                      while(1) {
+ *                          THREAD_WAIT_UNTIL(t,EVENT_RX,rx_count>0);
+ *                          ...
+ *                      }
+ *                      PT_END(&t->pt);
+ *                  }
+ *
+ *              Local variables are not kept between calls. Use the context
+ *              given to Sched_Add for per-thread data.
+ *
+ * @note        A thread waiting with PT_WAIT_UNTIL (no event and no timeout)
+ *              is run again at the next tick, as when polled.
+ */
+
+#include <stdint.h>
+#include "pt.h"
+
+/// Maximum number of threads
+#ifndef SCHED_N
+#define SCHED_N     (256)
+#endif
+
+/// Tick frequency (Hz)
+#ifndef SCHED_TICK_HZ
+#define SCHED_TICK_HZ (1000)
+#endif
+
+/// Number of events. Event e is bit e in Sched_Post
+#define SCHED_EVENTS    (32)
+
+/// No event to wait for
+#define SCHED_NOEVENT   (-1)
+
+/**
+ * @typedef Thread_t
+ * @brief   Thread control block
+ *
+ * @note    Only pt and context should be used by the thread
+ */
+typedef struct Thread_s Thread_t;
+
+struct Thread_s {
+    struct pt   pt;                     ///< protothread state
+    char        (*f)(Thread_t *);       ///< thread function. 0 when free
+    void        *context;               ///< given to Sched_Add
+    Thread_t    *next;                  ///< in ready queue or event list
+    Thread_t    *prev;
+    uint32_t    wakeup;                 ///< tick of timeout
+    int16_t     heap;                   ///< position in timer heap. -1 if none
+    int8_t      event;                  ///< event waited. SCHED_NOEVENT if none
+    uint8_t     flags;                  ///< internal
+};
+
+/**
+ * @brief   Waits for ticks ticks
+ */
+#define THREAD_DELAY(T,TICKS) \
+    do { Sched_Timeout((T),(TICKS)); PT_WAIT_UNTIL(&(T)->pt,Sched_Expired(T)); } while(0)
+
+/**
+ * @brief   Waits until tick TICK. Used for periodic threads without drift
+ */
+#define THREAD_DELAY_UNTIL(T,TICK) \
+    do { Sched_TimeoutAt((T),(TICK)); PT_WAIT_UNTIL(&(T)->pt,Sched_Expired(T)); } while(0)
+
+/**
+ * @brief   Waits until COND is true. COND is only tested when event E is posted
+ */
+#define THREAD_WAIT_UNTIL(T,E,COND) \
+    do { Sched_Wait((T),(E)); PT_WAIT_UNTIL(&(T)->pt,(COND)); \
+         Sched_Wait((T),SCHED_NOEVENT); } while(0)
+
+/**
+ * @brief   As THREAD_WAIT_UNTIL, but gives up after TICKS ticks.
+ *          Sched_Expired(T) tells which one happened
+ */
+#define THREAD_WAIT_UNTIL_TIMEOUT(T,E,COND,TICKS) \
+    do { Sched_Timeout((T),(TICKS)); Sched_Wait((T),(E)); \
+         PT_WAIT_UNTIL(&(T)->pt,(COND)||Sched_Expired(T)); \
+         Sched_Wait((T),SCHED_NOEVENT); Sched_Cancel(T); } while(0)
+
+/**
+ * @fn      Sched_Init
+ * @brief   Initializes the thread table.
+ *          Can be omitted when BSS section is initialized to zeroes
+ */
+void Sched_Init(void);
+
+/**
+ * @fn      Sched_Add
+ * @brief   Adds a thread. It is ready to run
+ *
+ * @param   f          thread function
+ * @param   ctx        context, as t->context
+ * @return  thread. 0 if there is no more space
+ */
+Thread_t *Sched_Add(char (*f)(Thread_t *), void *ctx);
+
+/**
+ * @fn      Sched_Delete
+ * @brief   Removes a thread. A thread can also end with PT_EXIT or PT_END
+ */
+void Sched_Delete(Thread_t *t);
+
+/**
+ * @fn      Sched_Tick
+ * @brief   Counts a tick. Must be called by the timer interrupt routine
+ */
+void Sched_Tick(void);
+
+/**
+ * @fn      Sched_Post
+ * @brief   Posts events (bit e is event e). Can be called by interrupt routines
+ *
+ * @note    Threads waiting for an event are woken in Sched_Dispatch. If no
+ *          thread is waiting, the event is lost
+ */
+void Sched_Post(uint32_t events);
+
+/**
+ * @fn      Sched_Dispatch
+ * @brief   Runs ready threads until none is ready
+ */
+void Sched_Dispatch(void);
+
+/**
+ * @fn      Sched_Ready
+ * @brief   Tells if Sched_Dispatch has something to do. If not, the processor
+ *          can sleep until an interrupt. Call it with interrupts disabled
+ *
+ * @return  not 0 when a thread is ready, an event is pending or a timeout expired
+ */
+int Sched_Ready(void);
+
+/**
+ * @fn      Sched_GetTime
+ * @brief   Returns the number of ticks since start
+ */
+uint32_t Sched_GetTime(void);
+
+/**
+ * @fn      Sched_GetRuns
+ * @brief   Returns the number of thread runs since start
+ */
+uint32_t Sched_GetRuns(void);
+
+/**
+ * @brief   Used by the THREAD_ macros
+ */
+///@{
+void Sched_Timeout(Thread_t *t, uint32_t ticks);
+void Sched_TimeoutAt(Thread_t *t, uint32_t tick);
+void Sched_Cancel(Thread_t *t);
+int  Sched_Expired(Thread_t *t);
+void Sched_Wait(Thread_t *t, int event);
+///@}
+
+#endif // PT_SCHED_H
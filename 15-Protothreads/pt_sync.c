@@ -0,0 +1,99 @@
+/**
+ * @file        pt_sync.c
+ * @brief       Semaphores and message queues for the protothread scheduler
+ *
+ * @note        The wait condition of the macros in pt_sync.h is the call that
+ *              takes the semaphore or moves the item. So a thread is never
+ *              woken to find that another one took what it waited for: it just
+ *              goes back to the list of the event.
+ *
+ * @note        Threads waiting to put and to get share the event of a queue.
+ *              Both are woken when it changes and test their condition again.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "em_device.h"
+#include "pt_sync.h"
+
+/**
+ * @brief   Macros to enhance portability
+ */
+#define LOAD_EXCLUSIVE(A)       __LDREXW((volatile uint32_t *)(A))
+#define STORE_EXCLUSIVE(V,A)    __STREXW((uint32_t)(V),(volatile uint32_t *)(A))
+
+void Sem_Init(Semaphore_t *s, uint32_t n, int event) {
+
+    s->count = n;
+    s->event = event;
+}
+
+/**
+ * @details Increments with LDREX/STREX, so it can be called by interrupts
+ */
+
+void Sem_Signal(Semaphore_t *s) {
+uint32_t v;
+
+    do {
+        v = LOAD_EXCLUSIVE(&s->count);
+    } while( STORE_EXCLUSIVE(v+1,&s->count) );
+    Sched_Post(1UL<<s->event);
+}
+
+int Sem_TryWait(Semaphore_t *s) {
+uint32_t v;
+
+    do {
+        v = LOAD_EXCLUSIVE(&s->count);
+        if( v == 0 ) {
+            __CLREX();
+            return 0;
+        }
+    } while( STORE_EXCLUSIVE(v-1,&s->count) );
+    return 1;
+}
+
+void Queue_Init(Queue_t *q, void *area, unsigned itemsize, unsigned capacity, int event) {
+
+    q->area     = area;
+    q->itemsize = itemsize;
+    q->capacity = capacity;
+    q->count    = 0;
+    q->front    = 0;
+    q->event    = event;
+}
+
+/**
+ * @details Wakes the threads waiting for an item
+ */
+
+int Queue_Put(Queue_t *q, const void *item) {
+unsigned rear;
+
+    if( q->count == q->capacity )
+        return -1;
+    rear = q->front+q->count;
+    if( rear >= q->capacity )
+        rear -= q->capacity;
+    memcpy(q->area+rear*q->itemsize,item,q->itemsize);
+    q->count++;
+    Sched_Post(1UL<<q->event);
+    return 0;
+}
+
+/**
+ * @details Wakes the threads waiting for space
+ */
+
+int Queue_Get(Queue_t *q, void *item) {
+
+    if( q->count == 0 )
+        return -1;
+    memcpy(item,q->area+q->front*q->itemsize,q->itemsize);
+    if( ++q->front == q->capacity )
+        q->front = 0;
+    q->count--;
+    Sched_Post(1UL<<q->event);
+    return 0;
+}
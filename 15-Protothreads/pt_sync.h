@@ -0,0 +1,123 @@
+#ifndef PT_SYNC_H
+#define PT_SYNC_H
+/**
+ * @file        pt_sync.h
+ * @brief       Semaphores and message queues for the protothread scheduler
+ *
+ * @note        Each object has an event of the scheduler (see pt_sched.h).
+ *              A thread waiting on it is linked to the list of the event and
+ *              is only run again when the object changes, not at every tick.
+ *
+ *                  static Semaphore_t lock;
+ *                  static Queue_t     commands;
+ *                  static char        commandarea[8];
+ *                  ...
+ *                  Sem_Init(&lock,1,EVENT_LOCK);
+ *                  Queue_Init(&commands,commandarea,sizeof(char),8,EVENT_COMMAND);
+ *                  ...
+ *                  THREAD_SEM_WAIT(t,&lock);
+ *                  ...
+ *                  Sem_Signal(&lock);
+ *                  ...
+ *                  THREAD_QUEUE_GET(t,&commands,&ctx->command);
+ *
+ * @note        The item given to THREAD_QUEUE_PUT and THREAD_QUEUE_GET must not
+ *              be a local variable (protothreads do not keep them). Use the
+ *              context of the thread.
+ *
+ * @note        Sem_Signal can be called by interrupt routines. Queues can only
+ *              be used by threads.
+ */
+
+#include <stdint.h>
+#include "pt_sched.h"
+
+/**
+ * @brief   Counting semaphore
+ */
+typedef struct {
+    volatile uint32_t   count;
+    int8_t              event;          ///< posted when signaled
+} Semaphore_t;
+
+/**
+ * @brief   Bounded queue of fixed size items
+ *
+ * @note    The items are copied into area, given by the user
+ */
+typedef struct {
+    uint8_t     *area;
+    uint16_t    itemsize;               ///< bytes
+    uint16_t    capacity;               ///< items
+    uint16_t    count;
+    uint16_t    front;                  ///< next item to get
+    int8_t      event;                  ///< posted when an item is put or got
+} Queue_t;
+
+/**
+ * @brief   Waits for semaphore S and takes it
+ */
+#define THREAD_SEM_WAIT(T,S) \
+    THREAD_WAIT_UNTIL((T),(S)->event,Sem_TryWait(S))
+
+/**
+ * @brief   Puts the item pointed by P in queue Q, waiting for space
+ */
+#define THREAD_QUEUE_PUT(T,Q,P) \
+    THREAD_WAIT_UNTIL((T),(Q)->event,Queue_Put((Q),(P))==0)
+
+/**
+ * @brief   Gets an item from queue Q into P, waiting for one
+ */
+#define THREAD_QUEUE_GET(T,Q,P) \
+    THREAD_WAIT_UNTIL((T),(Q)->event,Queue_Get((Q),(P))==0)
+
+/**
+ * @fn      Sem_Init
+ * @brief   Initializes semaphore with count n
+ */
+void Sem_Init(Semaphore_t *s, uint32_t n, int event);
+
+/**
+ * @fn      Sem_Signal
+ * @brief   Increments count and wakes waiting threads.
+ *          Can be called by interrupt routines
+ */
+void Sem_Signal(Semaphore_t *s);
+
+/**
+ * @fn      Sem_TryWait
+ * @brief   Decrements count if not zero
+ *
+ * @return  not 0 when it was decremented
+ */
+int Sem_TryWait(Semaphore_t *s);
+
+/**
+ * @fn      Queue_Init
+ * @brief   Initializes an empty queue using area for capacity items of itemsize bytes
+ */
+void Queue_Init(Queue_t *q, void *area, unsigned itemsize, unsigned capacity, int event);
+
+/**
+ * @fn      Queue_Put
+ * @brief   Copies the item to the end of the queue
+ *
+ * @return  0 if OK, -1 if full
+ */
+int Queue_Put(Queue_t *q, const void *item);
+
+/**
+ * @fn      Queue_Get
+ * @brief   Copies the first item of the queue and removes it
+ *
+ * @return  0 if OK, -1 if empty
+ */
+int Queue_Get(Queue_t *q, void *item);
+
+/**
+ * @brief   Number of items in the queue
+ */
+#define Queue_Count(Q)  ((Q)->count)
+
+#endif // PT_SYNC_H
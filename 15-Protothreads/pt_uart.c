@@ -0,0 +1,25 @@
+/**
+ * @file        pt_uart.c
+ * @brief       Binds the UART interrupts to the protothread scheduler
+ *
+ * @note        The interrupts only post an event (Sched_Post). The buffers are
+ *              read by the threads, in the wait condition.
+ */
+
+#include <stdint.h>
+#include "pt_uart.h"
+
+/**
+ * @brief   Callbacks called by the UART interrupt routines
+ */
+///@{
+static void received(void)      { Sched_Post(1UL<<UART_EVENT_RX); }
+static void transmitted(void)   { Sched_Post(1UL<<UART_EVENT_TX); }
+///@}
+
+void PTUart_Init(void) {
+
+    UART_Init();
+    UART_SetRxCallback(received);
+    UART_SetTxCallback(transmitted);
+}
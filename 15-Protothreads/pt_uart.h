@@ -0,0 +1,48 @@
+#ifndef PT_UART_H
+#define PT_UART_H
+/**
+ * @file        pt_uart.h
+ * @brief       Waits for the UART buffers (uart.c) in protothreads
+ *
+ * @note        PTUart_Init sets the callbacks of the UART interrupts to post
+ *              UART_EVENT_RX when a char is received and UART_EVENT_TX when a
+ *              char leaves the output buffer. A thread waiting for them is not
+ *              run between keystrokes.
+ *
+ *                  THREAD_WAIT_UART_RX(t);
+ *                  ch = UART_GetCharNoWait();
+ *                  THREAD_WAIT_UART_TX_SPACE(t,1);
+ *                  UART_SendChar(ch);
+ *
+ * @note        Events UART_EVENT_RX and UART_EVENT_TX must not be used for
+ *              anything else
+ */
+
+#include "pt_sched.h"
+#include "uart.h"
+
+/// Events posted by the UART interrupts
+///@{
+#define UART_EVENT_RX   (0)
+#define UART_EVENT_TX   (1)
+///@}
+
+/**
+ * @brief   Waits until there is a char in the input buffer
+ */
+#define THREAD_WAIT_UART_RX(T) \
+    THREAD_WAIT_UNTIL((T),UART_EVENT_RX,UART_GetRxCount()>0)
+
+/**
+ * @brief   Waits until there is space for N chars in the output buffer
+ */
+#define THREAD_WAIT_UART_TX_SPACE(T,N) \
+    THREAD_WAIT_UNTIL((T),UART_EVENT_TX,UART_GetTxSpace()>=(unsigned) (N))
+
+/**
+ * @fn      PTUart_Init
+ * @brief   Initializes the UART and sets the callbacks that post the events
+ */
+void PTUart_Init(void);
+
+#endif // PT_UART_H
@@ -0,0 +1,38 @@
+#ifndef EFM32GG990F1024_H
+#define EFM32GG990F1024_H
+/**
+ * @file    efm32gg990f1024.h
+ * @brief   Host replacement of the device header for the simulator
+ *
+ * @note    em_device.h includes this file instead of the one in the Gecko SDK,
+ *          because the sim folder is first in the include path
+ *
+ * @note    Only the CMSIS intrinsics used by the scheduler are provided.
+ *          Interrupts are simulated (systick_sim.c): enabling them runs a
+ *          pending interrupt routine
+ */
+
+#include <stdint.h>
+
+extern uint32_t SystemCoreClock;
+extern uint32_t Sim_PRIMASK;
+
+void Sim_EnableInterrupts(void);
+void Sim_WaitForInterrupt(void);
+
+static inline uint32_t __get_PRIMASK(void)          { return Sim_PRIMASK; }
+static inline void     __set_PRIMASK(uint32_t m)    { Sim_PRIMASK = m; if( !m ) Sim_EnableInterrupts(); }
+static inline void     __disable_irq(void)          { Sim_PRIMASK = 1; }
+static inline void     __enable_irq(void)           { __set_PRIMASK(0); }
+
+static inline uint32_t __LDREXW(volatile uint32_t *a)               { return *a; }
+static inline uint32_t __STREXW(uint32_t v, volatile uint32_t *a)   { *a = v; return 0; }
+static inline void     __CLREX(void)                                { }
+static inline uint32_t __CLZ(uint32_t x)                            { return x ? __builtin_clz(x) : 32; }
+
+static inline void     __DSB(void)                  { }
+static inline void     __WFI(void)                  { Sim_WaitForInterrupt(); }
+
+uint32_t SysTick_Config(uint32_t ticks);
+
+#endif // EFM32GG990F1024_H
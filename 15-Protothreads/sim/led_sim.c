@@ -0,0 +1,35 @@
+/**
+ * @file    led_sim.c
+ * @brief   Simulated LEDs
+ *
+ * @note    Keeps the state of the LEDs and counts the changes of each one
+ */
+
+#include <stdint.h>
+#include "led.h"
+#include "led_sim.h"
+
+uint32_t Sim_LEDs = 0;
+uint32_t Sim_LEDChanges[32];
+
+/**
+ * @brief   Sets new state, counting the LEDs that changed
+ */
+
+static void
+set(uint32_t v) {
+uint32_t changed = v^Sim_LEDs;
+int i;
+
+    for(i=0;i<32;i++) {
+        if( changed&BIT(i) )
+            Sim_LEDChanges[i]++;
+    }
+    Sim_LEDs = v;
+}
+
+void LED_Init(uint32_t leds)                { set(Sim_LEDs&~leds); }
+void LED_On(uint32_t leds)                  { set(Sim_LEDs|leds); }
+void LED_Off(uint32_t leds)                 { set(Sim_LEDs&~leds); }
+void LED_Toggle(uint32_t leds)              { set(Sim_LEDs^leds); }
+void LED_Write(uint32_t off, uint32_t on)   { set((Sim_LEDs&~off)|on); }
@@ -0,0 +1,16 @@
+#ifndef LED_SIM_H
+#define LED_SIM_H
+/**
+ * @file    led_sim.h
+ * @brief   Simulated LEDs
+ */
+
+#include <stdint.h>
+
+/// Current state of the LEDs (bits as in led.h)
+extern uint32_t Sim_LEDs;
+
+/// Number of changes of each LED (index is the bit number)
+extern uint32_t Sim_LEDChanges[32];
+
+#endif // LED_SIM_H
@@ -0,0 +1,273 @@
+/**
+ * @file    ptsim.c
+ * @brief   Virtual time simulation of the protothread scheduler
+ *
+ * @note    Runs the same pt_sched.c and blinker.c of the board with a
+ *          simulated SysTick (systick_sim.c) and LEDs (led_sim.c). The main
+ *          loop is the one of main.c, so the processor sleeps in WFI when no
+ *          thread is ready. Besides Blinker, there are
+ *          - n periodic threads, with periods from 10 to 100 ticks
+ *          - m threads woken by a simulated receive interrupt, happening
+ *            at random ticks, rate times per second on average
+ *
+ * @note    Each run of a thread costs the scheduler overhead (-c cycles) and
+ *          each job the execution time (-e us). Release, start and end of all
+ *          jobs are recorded (trace.c), one row for the periodic threads and
+ *          one for the event threads.
+ *
+ * @note    Usage: ptsim [-t seconds] [-o file] [-j jitter] [-n threads] [-m threads]
+ *                       [-r rate] [-e us] [-c cycles] [-i cycles]
+ *
+ *          -t  simulated time (default 10 s)
+ *          -o  trace file (.json for Chrome trace, otherwise CSV)
+ *          -j  maximum jitter (variation of latency) accepted, in us
+ *          -n  number of periodic threads (default 100)
+ *          -m  number of event threads (default 8)
+ *          -r  receive interrupts per second (default 100)
+ *          -e  execution time of a job, in us (default 5)
+ *          -c  cycles of the scheduler for each thread run (default 200)
+ *          -i  cycles of each tick interrupt (default 100)
+ *
+ * @note    The result is FAIL (exit code 1) when a job ends after the next
+ *          release of its thread, has more jitter than accepted, when a tick
+ *          is lost or when the LEDs do not blink at the expected rate
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "em_device.h"
+
+#include "pt_sched.h"
+#include "blinker.h"
+#include "led.h"
+#include "led_sim.h"
+#include "systick_sim.h"
+#include "trace.h"
+
+/// Event posted by the simulated receive interrupt
+#define EVENT_RX        (0)
+
+/// Rows in the trace
+///@{
+#define ROW_PERIODIC    (0)
+#define ROW_EVENT       (1)
+///@}
+
+/**
+ * @brief   Context of a periodic thread
+ */
+typedef struct {
+    uint32_t    period;                 ///< ticks
+    uint32_t    next;                   ///< tick of next release
+} Periodic_t;
+
+static Periodic_t periodic[SCHED_N];
+
+static uint32_t overhead = 200;         ///< cycles for each thread run
+static uint64_t exec = 5;               ///< us for each job
+static uint32_t rate = 100;             ///< receive interrupts per second
+static uint64_t late = 0;               ///< jobs ending after next release
+static uint64_t end;                    ///< end of simulation (cycles)
+
+static volatile uint32_t rxcount = 0;
+static uint64_t rxtime = 0;
+
+/**
+ * @brief   Tick interrupt. Also simulates the receive interrupt
+ */
+
+void SysTick_Handler(void) {
+
+    Sched_Tick();
+    if( (Sim_Random()%SCHED_TICK_HZ) < rate ) {
+        rxcount++;
+        rxtime = Sim_Cycles;
+        Sched_Post(1UL<<EVENT_RX);
+    }
+}
+
+/**
+ * @brief   Executes a job released at release. Returns the end
+ */
+
+static uint64_t
+job(int row, uint64_t release) {
+
+    Trace_Release(row,release);
+    Trace_Start(row,Sim_Cycles);
+    if( Sim_Cycles < end )
+        Sim_Run(exec*(SystemCoreClock/1000000));
+    Trace_End(row,Sim_Cycles);
+    return Sim_Cycles;
+}
+
+/**
+ * @brief   Blinker of the board, with the scheduler overhead
+ */
+
+static
+PT_THREAD(blinker(Thread_t *t)) {
+
+    Sim_Run(overhead);
+    return Blinker(t);
+}
+
+/**
+ * @brief   Periodic thread
+ */
+
+static
+PT_THREAD(periodicthread(Thread_t *t)) {
+Periodic_t *p = t->context;
+uint64_t tickcycles = SystemCoreClock/SCHED_TICK_HZ;
+
+    Sim_Run(overhead);
+
+    PT_BEGIN(&t->pt);
+
+    while(1) {
+        THREAD_DELAY_UNTIL(t,p->next);
+        if( job(ROW_PERIODIC,p->next*tickcycles) > (p->next+p->period)*tickcycles )
+            late++;
+        p->next += p->period;
+    }
+
+    (void) PT_YIELD_FLAG; // to silence compiler warning
+
+    PT_END(&t->pt);
+}
+
+/**
+ * @brief   Thread woken by the receive interrupt. The context keeps the
+ *          last count seen
+ */
+
+static
+PT_THREAD(eventthread(Thread_t *t)) {
+uint32_t *seen = t->context;
+
+    Sim_Run(overhead);
+
+    PT_BEGIN(&t->pt);
+
+    while(1) {
+        THREAD_WAIT_UNTIL(t,EVENT_RX,rxcount != *seen);
+        *seen = rxcount;
+        job(ROW_EVENT,rxtime);
+    }
+
+    (void) PT_YIELD_FLAG; // to silence compiler warning
+
+    PT_END(&t->pt);
+}
+
+int main(int argc, char *argv[]) {
+static uint32_t seen[SCHED_N];
+uint64_t seconds = 10;
+uint64_t jitter,maxjitter = UINT64_MAX;
+uint32_t nperiodic = 100, nevent = 8;
+uint32_t expected;
+const char *output = 0;
+const TraceStats_t *st;
+double cyclesperus;
+int opt,k,errors = 0;
+
+    while( (opt=getopt(argc,argv,"t:o:j:n:m:r:e:c:i:")) != -1 ) {
+        switch(opt) {
+        case 't': seconds = strtoull(optarg,0,10);                      break;
+        case 'o': output = optarg;                                      break;
+        case 'j': maxjitter = strtoull(optarg,0,10);                    break;
+        case 'n': nperiodic = strtoul(optarg,0,10);                     break;
+        case 'm': nevent = strtoul(optarg,0,10);                        break;
+        case 'r': rate = strtoul(optarg,0,10);                          break;
+        case 'e': exec = strtoull(optarg,0,10);                         break;
+        case 'c': overhead = strtoul(optarg,0,10);                      break;
+        case 'i': Sim_TickCycles = strtoul(optarg,0,10);                break;
+        default:
+            fprintf(stderr,"Usage: %s [-t seconds] [-o file] [-j jitter] [-n threads] [-m threads] "
+                           "[-r rate] [-e us] [-c cycles] [-i cycles]\n",argv[0]);
+            return 1;
+        }
+    }
+    if( nperiodic+nevent+1 > SCHED_N ) {
+        fprintf(stderr,"At most %d threads\n",SCHED_N);
+        return 1;
+    }
+    if( Sim_TickCycles == 0 )
+        Sim_TickCycles = 100;
+    cyclesperus = SystemCoreClock/1e6;
+    if( maxjitter != UINT64_MAX )
+        maxjitter = (uint64_t) (maxjitter*cyclesperus);
+
+    if( Trace_Open(output,SystemCoreClock) ) {
+        fprintf(stderr,"Cannot create %s\n",output);
+        return 1;
+    }
+    Trace_Task(ROW_PERIODIC,"Periodic");
+    Trace_Task(ROW_EVENT,"Event");
+
+    /* As main.c */
+    LED_Init(LED0|LED1);
+    SysTick_Config(SystemCoreClock/SCHED_TICK_HZ);
+    Sched_Init();
+    Sched_Add(blinker,0);
+    for(k=0;k<(int) nperiodic;k++) {
+        periodic[k].period = 10*(1+k%10);
+        periodic[k].next   = 1+k%periodic[k].period;
+        Sched_Add(periodicthread,&periodic[k]);
+    }
+    for(k=0;k<(int) nevent;k++)
+        Sched_Add(eventthread,&seen[k]);
+    __enable_irq();
+
+    end = seconds*SystemCoreClock;
+    while( Sim_Cycles < end ) {
+        Sched_Dispatch();
+        __disable_irq();
+        if( !Sched_Ready() )
+            __WFI();
+        __enable_irq();
+    }
+    __disable_irq();
+
+    if( Trace_Close() ) {
+        fprintf(stderr,"Error writing %s\n",output);
+        errors++;
+    }
+
+    printf("Simulated %llu s, %u ticks, %u threads, %u runs\n",(unsigned long long) seconds,
+            Sched_GetTime(),nperiodic+nevent+1,Sched_GetRuns());
+    printf("CPU load %.3f %%\n",100.0*(Sim_Cycles-Sim_IdleCycles)/Sim_Cycles);
+    printf("Threads            Jobs  Lat min  Lat max   Jitter  Resp max\n");
+    for(k=ROW_PERIODIC;k<=ROW_EVENT;k++) {
+        st = Trace_GetStats(k);
+        jitter = st->maxlatency-st->minlatency;
+        printf("%-12s %10llu %8.1f %8.1f %8.1f %9.1f\n",Trace_GetName(k),
+                (unsigned long long) st->jobs,
+                st->minlatency/cyclesperus,st->maxlatency/cyclesperus,jitter/cyclesperus,
+                st->maxresponse/cyclesperus);
+        if( st->jobs && (jitter > maxjitter) )
+            errors++;
+    }
+    if( late ) {
+        printf("%llu jobs late\n",(unsigned long long) late);
+        errors++;
+    }
+    if( Sim_LostTicks ) {
+        printf("%u ticks lost\n",Sim_LostTicks);
+        errors++;
+    }
+
+    /* Blinker switches LED0 on and then toggles both LEDs every 1000 ticks */
+    expected = Sched_GetTime()?(Sched_GetTime()-1)/1000+1:1;
+    printf("LED0 changes %u, LED1 changes %u (expected %u and %u)\n",
+            Sim_LEDChanges[2],Sim_LEDChanges[3],expected+1,expected);
+    if( (Sim_LEDChanges[2] != expected+1) || (Sim_LEDChanges[3] != expected) )
+        errors++;
+
+    printf("%s\n",errors?"FAIL":"PASS");
+    return errors != 0;
+}
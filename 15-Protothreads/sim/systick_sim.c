@@ -0,0 +1,125 @@
+/**
+ * @file    systick_sim.c
+ * @brief   Simulated SysTick in virtual time
+ *
+ * @note    SysTick fires every reload cycles. When it fires, the interrupt is
+ *          set pending and runs as soon as interrupts are enabled. A tick that
+ *          happens while the previous one is still pending is lost, as in
+ *          the hardware.
+ *
+ * @note    The time spent waiting in WFI is counted, to give the load of
+ *          the processor
+ */
+
+#include <stdint.h>
+#include "em_device.h"
+#include "systick_sim.h"
+
+/// Default HFRCO frequency, as used by main.c
+uint32_t SystemCoreClock = 14000000;
+uint32_t Sim_PRIMASK = 1;
+
+uint64_t Sim_Cycles = 0;
+uint64_t Sim_IdleCycles = 0;
+uint32_t Sim_TickCycles = 0;
+uint32_t Sim_LostTicks = 0;
+
+void SysTick_Handler(void);
+
+static uint64_t reload = 0;             ///< 0 when SysTick is not running
+static uint64_t nexttick = 0;
+static int tickpending = 0;
+static int inhandler = 0;
+
+/**
+ * @brief   Linear congruential generator
+ */
+
+uint32_t Sim_Random(void) {
+static uint32_t seed = 1;
+
+    seed = seed*1664525u + 1013904223u;
+    return seed>>8;
+}
+
+/**
+ * @brief   Sets SysTick pending for each period elapsed
+ */
+
+static void
+count(void) {
+
+    while( reload && (Sim_Cycles >= nexttick) ) {
+        if( tickpending )
+            Sim_LostTicks++;
+        tickpending = 1;
+        nexttick += reload;
+    }
+}
+
+/**
+ * @brief   Runs the pending interrupt, if allowed
+ */
+
+static void
+service(void) {
+
+    while( !Sim_PRIMASK && tickpending && !inhandler ) {
+        tickpending = 0;
+        inhandler = 1;
+        SysTick_Handler();
+        Sim_Cycles += Sim_TickCycles;
+        count();
+        inhandler = 0;
+    }
+}
+
+void Sim_EnableInterrupts(void) {
+
+    service();
+}
+
+/**
+ * @brief   Called with interrupts disabled. Advances time to the next tick
+ *          when nothing is pending
+ */
+
+void Sim_WaitForInterrupt(void) {
+
+    if( tickpending || !reload )
+        return;
+    Sim_IdleCycles += nexttick-Sim_Cycles;
+    Sim_Cycles = nexttick;
+    count();
+}
+
+/**
+ * @brief   Executes code taking n cycles. Interrupts happening meanwhile
+ *          run at their time and delay the code
+ */
+
+void Sim_Run(uint64_t n) {
+uint64_t d;
+
+    while( n ) {
+        d = n;
+        if( reload && (nexttick-Sim_Cycles < d) )
+            d = nexttick-Sim_Cycles;
+        Sim_Cycles += d;
+        count();
+        n -= d;
+        service();
+    }
+}
+
+/**
+ * @brief   Starts SysTick with a period of ticks cycles
+ */
+
+uint32_t SysTick_Config(uint32_t ticks) {
+
+    reload      = ticks;
+    nexttick    = Sim_Cycles+ticks;
+    tickpending = 0;
+    return 0;
+}
@@ -0,0 +1,31 @@
+#ifndef SYSTICK_SIM_H
+#define SYSTICK_SIM_H
+/**
+ * @file    systick_sim.h
+ * @brief   Simulated SysTick in virtual time
+ *
+ * @note    Simulated time is kept in core clock cycles. It only advances when
+ *          Sim_Run is called (code being executed) or the processor waits for
+ *          an interrupt. So a simulation of hours takes milliseconds.
+ *
+ * @note    SysTick_Handler must be defined by the simulation
+ */
+
+#include <stdint.h>
+
+/// Simulated time (cycles since start)
+extern uint64_t Sim_Cycles;
+
+/// Cycles spent sleeping in WFI
+extern uint64_t Sim_IdleCycles;
+
+/// Cycles used by each SysTick interrupt (entry, handler and exit)
+extern uint32_t Sim_TickCycles;
+
+/// Ticks lost, because the previous SysTick interrupt was still pending
+extern uint32_t Sim_LostTicks;
+
+void Sim_Run(uint64_t cycles);
+uint32_t Sim_Random(void);
+
+#endif // SYSTICK_SIM_H
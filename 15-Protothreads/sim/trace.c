@@ -0,0 +1,186 @@
+/**
+ * @file    trace.c
+ * @brief   Records release, start and end of the jobs of each task
+ *
+ * @note    Releases are queued for each task. A start takes the oldest one
+ *          and an end completes the job, which is written to the file and
+ *          added to the statistics. A job misses its deadline when it ends
+ *          after the next release of the same task.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "trace.h"
+
+/**
+ * @brief   Information about a task
+ */
+typedef struct {
+    const char  *name;
+    uint64_t    pending[TRACE_PENDING]; ///< releases not yet started
+    int         first;                  ///< oldest release in pending
+    int         n;                      ///< number of releases in pending
+    int         running;                ///< job started and not ended
+    uint64_t    release;                ///< release of running job
+    uint64_t    start;                  ///< start of running job
+    TraceStats_t stats;
+} TraceTask_t;
+
+static TraceTask_t tasks[TRACE_TASKS];
+static FILE *file = 0;
+static int json = 0;
+static int events = 0;
+static double cyclesperus = 1.0;
+
+/**
+ * @brief   Writes the separator between events of a Chrome trace
+ */
+
+static void
+separator(void) {
+
+    fputs(events++?",\n":"[\n",file);
+}
+
+/**
+ * @details hz is the clock used for times. filename can be 0 (only statistics)
+ */
+
+int Trace_Open(const char *filename, uint32_t hz) {
+size_t n;
+
+    memset(tasks,0,sizeof(tasks));
+    cyclesperus = hz/1e6;
+    events = 0;
+    if( !filename )
+        return 0;
+    file = fopen(filename,"w");
+    if( !file )
+        return -1;
+    n = strlen(filename);
+    json = (n >= 5) && (strcmp(filename+n-5,".json") == 0);
+    if( !json )
+        fprintf(file,"task,job,release,start,end,latency,response\n");
+    return 0;
+}
+
+/**
+ * @details In a Chrome trace, the task is named by metadata
+ */
+
+void Trace_Task(int k, const char *name) {
+
+    tasks[k].name = name;
+    if( file && json ) {
+        separator();
+        fprintf(file,"{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                     "\"args\":{\"name\":\"%s\"}}",k,name);
+    }
+}
+
+/**
+ * @details When too many releases are pending, the oldest is dropped
+ */
+
+void Trace_Release(int k, uint64_t t) {
+TraceTask_t *p = &tasks[k];
+
+    if( p->n == TRACE_PENDING ) {
+        p->first = (p->first+1)%TRACE_PENDING;
+        p->n--;
+    }
+    p->pending[(p->first+p->n)%TRACE_PENDING] = t;
+    p->n++;
+    p->stats.releases++;
+    if( file && json ) {
+        separator();
+        fprintf(file,"{\"name\":\"release\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}",
+                k,t/cyclesperus);
+    }
+}
+
+/**
+ * @details A start without a pending release is counted as an error
+ */
+
+void Trace_Start(int k, uint64_t t) {
+TraceTask_t *p = &tasks[k];
+uint64_t l;
+
+    if( p->n == 0 ) {
+        p->stats.unreleased++;
+        p->release = t;
+    } else {
+        p->release = p->pending[p->first];
+        p->first = (p->first+1)%TRACE_PENDING;
+        p->n--;
+    }
+    p->start   = t;
+    p->running = 1;
+    l = t-p->release;
+    if( (p->stats.jobs == 0) || (l < p->stats.minlatency) )
+        p->stats.minlatency = l;
+    if( l > p->stats.maxlatency )
+        p->stats.maxlatency = l;
+}
+
+/**
+ * @details Writes the job
+ */
+
+void Trace_End(int k, uint64_t t) {
+TraceTask_t *p = &tasks[k];
+
+    if( !p->running )
+        return;
+    p->running = 0;
+    p->stats.jobs++;
+    if( t-p->release > p->stats.maxresponse )
+        p->stats.maxresponse = t-p->release;
+    if( p->n && (p->pending[p->first] < t) )
+        p->stats.missed++;
+    if( !file )
+        return;
+    if( json ) {
+        separator();
+        fprintf(file,"{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,"
+                     "\"args\":{\"job\":%llu,\"latency\":%.3f}}",
+                p->name,k,p->start/cyclesperus,(t-p->start)/cyclesperus,
+                (unsigned long long) p->stats.jobs,(p->start-p->release)/cyclesperus);
+    } else {
+        fprintf(file,"%s,%llu,%.3f,%.3f,%.3f,%.3f,%.3f\n",p->name,
+                (unsigned long long) p->stats.jobs,p->release/cyclesperus,
+                p->start/cyclesperus,t/cyclesperus,
+                (p->start-p->release)/cyclesperus,(t-p->release)/cyclesperus);
+    }
+}
+
+/**
+ * @details Returns -1 on write error
+ */
+
+int Trace_Close(void) {
+int r = 0;
+
+    if( !file )
+        return 0;
+    if( json )
+        fputs(events?"\n]\n":"[]\n",file);
+    if( ferror(file) )
+        r = -1;
+    if( fclose(file) )
+        r = -1;
+    file = 0;
+    return r;
+}
+
+const TraceStats_t *Trace_GetStats(int k) {
+
+    return &tasks[k].stats;
+}
+
+const char *Trace_GetName(int k) {
+
+    return tasks[k].name;
+}
@@ -0,0 +1,49 @@
+#ifndef TRACE_H
+#define TRACE_H
+/**
+ * @file    trace.h
+ * @brief   Records release, start and end of the jobs of each task
+ *
+ * @note    Times are given in cycles and written in us. A job starts the
+ *          oldest release not yet started. The file format is given by the
+ *          extension of its name:
+ *          - .json: Chrome trace (chrome://tracing or ui.perfetto.dev), one
+ *            row per task, with each job as a bar and each release as a mark
+ *          - other: CSV, one line per job
+ *
+ *              task,job,release,start,end,latency,response
+ */
+
+#include <stdint.h>
+
+/// Maximum number of tasks
+#define TRACE_TASKS     (32)
+
+/// Maximum number of releases not yet started, for each task
+#define TRACE_PENDING   (16)
+
+/**
+ * @typedef TraceStats_t
+ * @brief   Statistics of a task (times in cycles)
+ */
+typedef struct {
+    uint64_t    releases;               ///< number of releases
+    uint64_t    jobs;                   ///< number of completed jobs
+    uint64_t    minlatency;             ///< minimum time from release to start
+    uint64_t    maxlatency;             ///< maximum time from release to start
+    uint64_t    maxresponse;            ///< maximum time from release to end
+    uint64_t    unreleased;             ///< starts without a pending release
+    uint64_t    missed;                 ///< jobs ending after the next release
+} TraceStats_t;
+
+int  Trace_Open(const char *filename, uint32_t hz);
+void Trace_Task(int k, const char *name);
+void Trace_Release(int k, uint64_t t);
+void Trace_Start(int k, uint64_t t);
+void Trace_End(int k, uint64_t t);
+int  Trace_Close(void);
+
+const TraceStats_t *Trace_GetStats(int k);
+const char *Trace_GetName(int k);
+
+#endif // TRACE_H
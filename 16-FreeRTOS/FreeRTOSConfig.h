@@ -42,19 +42,60 @@
  *----------------------------------------------------------*/
 
 #define configUSE_PREEMPTION		1
-#define configUSE_IDLE_HOOK			0
+#define configUSE_IDLE_HOOK			1
 #define configUSE_TICK_HOOK			0
 #define configCPU_CLOCK_HZ			( ( unsigned long ) 48000000 )
-#define configTICK_RATE_HZ			( ( TickType_t ) 1000 )
+#define configTICK_RATE_HZ			( ( TickType_t ) 1024 )
 #define configMINIMAL_STACK_SIZE	( ( unsigned short ) 100 )
-#define configTOTAL_HEAP_SIZE		( ( size_t ) ( 1500 ) )
-#define configMAX_TASK_NAME_LEN		( 3 )
-#define configUSE_TRACE_FACILITY	0
+#define configMAX_TASK_NAME_LEN		( 4 )
+#define configUSE_TRACE_FACILITY	1
 #define configUSE_16_BIT_TICKS		0
 #define configIDLE_SHOULD_YIELD		0
 #define configUSE_CO_ROUTINES 		0
+#define configUSE_NEWLIB_REENTRANT	1
+#define configUSE_MUTEXES			1
+#define configCHECK_FOR_STACK_OVERFLOW	2
 
-#define configMAX_PRIORITIES		( 2 )
+/* Tick from the RTC and sleep in EM2 when idle (see tickless.c). The tick
+rate must divide 32768 */
+#define configUSE_TICKLESS_IDLE		1
+
+/* All kernel objects in static memory (see main.c). There is no FreeRTOS heap */
+#define configSUPPORT_STATIC_ALLOCATION	1
+#define configSUPPORT_DYNAMIC_ALLOCATION	0
+
+/* Run time statistics (see runtime.c). The counter is the cycle counter
+divided by 32, plus the time slept. The trace macros count the context
+switches and the sleeps, and record events in the trace buffer (see trace.c) */
+#define configGENERATE_RUN_TIME_STATS	1
+#ifndef __ASSEMBLER__
+#include <stdint.h>
+#include "trace.h"
+extern void     RunTime_Init(void);
+extern uint32_t RunTime_GetCounter(void);
+extern void     RunTime_SwitchedIn(uint32_t tasknumber);
+extern void     RunTime_SleepBegin(void);
+extern void     RunTime_SleepEnd(void);
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	RunTime_Init()
+#define portGET_RUN_TIME_COUNTER_VALUE()		RunTime_GetCounter()
+#define traceTASK_SWITCHED_IN()			do { RunTime_SwitchedIn(pxCurrentTCB->uxTCBNumber); \
+						Trace_Record(TRACE_EV_SWITCH,pxCurrentTCB->uxTCBNumber,0); } while(0)
+#define traceLOW_POWER_IDLE_BEGIN()		do { RunTime_SleepBegin(); Trace_SleepBegin(); } while(0)
+#define traceLOW_POWER_IDLE_END()		do { Trace_SleepEnd(); RunTime_SleepEnd(); } while(0)
+
+#define traceQUEUE_SEND(pxQueue)				TRACE_QUEUE(TRACE_EV_QUEUE_SEND,pxQueue)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)		TRACE_QUEUE(TRACE_EV_QUEUE_SEND,pxQueue)
+#define traceQUEUE_SEND_FAILED(pxQueue)			TRACE_QUEUE(TRACE_EV_QUEUE_SEND_FAILED,pxQueue)
+#define traceQUEUE_SEND_FROM_ISR_FAILED(pxQueue)	TRACE_QUEUE(TRACE_EV_QUEUE_SEND_FAILED,pxQueue)
+#define traceQUEUE_RECEIVE(pxQueue)				TRACE_QUEUE(TRACE_EV_QUEUE_RECEIVE,pxQueue)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)	TRACE_QUEUE(TRACE_EV_QUEUE_RECEIVE,pxQueue)
+#define traceQUEUE_RECEIVE_FAILED(pxQueue)		TRACE_QUEUE(TRACE_EV_QUEUE_RECEIVE_FAILED,pxQueue)
+#define traceQUEUE_RECEIVE_FROM_ISR_FAILED(pxQueue)	TRACE_QUEUE(TRACE_EV_QUEUE_RECEIVE_FAILED,pxQueue)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue)	TRACE_QUEUE(TRACE_EV_QUEUE_BLOCK_SEND,pxQueue)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue)	TRACE_QUEUE(TRACE_EV_QUEUE_BLOCK_RECEIVE,pxQueue)
+
+#define configMAX_PRIORITIES		( 4 )
 #define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
 
 /* Set the following definitions to 1 to include the API function, or zero
@@ -65,8 +106,11 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelete				0
 #define INCLUDE_vTaskCleanUpResources	0
 #define INCLUDE_vTaskSuspend			0
-#define INCLUDE_vTaskDelayUntil			0
+#define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay				1
+#define INCLUDE_xTaskGetSchedulerState	1
+#define INCLUDE_uxTaskGetStackHighWaterMark	1
+#define INCLUDE_xTaskGetIdleTaskHandle	1
 
 #define configKERNEL_INTERRUPT_PRIORITY 		255
 /* !!!! configMAX_SYSCALL_INTERRUPT_PRIORITY must not be set to zero !!!!
@@ -0,0 +1,234 @@
+/**
+ * @file    app.c
+ * @brief   Application tasks of the FreeRTOS demo: LED, buttons and LCD
+ *
+ * @note    Tasks:
+ *          - LED blinks LED0. The period is changed by commands in its queue
+ *          - But waits for the buttons and sends commands to the LED task
+ *          - LCD shows the LED period and the uptime
+ *
+ * @note    All tasks, stacks and queues are in static memory
+ *          (configSUPPORT_STATIC_ALLOCATION). No hardware is accessed
+ *          directly, so this file is compiled for the board and for the host.
+ */
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "app.h"
+#include "led.h"
+#include "button.h"
+#include "lcd.h"
+#include "console.h"
+#include "trace.h"
+
+/**
+ * @brief   Task parameters
+ */
+///@{
+#define LEDSTACKSIZE        (configMINIMAL_STACK_SIZE)
+#define BUTTONSTACKSIZE     (configMINIMAL_STACK_SIZE)
+#define LCDSTACKSIZE        (configMINIMAL_STACK_SIZE)
+#define TASKPRIORITY        (tskIDLE_PRIORITY+1)
+#define BUTTONPRIORITY      (tskIDLE_PRIORITY+2)
+///@}
+
+/**
+ * @brief   Queue parameters
+ */
+///@{
+#define LEDQUEUESIZE        (4)
+#define LCDQUEUESIZE        (2)
+#define LCDTEXTSIZE         (8)
+///@}
+
+/// LED blinking period (ms)
+///@{
+#define LEDPERIOD           (1000)
+#define LEDMINPERIOD        (125)
+#define LEDMAXPERIOD        (8000)
+///@}
+
+/// Debouncing time of the buttons (ticks)
+#define DEBOUNCETIME        (pdMS_TO_TICKS(20))
+
+/// Update period of the LCD (ticks)
+#define LCDPERIOD           (pdMS_TO_TICKS(1000))
+
+/**
+ * @brief   Tasks and queues in static memory
+ */
+///@{
+static StaticTask_t         ledtcb, buttontcb, lcdtcb;
+static StackType_t          ledstack[LEDSTACKSIZE];
+static StackType_t          buttonstack[BUTTONSTACKSIZE];
+static StackType_t          lcdstack[LCDSTACKSIZE];
+
+static StaticQueue_t        ledqueuebuffer, lcdqueuebuffer;
+static uint8_t              ledqueuearea[LEDQUEUESIZE*sizeof(char)];
+static uint8_t              lcdqueuearea[LCDQUEUESIZE*LCDTEXTSIZE];
+
+static QueueHandle_t        ledqueue = 0;
+static QueueHandle_t        lcdqueue = 0;
+static TaskHandle_t         buttontask = 0;
+///@}
+
+/**************************************************************************//**
+ * @brief  Writes n in decimal, right aligned in a field with width chars
+ *
+ * @note   printf would need a larger stack in each task
+ */
+
+static void FormatNumber(char *s, uint32_t n, int width) {
+
+    s[width] = '\0';
+    do {
+        s[--width] = '0'+n%10;
+        n /= 10;
+    } while( n && width > 0 );
+    while( width > 0 )
+        s[--width] = ' ';
+}
+
+/**************************************************************************//**
+ * @brief  Button callback. Called in the GPIO interrupts
+ *
+ * @note   Only wakes the button task. The bits tell which button changed
+ */
+
+static void ButtonChanged(uint32_t mask) {
+BaseType_t woken = pdFALSE;
+
+    if( buttontask )
+        (void) xTaskNotifyFromISR(buttontask,mask,eSetBits,&woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**************************************************************************//**
+ * @brief  LED task
+ *
+ * @note   Toggles LED0 every half period. Between toggles, it is blocked in
+ *         its queue: + halves the period and - doubles it. The new period
+ *         is sent to the LCD task
+ */
+
+static void LEDTask(void *param) {
+uint32_t period = LEDPERIOD;
+char text[LCDTEXTSIZE];
+char cmd;
+
+    while(1) {
+        if( xQueueReceive(ledqueue,&cmd,pdMS_TO_TICKS(period/2)) == pdTRUE ) {
+            if( (cmd == '+') && (period > LEDMINPERIOD) )
+                period /= 2;
+            else if( (cmd == '-') && (period < LEDMAXPERIOD) )
+                period *= 2;
+            text[0] = 'P';
+            FormatNumber(&text[1],period,LCDTEXTSIZE-2);
+            (void) xQueueSend(lcdqueue,text,0);
+        } else {
+            LED_Toggle(LED0);
+        }
+    }
+}
+
+/**************************************************************************//**
+ * @brief  Button task
+ *
+ * @note   Waits for a notification of the GPIO interrupts and for the bounces
+ *         to end. BUTTON0 sends + and BUTTON1 sends - to the LED task. LED1
+ *         toggles at each press and the console is woken. The buttons are
+ *         low when pressed. The GPIO interrupts work in EM2
+ */
+
+static void ButtonTask(void *param) {
+uint32_t last,now,pressed;
+char cmd;
+
+    last = Button_Read();
+    while(1) {
+        (void) xTaskNotifyWait(0,UINT32_MAX,0,portMAX_DELAY);
+        vTaskDelay(DEBOUNCETIME);
+        now = Button_Read();
+        pressed = last&~now;
+        last = now;
+        if( pressed&BUTTON0 ) {
+            cmd = '+';
+            (void) xQueueSend(ledqueue,&cmd,0);
+        }
+        if( pressed&BUTTON1 ) {
+            cmd = '-';
+            (void) xQueueSend(ledqueue,&cmd,0);
+        }
+        if( pressed ) {
+            LED_Toggle(LED1);
+            Console_Wake();
+        }
+    }
+}
+
+/**************************************************************************//**
+ * @brief  LCD task
+ *
+ * @note   Shows the last text received in the alphanumeric field and the
+ *         uptime (s) in the numeric field, once per second
+ */
+
+static void LCDTask(void *param) {
+TickType_t next,elapsed;
+uint32_t seconds = 0;
+char text[LCDTEXTSIZE];
+char number[5];
+
+    App_LCDInit();
+    LCD_WriteAlphanumericField("FREERTS");
+
+    next = xTaskGetTickCount();
+    while(1) {
+        elapsed = xTaskGetTickCount()-next;
+        if( elapsed < LCDPERIOD ) {
+            if( xQueueReceive(lcdqueue,text,LCDPERIOD-elapsed) == pdTRUE ) {
+                LCD_WriteAlphanumericField(text);
+                continue;
+            }
+        }
+        next += LCDPERIOD;
+        seconds++;
+        FormatNumber(number,seconds%10000,4);
+        LCD_WriteNumericField(number);
+    }
+}
+
+/**************************************************************************//**
+ * @brief  Creates the queues and the tasks
+ *
+ * @note   Must be called before the scheduler starts
+ */
+
+QueueHandle_t App_Init(void) {
+TaskHandle_t task;
+
+    /* Create queues */
+    ledqueue = xQueueCreateStatic(LEDQUEUESIZE,sizeof(char),ledqueuearea,&ledqueuebuffer);
+    lcdqueue = xQueueCreateStatic(LCDQUEUESIZE,LCDTEXTSIZE,lcdqueuearea,&lcdqueuebuffer);
+    Trace_NameQueue(ledqueue,"LED");
+    Trace_NameQueue(lcdqueue,"LCD");
+
+    Button_SetCallback(ButtonChanged);
+
+    /* Create tasks */
+    task = xTaskCreateStatic(LEDTask,"LED",LEDSTACKSIZE,0,TASKPRIORITY,
+                             ledstack,&ledtcb);
+    Console_AddTask(task,LEDSTACKSIZE);
+    buttontask = xTaskCreateStatic(ButtonTask,"But",BUTTONSTACKSIZE,0,BUTTONPRIORITY,
+                             buttonstack,&buttontcb);
+    Console_AddTask(buttontask,BUTTONSTACKSIZE);
+    task = xTaskCreateStatic(LCDTask,"LCD",LCDSTACKSIZE,0,TASKPRIORITY,
+                             lcdstack,&lcdtcb);
+    Console_AddTask(task,LCDSTACKSIZE);
+
+    return ledqueue;
+}
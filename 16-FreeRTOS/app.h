@@ -0,0 +1,34 @@
+#ifndef APP_H
+#define APP_H
+/**
+ * @file    app.h
+ * @brief   Application tasks of the FreeRTOS demo: LED, buttons and LCD
+ *
+ * @note    The tasks only use the APIs of led.h, button.h, lcd.h and
+ *          console.h, so the same code runs on the board (main.c) and on
+ *          the host with the FreeRTOS POSIX port (host/).
+ *
+ * @note    App_Init creates the queues and the tasks. The LEDs and the
+ *          buttons must be initialized before. The platform provides
+ *          App_LCDInit, called by the LCD task when the scheduler is running.
+ */
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+/**
+ * @fn      App_Init
+ * @brief   Creates the queues and the LED, button and LCD tasks
+ *
+ * @note    Returns the queue of the LED task. It accepts the commands +
+ *          (faster) and - (slower)
+ */
+QueueHandle_t App_Init(void);
+
+/**
+ * @fn      App_LCDInit
+ * @brief   Initializes the LCD. Provided by the platform
+ */
+void App_LCDInit(void);
+
+#endif // APP_H
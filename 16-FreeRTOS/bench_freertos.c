@@ -0,0 +1,329 @@
+/**
+ * @file    bench_freertos.c
+ * @brief   Port of the common benchmark (bench.h) to FreeRTOS
+ *
+ * @note    A controller task with the highest priority creates the tasks of
+ *          each test and waits until they signal the done semaphore:
+ *          - coop:     taskYIELD in CoopFirst until CoopSecond runs. Both
+ *                      have the same priority
+ *          - preempt:  xTaskNotifyGive in PreemptLow until PreemptHigh,
+ *                      blocked in ulTaskNotifyTake, runs
+ *          - isr:      BENCH_IRQn set pending by IsrSource until IsrWaiter,
+ *                      blocked in a binary semaphore, runs. The interrupt
+ *                      gives it with xSemaphoreGiveFromISR
+ *          - message:  xQueueSend and xQueueReceive of a BENCH_MSGSIZE item,
+ *                      without blocking
+ *          - sem:      xSemaphoreGive(ping) in SemPing until it takes pong,
+ *                      given back by SemPong, that has a higher priority
+ *          task is the size of the TCB plus the largest stack used by the
+ *          tasks of the tests.
+ *
+ * @note    Tasks and stacks are in static memory and are not deleted
+ *          (INCLUDE_vTaskDelete is 0). When a test ends, its tasks stay
+ *          blocked, so each one has its own slot.
+ *
+ * @note    The run time statistics and trace hooks of FreeRTOSConfig.h are
+ *          compiled in. Recording is stopped during the tests, but every
+ *          switch still counts for the run time statistics.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "em_device.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "bench.h"
+#include "serial.h"
+#include "trace.h"
+
+/**
+ * @brief   Task parameters
+ */
+///@{
+#define CONTROLPRIORITY     (configMAX_PRIORITIES-1)
+#define HIGHPRIORITY        (configMAX_PRIORITIES-2)
+#define LOWPRIORITY         (tskIDLE_PRIORITY+1)
+#define CONTROLSTACKSIZE    (2*configMINIMAL_STACK_SIZE)
+#define STACKSIZE           (configMINIMAL_STACK_SIZE)
+#define SLOTS               (9)
+///@}
+
+/// Messages in the queue
+#define QUEUESIZE           (4)
+
+/**
+ * @brief   Tasks, semaphores and queue in static memory
+ */
+///@{
+static StaticTask_t         controltcb;
+static StackType_t          controlstack[CONTROLSTACKSIZE];
+static StaticTask_t         tcb[SLOTS];
+static StackType_t          stack[SLOTS][STACKSIZE];
+static TaskHandle_t         task[SLOTS];
+static int                  slots = 0;
+
+static StaticSemaphore_t    donebuffer, isrbuffer, pingbuffer, pongbuffer;
+static SemaphoreHandle_t    done, isrsem, ping, pong;
+static StaticQueue_t        queuebuffer;
+static uint8_t              queuearea[QUEUESIZE*BENCH_MSGSIZE];
+static QueueHandle_t        queue;
+///@}
+
+/**
+ * @brief   Global variables
+ */
+///@{
+static BenchStat_t          stat;
+static volatile uint32_t    stamp = 0;      ///< cycle counter at the start of a sample
+static volatile int         stamped = 0;    ///< CoopFirst set stamp
+static volatile int         finished = 0;   ///< CoopSecond has all samples
+static TaskHandle_t         first = 0;      ///< first task of the test
+///@}
+
+/**
+ * @brief   Writes a line. Lines of different tasks are not mixed
+ */
+
+static void Write(const char *s) {
+
+    (void) Serial_Write(s,strlen(s));
+}
+
+/**
+ * @brief   Blocks forever. Tasks are not deleted
+ */
+
+static void Park(void) {
+
+    while(1) {
+        (void) ulTaskNotifyTake(pdTRUE,portMAX_DELAY);
+    }
+}
+
+/**
+ * @brief   Tells the controller the test is over and blocks
+ */
+
+static void Done(void) {
+
+    (void) xSemaphoreGive(done);
+    Park();
+}
+
+/**
+ * @brief   Interrupt of the isr test
+ */
+
+void BENCH_IRQHandler(void) {
+BaseType_t woken = pdFALSE;
+
+    (void) xSemaphoreGiveFromISR(isrsem,&woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief   coop tasks. The first one to run may be any of them
+ */
+///@{
+static void CoopFirst(void *param) {
+
+    while( !finished ) {
+        stamp = BENCH_NOW();
+        stamped = 1;
+        taskYIELD();
+    }
+    Park();
+}
+
+static void CoopSecond(void *param) {
+uint32_t now;
+
+    while( stat.n < BENCH_SAMPLES ) {
+        now = BENCH_NOW();
+        if( stamped )
+            Bench_Add(&stat,now-stamp);
+        stamped = 0;
+        taskYIELD();
+    }
+    finished = 1;
+    Done();
+}
+///@}
+
+/**
+ * @brief   preempt tasks
+ */
+///@{
+static void PreemptHigh(void *param) {
+
+    while(1) {
+        (void) ulTaskNotifyTake(pdTRUE,portMAX_DELAY);
+        Bench_Add(&stat,BENCH_NOW()-stamp);
+    }
+}
+
+static void PreemptLow(void *param) {
+int i;
+
+    for(i=0;i<BENCH_SAMPLES;i++) {
+        stamp = BENCH_NOW();
+        (void) xTaskNotifyGive(first);
+    }
+    Done();
+}
+///@}
+
+/**
+ * @brief   isr tasks
+ */
+///@{
+static void IsrWaiter(void *param) {
+
+    while(1) {
+        (void) xSemaphoreTake(isrsem,portMAX_DELAY);
+        Bench_Add(&stat,BENCH_NOW()-stamp);
+    }
+}
+
+static void IsrSource(void *param) {
+int i;
+
+    for(i=0;i<BENCH_SAMPLES;i++) {
+        stamp = BENCH_NOW();
+        BENCH_TRIGGER();
+    }
+    Done();
+}
+///@}
+
+/**
+ * @brief   message task
+ */
+
+static void Message(void *param) {
+uint8_t message[BENCH_MSGSIZE];
+uint32_t c;
+int i;
+
+    memset(message,0,sizeof(message));
+    for(i=0;i<BENCH_SAMPLES;i++) {
+        c = BENCH_NOW();
+        (void) xQueueSend(queue,message,0);
+        (void) xQueueReceive(queue,message,0);
+        Bench_Add(&stat,BENCH_NOW()-c);
+    }
+    Done();
+}
+
+/**
+ * @brief   sem tasks
+ */
+///@{
+static void SemPong(void *param) {
+
+    while(1) {
+        (void) xSemaphoreTake(ping,portMAX_DELAY);
+        (void) xSemaphoreGive(pong);
+    }
+}
+
+static void SemPing(void *param) {
+int i;
+
+    for(i=0;i<BENCH_SAMPLES;i++) {
+        stamp = BENCH_NOW();
+        (void) xSemaphoreGive(ping);
+        (void) xSemaphoreTake(pong,portMAX_DELAY);
+        Bench_Add(&stat,BENCH_NOW()-stamp);
+    }
+    Done();
+}
+///@}
+
+/**
+ * @brief   Creates a task in the next slot
+ */
+
+static TaskHandle_t Create(TaskFunction_t f, const char *name, UBaseType_t priority) {
+
+    configASSERT(slots < SLOTS);
+    task[slots] = xTaskCreateStatic(f,name,STACKSIZE,0,priority,stack[slots],&tcb[slots]);
+    return task[slots++];
+}
+
+/**
+ * @brief   Creates the tasks of a test and waits for its end
+ *
+ * @note    The controller has the highest priority, so they only run when
+ *          it blocks
+ */
+
+static void Run(const char *test, TaskFunction_t f1, UBaseType_t p1,
+                                  TaskFunction_t f2, UBaseType_t p2) {
+
+    Bench_Clear(&stat);
+    first = Create(f1,"Bn1",p1);
+    if( f2 )
+        (void) Create(f2,"Bn2",p2);
+    (void) xSemaphoreTake(done,portMAX_DELAY);
+    Bench_Report(test,&stat);
+}
+
+/**
+ * @brief   Largest stack used by the tasks of the tests (bytes)
+ */
+
+static uint32_t StackUsed(void) {
+uint32_t used,max = 0;
+int i;
+
+    for(i=0;i<slots;i++) {
+        used = (STACKSIZE-uxTaskGetStackHighWaterMark(task[i]))*sizeof(StackType_t);
+        if( used > max )
+            max = used;
+    }
+    return max;
+}
+
+/**
+ * @brief   Controller task
+ */
+
+static void Control(void *param) {
+
+    Trace_Stop();
+    Bench_Init("freertos",Write);
+
+    Run("coop",CoopFirst,LOWPRIORITY,CoopSecond,LOWPRIORITY);
+    Run("preempt",PreemptHigh,HIGHPRIORITY,PreemptLow,LOWPRIORITY);
+    Run("isr",IsrWaiter,HIGHPRIORITY,IsrSource,LOWPRIORITY);
+    Run("message",Message,LOWPRIORITY,0,0);
+    Run("sem",SemPong,HIGHPRIORITY,SemPing,LOWPRIORITY);
+    Bench_ReportMemory(sizeof(StaticTask_t)+StackUsed());
+    Bench_End();
+
+    Trace_Start();
+    Park();
+}
+
+/**
+ * @details Creates the semaphores, the queue and the controller. The tests
+ *          run when the scheduler is started
+ */
+
+void Bench_Start(void) {
+
+    done   = xSemaphoreCreateBinaryStatic(&donebuffer);
+    isrsem = xSemaphoreCreateBinaryStatic(&isrbuffer);
+    ping   = xSemaphoreCreateBinaryStatic(&pingbuffer);
+    pong   = xSemaphoreCreateBinaryStatic(&pongbuffer);
+    queue  = xQueueCreateStatic(QUEUESIZE,BENCH_MSGSIZE,queuearea,&queuebuffer);
+    Trace_NameQueue(queue,"Bch");
+
+    (void) xTaskCreateStatic(Control,"Bch",CONTROLSTACKSIZE,0,CONTROLPRIORITY,
+                             controlstack,&controltcb);
+}
@@ -0,0 +1,300 @@
+/**
+ * @file    console.c
+ * @brief   Console task: single key commands on the serial port
+ *
+ * @note    Commands:
+ *          - f: RAM footprint (sections, stacks, kernel objects)
+ *          - m: context switch time and interrupt latency (perf.c)
+ *          - i: idle time and energy modes in the next second
+ *          - s: CPU time, context switches and stack of each task in the
+ *            next second (run time statistics, runtime.c)
+ *          - t: dump of the trace buffer (trace.c)
+ *          - + and -: faster or slower LED blinking
+ *          - anything else: help
+ *
+ * @note    The task waits for the keys blocked in the stream buffer of
+ *          serial.c, so it uses no CPU between keystrokes. But the UART does
+ *          not receive in EM2, so serial.c blocks EM2 meanwhile. After
+ *          CONSOLE_AWAKETIME without a key, the console stops reading and
+ *          waits for Console_Wake (a button), letting the processor sleep
+ *          in EM2.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <malloc.h>
+#include "em_device.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+
+#include "console.h"
+#include "serial.h"
+#include "idlemeter.h"
+#include "perf.h"
+#include "tickless.h"
+#include "runtime.h"
+#include "trace.h"
+
+/// Number of task switches measured by the m command
+#define MEASURES        (100)
+
+/**
+ * @brief   Symbols defined in the linker script (efm32gg.ld)
+ */
+///@{
+extern char __data_start__[];
+extern char __data_end__[];
+extern char __bss_start__[];
+extern char __bss_end__[];
+extern char __StackLimit[];
+extern char __StackTop[];
+///@}
+
+/**
+ * @brief   Tasks shown by the footprint command
+ */
+///@{
+static struct {
+    TaskHandle_t    handle;
+    uint32_t        stacksize;          ///< words
+} tasks[CONSOLE_MAXTASKS];
+static int ntasks = 0;
+///@}
+
+/// Results of the m command. Too large for the stack
+static PerfResults_t results;
+
+/**
+ * @brief   Snapshots of the s command. Too large for the stack
+ */
+///@{
+static TaskStatus_t status0[RUNTIME_MAXTASKS];
+static TaskStatus_t status1[RUNTIME_MAXTASKS];
+static uint32_t     switches0[RUNTIME_MAXTASKS];
+///@}
+
+/// Given by Console_Wake
+///@{
+static StaticSemaphore_t    wakebuffer;
+static SemaphoreHandle_t    wake = 0;
+///@}
+
+static const char help[] =
+    "\r\nCommands: f (footprint), m (measure), i (idle), s (statistics),"
+    " t (trace), + (faster), - (slower)\r\n";
+
+/**
+ * @details Does nothing before the console task creates the semaphore
+ */
+
+void Console_Wake(void) {
+
+    if( wake )
+        (void) xSemaphoreGive(wake);
+}
+
+void Console_AddTask(TaskHandle_t task, uint32_t stacksize) {
+
+    if( ntasks < CONSOLE_MAXTASKS ) {
+        tasks[ntasks].handle    = task;
+        tasks[ntasks].stacksize = stacksize;
+        ntasks++;
+    }
+}
+
+/**
+ * @brief   Prints the RAM used
+ *
+ * @note    The stack free is the smallest value since the task started
+ *          (uxTaskGetStackHighWaterMark). The main stack is only used by
+ *          main and, after the scheduler starts, by the interrupts
+ */
+
+static void Footprint(void) {
+struct mallinfo mi = mallinfo();
+UBaseType_t free;
+int i;
+
+    printf("\r\n.data %5lu  .bss %5lu  heap (newlib) %5lu  main stack %5lu bytes\r\n",
+            (unsigned long) (__data_end__-__data_start__),
+            (unsigned long) (__bss_end__-__bss_start__),
+            (unsigned long) mi.arena,
+            (unsigned long) (__StackTop-__StackLimit));
+    printf("TCB %u  queue/semaphore %u  stream buffer %u bytes each\r\n",
+            (unsigned) sizeof(StaticTask_t),
+            (unsigned) sizeof(StaticQueue_t),
+            (unsigned) sizeof(StaticStreamBuffer_t));
+    printf("Task  stack  free (bytes)\r\n");
+    for(i=0;i<ntasks;i++) {
+        free = uxTaskGetStackHighWaterMark(tasks[i].handle);
+        printf("%-4s  %5lu  %5lu\r\n",pcTaskGetName(tasks[i].handle),
+                (unsigned long) (tasks[i].stacksize*sizeof(StackType_t)),
+                (unsigned long) (free*sizeof(StackType_t)));
+    }
+    free = uxTaskGetStackHighWaterMark(xTaskGetIdleTaskHandle());
+    printf("%-4s  %5lu  %5lu\r\n",pcTaskGetName(xTaskGetIdleTaskHandle()),
+            (unsigned long) (configMINIMAL_STACK_SIZE*sizeof(StackType_t)),
+            (unsigned long) (free*sizeof(StackType_t)));
+}
+
+/**
+ * @brief   Prints one line of the measurements in cycles and in ns
+ */
+
+static void PrintStat(const char *label, const PerfStat_t *stat) {
+uint32_t mhz = SystemCoreClock/1000000;
+uint32_t avg = Perf_Average(stat);
+
+    printf("%-11s %5lu %5lu %5lu cycles  %6lu ns avg (%lu samples)\r\n",label,
+            (unsigned long) stat->min,(unsigned long) avg,(unsigned long) stat->max,
+            (unsigned long) (avg*1000/mhz),(unsigned long) stat->n);
+}
+
+static void Measure(void) {
+
+    Perf_Measure(MEASURES,&results);
+    printf("\r\n                min   avg   max\r\n");
+    PrintStat("Switch to",&results.switchto);
+    PrintStat("Switch back",&results.switchback);
+    PrintStat("IRQ latency",&results.irqlatency);
+    PrintStat("IRQ to task",&results.irqtotask);
+}
+
+/**
+ * @brief   Returns part/total in 1/1000 units
+ */
+
+static uint32_t Permille(uint64_t part, uint64_t total) {
+
+    if( total == 0 )
+        return 0;
+    return (uint32_t) (part*1000/total);
+}
+
+/**
+ * @brief   Prints the idle time and the time in each energy mode in 1 s
+ *
+ * @note    The idle time is a part of the time awake (EM0), since the cycle
+ *          counter stops in sleep. This task is blocked during the second
+ */
+
+static void Idle(void) {
+TicklessTimes_t e0,e1;
+uint32_t c0,t0,idle,em1,em2;
+uint64_t total;
+
+    c0 = IdleMeter_GetCycles();
+    t0 = DWT->CYCCNT;
+    Tickless_GetTimes(&e0);
+    vTaskDelay(pdMS_TO_TICKS(1000));
+    Tickless_GetTimes(&e1);
+    idle = IdleMeter_GetPermille(IdleMeter_GetCycles()-c0,DWT->CYCCNT-t0);
+
+    total = e1.total-e0.total;
+    em1   = Permille(e1.em1-e0.em1,total);
+    em2   = Permille(e1.em2-e0.em2,total);
+    printf("\r\nEM0 %lu.%lu %%  EM1 %lu.%lu %%  EM2 %lu.%lu %%\r\n",
+            (unsigned long) (1000-em1-em2)/10,(unsigned long) (1000-em1-em2)%10,
+            (unsigned long) em1/10,(unsigned long) em1%10,
+            (unsigned long) em2/10,(unsigned long) em2%10);
+    printf("Idle %lu.%lu %% of EM0 (%lu overruns)\r\n",(unsigned long) idle/10,(unsigned long) idle%10,
+            (unsigned long) Serial_GetOverruns());
+}
+
+/**
+ * @brief   Prints the run time statistics of each task in 1 s
+ *
+ * @note    The kernel counters are read twice and the differences are shown,
+ *          since the run time counter wraps around (runtime.h). Tasks are
+ *          matched by number, since uxTaskGetSystemState does not keep the
+ *          order. The sleep time is part of the idle task time. The stack
+ *          free is the smallest value since the task started
+ */
+
+static void Statistics(void) {
+UBaseType_t n0,n1,i,j;
+uint32_t total0,total1,total,cpu,sw,num;
+
+    n0 = uxTaskGetSystemState(status0,RUNTIME_MAXTASKS,&total0);
+    for(i=0;i<n0;i++)
+        switches0[i] = RunTime_GetSwitches(status0[i].xTaskNumber);
+    vTaskDelay(pdMS_TO_TICKS(1000));
+    n1 = uxTaskGetSystemState(status1,RUNTIME_MAXTASKS,&total1);
+    total = total1-total0;
+
+    printf("\r\nTask  pri    CPU %%  switches (1 s/total)  stack free (bytes)\r\n");
+    for(i=0;i<n1;i++) {
+        num = status1[i].xTaskNumber;
+        for(j=0;j<n0 && status0[j].xTaskNumber != num;j++) {}
+        if( j < n0 ) {
+            cpu = Permille(status1[i].ulRunTimeCounter-status0[j].ulRunTimeCounter,total);
+            sw  = RunTime_GetSwitches(num)-switches0[j];
+        } else {                                        // created in the window
+            cpu = Permille(status1[i].ulRunTimeCounter,total);
+            sw  = RunTime_GetSwitches(num);
+        }
+        printf("%-4s  %3lu  %3lu.%lu %%  %8lu %10lu  %18lu\r\n",status1[i].pcTaskName,
+                (unsigned long) status1[i].uxCurrentPriority,
+                (unsigned long) cpu/10,(unsigned long) cpu%10,
+                (unsigned long) sw,(unsigned long) RunTime_GetSwitches(num),
+                (unsigned long) (status1[i].usStackHighWaterMark*sizeof(StackType_t)));
+    }
+    printf("Counter %lu Hz, %lu in the window\r\n",(unsigned long) RunTime_GetFrequency(),
+            (unsigned long) total);
+}
+
+/**************************************************************************//**
+ * @brief  Console task
+ *
+ * @note   param is the queue of the LED task
+ */
+
+void Console(void *param) {
+QueueHandle_t ledqueue = (QueueHandle_t) param;
+char cmd;
+int ch;
+
+    wake = xSemaphoreCreateBinaryStatic(&wakebuffer);
+    Trace_NameQueue(wake,"Wak");
+
+    printf("%s",help);
+    while(1) {
+        ch = Serial_GetChar(CONSOLE_AWAKETIME);
+        if( ch < 0 ) {
+            printf("\r\nConsole asleep. Press a button to wake it\r\n");
+            (void) xSemaphoreTake(wake,0);              // only a press from now on
+            (void) xSemaphoreTake(wake,portMAX_DELAY);
+            printf("%s",help);
+            continue;
+        }
+        cmd = (char) ch;
+        switch(cmd) {
+        case 'f':
+            Footprint();
+            break;
+        case 'm':
+            Measure();
+            break;
+        case 'i':
+            Idle();
+            break;
+        case 's':
+            Statistics();
+            break;
+        case 't':
+            Trace_Dump();
+            break;
+        case '+':
+        case '-':
+            (void) xQueueSend(ledqueue,&cmd,0);
+            break;
+        default:
+            printf("%s",help);
+            break;
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+/**
+ * @file    console.h
+ * @brief   Console task: single key commands on the serial port
+ *
+ * @note    The task parameter is the queue of the LED task. The commands +
+ *          and - are sent to it.
+ *
+ * @note    After CONSOLE_AWAKETIME without input, the console stops reading
+ *          the serial port, so the processor can sleep in EM2. Console_Wake
+ *          makes it read again.
+ *
+ * @note    Console_AddTask must be called for each task created, before the
+ *          scheduler starts, so the footprint command can show its stack.
+ */
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/// Maximal number of tasks shown by the footprint command
+#ifndef CONSOLE_MAXTASKS
+#define CONSOLE_MAXTASKS    (8)
+#endif
+
+/// Stack size of the console task (words). printf needs a large stack
+#ifndef CONSOLE_STACKSIZE
+#define CONSOLE_STACKSIZE   (400)
+#endif
+
+/// Time without input before the console sleeps (ticks)
+#ifndef CONSOLE_AWAKETIME
+#define CONSOLE_AWAKETIME   (pdMS_TO_TICKS(60000))
+#endif
+
+void Console(void *param);
+void Console_AddTask(TaskHandle_t task, uint32_t stacksize);
+void Console_Wake(void);
+
+#endif // CONSOLE_H
@@ -0,0 +1,66 @@
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+/**
+ * @file    FreeRTOSConfig.h
+ * @brief   FreeRTOS configuration for the host build (POSIX port)
+ *
+ * @note    Same application settings as ../FreeRTOSConfig.h: static
+ *          allocation only, 4 priorities, preemption, mutexes. The board
+ *          specific parts (tickless idle on the RTC, interrupt levels, trace
+ *          into the RAM buffer) are left out.
+ *
+ * @note    The POSIX port runs each task in a thread. Only one runs at a
+ *          time. The tick is a timer signal. The stacks given to the kernel
+ *          must be at least PTHREAD_STACK_MIN (16 KiB) long, so
+ *          configMINIMAL_STACK_SIZE is much larger than on the board and the
+ *          stack high water marks are not comparable.
+ */
+
+#include <stdint.h>
+
+#define configUSE_PREEMPTION                    1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     0
+#define configTICK_RATE_HZ                      ( ( TickType_t ) 1000 )
+#define configMINIMAL_STACK_SIZE                ( ( unsigned short ) 2048 )
+#define configMAX_TASK_NAME_LEN                 ( 8 )
+#define configUSE_TRACE_FACILITY                1
+#define configUSE_STATS_FORMATTING_FUNCTIONS    1
+#define configUSE_16_BIT_TICKS                  0
+#define configIDLE_SHOULD_YIELD                 0
+#define configUSE_CO_ROUTINES                   0
+#define configUSE_MUTEXES                       1
+#define configUSE_TIMERS                        0
+#define configCHECK_FOR_STACK_OVERFLOW          0
+#define configUSE_TICKLESS_IDLE                 0
+
+#define configSUPPORT_STATIC_ALLOCATION         1
+#define configSUPPORT_DYNAMIC_ALLOCATION        0
+
+#define configMAX_PRIORITIES                    ( 4 )
+#define configMAX_CO_ROUTINE_PRIORITIES         ( 2 )
+
+/* Run time statistics in microseconds of the host clock (main.c) */
+#define configGENERATE_RUN_TIME_STATS           1
+extern void     Host_RunTimeInit(void);
+extern uint32_t Host_RunTimeCounter(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    Host_RunTimeInit()
+#define portGET_RUN_TIME_COUNTER_VALUE()            Host_RunTimeCounter()
+
+/* Assertions stop the program with the file and line */
+extern void Host_Assert(const char *file, int line);
+#define configASSERT(x)     if( !(x) ) Host_Assert(__FILE__,__LINE__)
+
+#define INCLUDE_vTaskPrioritySet                0
+#define INCLUDE_uxTaskPriorityGet               0
+#define INCLUDE_vTaskDelete                     0
+#define INCLUDE_vTaskCleanUpResources           0
+#define INCLUDE_vTaskSuspend                    0
+#define INCLUDE_vTaskDelayUntil                 1
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_xTaskGetSchedulerState          1
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+#define INCLUDE_xTaskGetIdleTaskHandle          1
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,86 @@
+/**
+ * @file    button_host.c
+ * @brief   Button HAL for the host. Buttons are pressed by Host_PressButton
+ *
+ * @note    As on the board, a button reads 0 when pressed. The callback is
+ *          called with the scheduler suspended, so the FromISR functions it
+ *          uses run as they would in the GPIO interrupt: a task they unblock
+ *          runs after the "interrupt" ends.
+ */
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "button.h"
+#include "host.h"
+
+/// Time a simulated press lasts (ticks)
+#define PRESSTIME       (pdMS_TO_TICKS(100))
+
+static uint32_t inputpins   = 0;
+static uint32_t state       = 0;        ///< 1 = released
+static uint32_t lastread    = 0;
+static void   (*callback)(uint32_t) = 0;
+
+static void Interrupt(uint32_t mask) {
+
+    vTaskSuspendAll();
+    if( callback ) callback(mask);
+    (void) xTaskResumeAll();
+}
+
+void Button_Init(uint32_t buttons) {
+
+    inputpins |= buttons;
+    state     |= buttons;
+    lastread   = state;
+}
+
+uint32_t Button_Read(void) {
+
+    return state&inputpins;
+}
+
+uint32_t Button_ReadChanges(void) {
+uint32_t changes = (state^lastread)&inputpins;
+
+    lastread = state;
+    return changes;
+}
+
+uint32_t Button_ReadPressed(void) {
+uint32_t pressed = lastread&~state&inputpins;
+
+    lastread = state;
+    return pressed;
+}
+
+uint32_t Button_ReadReleased(void) {
+uint32_t released = ~lastread&state&inputpins;
+
+    lastread = state;
+    return released;
+}
+
+void Button_SetCallback( void (*proc)(uint32_t parm) ) {
+
+    callback = proc;
+}
+
+/**
+ * @details Blocks the calling task during the press
+ */
+
+void Host_PressButton(uint32_t buttons) {
+
+    buttons &= inputpins;
+    if( buttons == 0 )
+        return;
+    state &= ~buttons;
+    Interrupt(buttons);
+    vTaskDelay(PRESSTIME);
+    state |= buttons;
+    Interrupt(buttons);
+}
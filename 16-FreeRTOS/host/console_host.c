@@ -0,0 +1,112 @@
+/**
+ * @file    console_host.c
+ * @brief   Console task for the host: single key commands on standard input
+ *
+ * @note    Commands:
+ *          - + and -: faster or slower LED blinking
+ *          - 0 and 1: press BUTTON0 or BUTTON1
+ *          - s: task list and run time statistics (kernel formatting functions)
+ *          - l: load generator report (load.c)
+ *          - q: quit
+ *          - anything else: help
+ *
+ * @note    The board console (console.c) needs the cycle counter, the RTC
+ *          and TIMER1. This one has the same interface (console.h).
+ *          Console_Wake does nothing, since it never sleeps. Terminals send
+ *          the keys only after Enter.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "console.h"
+#include "serial.h"
+#include "button.h"
+#include "load.h"
+#include "host.h"
+
+/// Task list and statistics. Too large for the stack
+static char report[1024];
+
+static const char help[] =
+    "\nCommands: + (faster), - (slower), 0/1 (buttons), s (statistics), l (load), q (quit)\n";
+
+static void Print(const char *s) {
+
+    (void) Serial_Write(s,(int) strlen(s));
+}
+
+void Console_AddTask(TaskHandle_t task, uint32_t stacksize) {
+
+}
+
+void Console_Wake(void) {
+
+}
+
+/**
+ * @brief   Prints the task list and the CPU time of each task
+ *
+ * @note    The stack column is in words and, on the host, only shows
+ *          that the stacks given to the POSIX port are large
+ */
+
+static void Statistics(void) {
+
+    Print("\nTask    State Pri Stack  Num\n");
+    vTaskList(report);
+    Print(report);
+    Print("\nTask    Time (us)       CPU\n");
+    vTaskGetRunTimeStats(report);
+    Print(report);
+}
+
+/**************************************************************************//**
+ * @brief  Console task
+ *
+ * @note   param is the queue of the LED task
+ */
+
+void Console(void *param) {
+QueueHandle_t ledqueue = (QueueHandle_t) param;
+char cmd;
+int ch;
+
+    Print(help);
+    while(1) {
+        ch = Serial_GetChar(portMAX_DELAY);
+        if( ch < 0 || ch == '\n' || ch == '\r' )
+            continue;
+        cmd = (char) ch;
+        switch(cmd) {
+        case '+':
+        case '-':
+            (void) xQueueSend(ledqueue,&cmd,0);
+            break;
+        case '0':
+            Host_PressButton(BUTTON0);
+            break;
+        case '1':
+            Host_PressButton(BUTTON1);
+            break;
+        case 's':
+            Statistics();
+            break;
+        case 'l':
+            Load_Report();
+            break;
+        case 'q':
+            exit(0);
+            break;
+        default:
+            Print(help);
+            break;
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef HOST_H
+#define HOST_H
+/**
+ * @file    host.h
+ * @brief   Functions of the host shims that have no equivalent on the board
+ */
+
+#include <stdint.h>
+
+/// When set, the LED and LCD shims print each change
+extern int Host_Verbose;
+
+/**
+ * @fn      Host_PressButton
+ * @brief   Presses and releases buttons, calling the callback as the GPIO
+ *          interrupt would. Must be called by a task
+ */
+void Host_PressButton(uint32_t buttons);
+
+/**
+ * @fn      Host_GetMicroseconds
+ * @brief   Returns the host monotonic clock in microseconds
+ */
+uint64_t Host_GetMicroseconds(void);
+
+#endif // HOST_H
@@ -0,0 +1,79 @@
+/**
+ * @file    lcd_host.c
+ * @brief   LCD HAL for the host. Keeps the fields and prints them when verbose
+ *
+ * @note    The alphanumeric field has 7 positions and the numeric field 4,
+ *          as on the STK3700 display
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "lcd.h"
+#include "host.h"
+
+static char alpha[8]   = "       ";
+static char numeric[5] = "    ";
+
+static void Show(void) {
+
+    if( Host_Verbose )
+        printf("LCD [%s] [%s]\n",alpha,numeric);
+}
+
+static void Copy(char *field, const char *s, int size) {
+int i;
+
+    for(i=0;i<size;i++)
+        field[i] = (*s) ? *s++ : ' ';
+    field[size] = '\0';
+}
+
+void LCD_Init(void) {
+
+    LCD_Clear();
+}
+
+void LCD_Clear(void) {
+
+    Copy(alpha,"",7);
+    Copy(numeric,"",4);
+}
+
+void LCD_WriteChar(uint8_t c, uint8_t pos) {
+
+    if( pos < 7 )
+        alpha[pos] = c;
+    else if( pos < 11 )
+        numeric[pos-7] = c;
+    Show();
+}
+
+void LCD_WriteString(char *s) {
+
+    LCD_WriteAlphanumericField(s);
+    if( strlen(s) > 7 )
+        LCD_WriteNumericField(s+7);
+}
+
+void LCD_WriteAlphanumericField(char *s) {
+
+    Copy(alpha,s,7);
+    Show();
+}
+
+void LCD_WriteNumericField(char *s) {
+
+    Copy(numeric,s,4);
+    Show();
+}
+
+void LCD_SetSpecial(uint8_t c, uint8_t v) {
+
+}
+
+uint32_t LCD_SetClock(uint32_t div) {
+
+    return 0;
+}
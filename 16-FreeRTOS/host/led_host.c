@@ -0,0 +1,51 @@
+/**
+ * @file    led_host.c
+ * @brief   LED HAL for the host. Keeps the state and prints it when verbose
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "led.h"
+#include "host.h"
+
+static uint32_t leds = 0;              ///< LEDs on
+
+static void Show(uint32_t old) {
+
+    if( Host_Verbose && old != leds )
+        printf("LED0 %s LED1 %s\n",(leds&LED0)?"on ":"off",(leds&LED1)?"on ":"off");
+}
+
+void LED_Init(uint32_t l) {
+
+    leds &= ~l;
+}
+
+void LED_On(uint32_t l) {
+uint32_t old = leds;
+
+    leds |= l;
+    Show(old);
+}
+
+void LED_Off(uint32_t l) {
+uint32_t old = leds;
+
+    leds &= ~l;
+    Show(old);
+}
+
+void LED_Toggle(uint32_t l) {
+uint32_t old = leds;
+
+    leds ^= l;
+    Show(old);
+}
+
+void LED_Write(uint32_t off, uint32_t on) {
+uint32_t old = leds;
+
+    leds = (leds&~off)|on;
+    Show(old);
+}
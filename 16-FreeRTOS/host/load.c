@@ -0,0 +1,114 @@
+/**
+ * @file    load.c
+ * @brief   Load generator for the host build
+ *
+ * @note    The counters of each task are only written by it. Load_Report
+ *          reads them without locking; a line can be one update behind.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "load.h"
+#include "serial.h"
+#include "host.h"
+
+/**
+ * @brief   Load tasks in static memory
+ */
+///@{
+static StaticTask_t     tcb[LOAD_MAXTASKS];
+static StackType_t      stack[LOAD_MAXTASKS][configMINIMAL_STACK_SIZE];
+static char             names[LOAD_MAXTASKS][configMAX_TASK_NAME_LEN];
+///@}
+
+/**
+ * @brief   Counters of each load task
+ */
+static struct {
+    uint32_t    sent;
+    uint32_t    lost;                   ///< queue full
+    uint64_t    maxwait;                ///< us waiting in Serial_Write
+    UBaseType_t maxdepth;               ///< messages in the queue after a send
+} counters[LOAD_MAXTASKS];
+
+static QueueHandle_t    ledqueue = 0;
+static TickType_t       loadperiod = 1;
+static int              nload = 0;
+
+static void LoadTask(void *param) {
+int id = (int) (intptr_t) param;
+char cmd = '+';
+char line[40];
+uint64_t t0,wait;
+UBaseType_t depth;
+int len;
+
+    while(1) {
+        if( xQueueSend(ledqueue,&cmd,0) == pdTRUE ) {
+            counters[id].sent++;
+            depth = uxQueueMessagesWaiting(ledqueue);
+            if( depth > counters[id].maxdepth )
+                counters[id].maxdepth = depth;
+        } else {
+            counters[id].lost++;
+        }
+        cmd = (cmd == '+') ? '-' : '+';
+
+        len = snprintf(line,sizeof(line),"%s %lu\n",names[id],(unsigned long) counters[id].sent);
+        t0 = Host_GetMicroseconds();
+        (void) Serial_Write(line,len);
+        wait = Host_GetMicroseconds()-t0;
+        if( wait > counters[id].maxwait )
+            counters[id].maxwait = wait;
+
+        vTaskDelay(loadperiod);
+    }
+}
+
+/**
+ * @details Must be called before the scheduler starts
+ */
+
+void Load_Init(QueueHandle_t queue, int ntasks, TickType_t period) {
+int i;
+
+    ledqueue   = queue;
+    loadperiod = (period > 0) ? period : 1;
+    if( ntasks > LOAD_MAXTASKS )
+        ntasks = LOAD_MAXTASKS;
+    for(i=0;i<ntasks;i++) {
+        snprintf(names[i],sizeof(names[i]),"Ld%d",i);
+        (void) xTaskCreateStatic(LoadTask,names[i],configMINIMAL_STACK_SIZE,(void *) (intptr_t) i,
+                                 1+i%(configMAX_PRIORITIES-1),stack[i],&tcb[i]);
+    }
+    nload = ntasks;
+}
+
+void Load_Report(void) {
+char line[80];
+int i,len;
+
+    len = snprintf(line,sizeof(line),"\nTask  pri      sent      lost  max wait (us)  max depth\n");
+    (void) Serial_Write(line,len);
+    for(i=0;i<nload;i++) {
+        len = snprintf(line,sizeof(line),"%-4s  %3d  %8lu  %8lu  %13lu  %9lu\n",names[i],
+                        1+i%(configMAX_PRIORITIES-1),
+                        (unsigned long) counters[i].sent,(unsigned long) counters[i].lost,
+                        (unsigned long) counters[i].maxwait,(unsigned long) counters[i].maxdepth);
+        (void) Serial_Write(line,len);
+    }
+}
+
+int Load_GetLost(void) {
+int i,lost = 0;
+
+    for(i=0;i<nload;i++)
+        lost += (int) counters[i].lost;
+    return lost;
+}
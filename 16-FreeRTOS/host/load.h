@@ -0,0 +1,32 @@
+#ifndef LOAD_H
+#define LOAD_H
+/**
+ * @file    load.h
+ * @brief   Load generator for the host build
+ *
+ * @note    Each load task sends + and - alternately to the LED queue without
+ *          waiting, writes a line with Serial_Write and sleeps a period. The
+ *          priorities go round from 1 to configMAX_PRIORITIES-1, so some
+ *          load tasks preempt the application tasks.
+ *
+ * @note    Load_Report prints, for each load task, the commands sent, the
+ *          ones lost because the queue was full, the largest time waiting
+ *          for the serial port, and the largest number of messages seen in
+ *          the LED queue.
+ */
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+/// Maximal number of load tasks
+#ifndef LOAD_MAXTASKS
+#define LOAD_MAXTASKS       (8)
+#endif
+
+void Load_Init(QueueHandle_t queue, int ntasks, TickType_t period);
+void Load_Report(void);
+int  Load_GetLost(void);
+
+#endif // LOAD_H
@@ -0,0 +1,163 @@
+/**
+ * @file    main.c
+ * @brief   FreeRTOS demo on the host (POSIX port)
+ *
+ * @note    Runs the application tasks of app.c with the shims of this
+ *          directory for the LEDs, the buttons, the LCD and the serial port,
+ *          a console on standard input and, optionally, load tasks (load.c).
+ *
+ * @note    Options:
+ *          - -l n: number of load tasks (0)
+ *          - -p ms: period of the load tasks (10 ms)
+ *          - -t s: runs s seconds, prints the statistics and exits
+ *          - -v: prints each change of the LEDs and of the LCD
+ *
+ *          E.g. ./freertos-host -l 8 -p 1 -t 10 < /dev/null > run.log
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "app.h"
+#include "led.h"
+#include "button.h"
+#include "lcd.h"
+#include "serial.h"
+#include "console.h"
+#include "load.h"
+#include "host.h"
+
+/// Priority of the console and of the run time task
+#define CONSOLEPRIORITY     (tskIDLE_PRIORITY+1)
+#define RUNPRIORITY         (configMAX_PRIORITIES-1)
+
+/**
+ * @brief   Console, run time and idle tasks in static memory
+ */
+///@{
+static StaticTask_t         contcb, runtcb, idletcb;
+static StackType_t          constack[configMINIMAL_STACK_SIZE];
+static StackType_t          runstack[configMINIMAL_STACK_SIZE];
+static StackType_t          idlestack[configMINIMAL_STACK_SIZE];
+///@}
+
+int Host_Verbose = 0;
+
+static uint64_t start = 0;                  ///< us at Host_RunTimeInit
+
+uint64_t Host_GetMicroseconds(void) {
+struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return (uint64_t) ts.tv_sec*1000000+(uint64_t) ts.tv_nsec/1000;
+}
+
+/**
+ * @brief   Run time counter for the statistics. Wraps around after 71 min
+ */
+///@{
+void Host_RunTimeInit(void) {
+
+    start = Host_GetMicroseconds();
+}
+
+uint32_t Host_RunTimeCounter(void) {
+
+    return (uint32_t) (Host_GetMicroseconds()-start);
+}
+///@}
+
+void Host_Assert(const char *file, int line) {
+
+    fprintf(stderr,"Assertion failed at %s:%d\n",file,line);
+    abort();
+}
+
+void vApplicationGetIdleTaskMemory(StaticTask_t **tcb, StackType_t **stack, uint32_t *size) {
+
+    *tcb   = &idletcb;
+    *stack = idlestack;
+    *size  = configMINIMAL_STACK_SIZE;
+}
+
+/**
+ * @brief   Called by the LCD task of app.c. There is no clock to set
+ */
+
+void App_LCDInit(void) {
+
+    LCD_Init();
+}
+
+/**
+ * @brief   Stops the program after the time given by -t
+ *
+ * @note    param is the time in ticks
+ */
+
+static void RunTask(void *param) {
+static char report[1024];
+TickType_t duration = (TickType_t) (uintptr_t) param;
+int len;
+
+    vTaskDelay(duration);
+    len = snprintf(report,sizeof(report),"\nTask    Time (us)       CPU\n");
+    vTaskGetRunTimeStats(report+len);
+    (void) Serial_Write(report,(int) strlen(report));
+    Load_Report();
+    len = snprintf(report,sizeof(report),"Lost commands: %d\n",Load_GetLost());
+    (void) Serial_Write(report,len);
+    exit(0);
+}
+
+int main(int argc, char *argv[]) {
+QueueHandle_t ledqueue;
+int nload = 0;
+int period = 10;
+int seconds = 0;
+int opt;
+
+    while( (opt = getopt(argc,argv,"l:p:t:v")) != -1 ) {
+        switch(opt) {
+        case 'l':
+            nload = atoi(optarg);
+            break;
+        case 'p':
+            period = atoi(optarg);
+            break;
+        case 't':
+            seconds = atoi(optarg);
+            break;
+        case 'v':
+            Host_Verbose = 1;
+            break;
+        default:
+            fprintf(stderr,"Usage: %s [-l tasks] [-p ms] [-t seconds] [-v]\n",argv[0]);
+            return 1;
+        }
+    }
+
+    LED_Init(LED0|LED1);
+    Serial_Init();
+    Button_Init(BUTTON0|BUTTON1);
+
+    ledqueue = App_Init();
+    (void) xTaskCreateStatic(Console,"Con",configMINIMAL_STACK_SIZE,ledqueue,CONSOLEPRIORITY,
+                             constack,&contcb);
+    Load_Init(ledqueue,nload,pdMS_TO_TICKS(period));
+    if( seconds > 0 )
+        (void) xTaskCreateStatic(RunTask,"Run",configMINIMAL_STACK_SIZE,
+                                 (void *) (uintptr_t) pdMS_TO_TICKS(seconds*1000),RUNPRIORITY,
+                                 runstack,&runtcb);
+
+    vTaskStartScheduler();
+    return 1;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file    serial_host.c
+ * @brief   Serial driver for the host: standard input and output
+ *
+ * @note    A blocking read would stop the thread of the task, so the input
+ *          is polled every SERIAL_POLLTIME ticks with select. After the end
+ *          of the input (e.g. from /dev/null in a test), reads just wait
+ *          for the timeout.
+ *
+ * @note    Serial_Write holds a mutex while writing, as serial.c does, so the
+ *          contention between tasks printing is the same as on the board.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/select.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "serial.h"
+
+/// Polling period of the input (ticks)
+#define SERIAL_POLLTIME     (pdMS_TO_TICKS(10))
+
+static StaticSemaphore_t    txmutexbuffer;
+static SemaphoreHandle_t    txmutex = 0;
+static int                  endofinput = 0;
+
+void Serial_Init(void) {
+
+    if( txmutex == 0 )
+        txmutex = xSemaphoreCreateMutexStatic(&txmutexbuffer);
+}
+
+/**
+ * @brief   Returns 1 when there is input, without waiting
+ */
+
+static int HasInput(void) {
+fd_set fds;
+struct timeval tv = { 0, 0 };
+
+    FD_ZERO(&fds);
+    FD_SET(STDIN_FILENO,&fds);
+    return select(STDIN_FILENO+1,&fds,0,0,&tv) > 0;
+}
+
+int Serial_Read(char *buf, int len, TickType_t timeout) {
+TickType_t start = xTaskGetTickCount();
+ssize_t n;
+
+    while(1) {
+        if( !endofinput && HasInput() ) {
+            n = read(STDIN_FILENO,buf,len);
+            if( n > 0 )
+                return (int) n;
+            if( n == 0 )
+                endofinput = 1;
+        }
+        if( xTaskGetTickCount()-start >= timeout )
+            return 0;
+        vTaskDelay(SERIAL_POLLTIME);
+    }
+}
+
+int Serial_GetChar(TickType_t timeout) {
+char ch;
+
+    if( Serial_Read(&ch,1,timeout) == 1 )
+        return (unsigned char) ch;
+    return -1;
+}
+
+/**
+ * @details Before the scheduler starts, writes without the mutex
+ */
+
+int Serial_Write(const char *buf, int len) {
+int locked = 0;
+
+    if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING ) {
+        (void) xSemaphoreTake(txmutex,portMAX_DELAY);
+        locked = 1;
+    }
+    fwrite(buf,1,len,stdout);
+    fflush(stdout);
+    if( locked )
+        (void) xSemaphoreGive(txmutex);
+    return len;
+}
+
+uint32_t Serial_GetOverruns(void) {
+
+    return 0;
+}
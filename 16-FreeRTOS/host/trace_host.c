@@ -0,0 +1,24 @@
+/**
+ * @file    trace_host.c
+ * @brief   Trace functions used by app.c, for the host
+ *
+ * @note    Nothing is recorded. The queues are only numbered, as on the
+ *          board, so vTaskList and a debugger show the same numbers.
+ */
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#include "trace.h"
+
+static UBaseType_t nqueues = 0;
+
+void Trace_NameQueue(void *queue, const char *name) {
+
+    if( nqueues < TRACE_MAXQUEUES ) {
+        nqueues++;
+        vQueueSetQueueNumber((QueueHandle_t) queue,nqueues);
+    }
+}
@@ -0,0 +1,63 @@
+/**
+ * @file    idlemeter.c
+ * @brief   Measures the time spent in the idle task
+ *
+ * @note    Only the idle hook writes the counter, so the tasks can read it
+ *          without locking. Interrupts served while idle are counted as idle
+ *          time when they are short.
+ */
+
+#include <stdint.h>
+#include "em_device.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "idlemeter.h"
+
+static volatile uint32_t idlecycles = 0;
+static uint32_t last = 0;
+
+/**
+ * @brief   Enables the cycle counter
+ */
+
+void IdleMeter_Init(void) {
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief   Idle hook. Called at each turn of the idle loop
+ */
+
+void vApplicationIdleHook(void) {
+uint32_t now = DWT->CYCCNT;
+uint32_t delta = now-last;
+
+    if( delta < IDLEMETER_GAP )
+        idlecycles += delta;
+    last = now;
+}
+
+/**
+ * @brief   Returns the cycles spent in the idle task since IdleMeter_Init
+ */
+
+uint32_t IdleMeter_GetCycles(void) {
+
+    return idlecycles;
+}
+
+/**
+ * @brief   Returns idlecycles/totalcycles in 1/1000 units
+ */
+
+uint32_t IdleMeter_GetPermille(uint32_t idlecycles, uint32_t totalcycles) {
+
+    if( totalcycles == 0 )
+        return 0;
+    return (uint32_t) (((uint64_t) idlecycles*1000)/totalcycles);
+}
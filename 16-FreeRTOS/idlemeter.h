@@ -0,0 +1,36 @@
+#ifndef IDLEMETER_H
+#define IDLEMETER_H
+/**
+ * @file    idlemeter.h
+ * @brief   Measures the time spent in the idle task
+ *
+ * @note    Needs configUSE_IDLE_HOOK set to 1. The idle hook reads the cycle
+ *          counter (DWT) at each turn of the idle loop. Intervals shorter
+ *          than IDLEMETER_GAP cycles are counted as idle. Longer ones mean
+ *          another task ran.
+ *
+ *              IdleMeter_Init();
+ *              ...
+ *              c0 = IdleMeter_GetCycles(); t0 = DWT->CYCCNT;
+ *              vTaskDelay(5000);
+ *              idle = IdleMeter_GetPermille(IdleMeter_GetCycles()-c0,DWT->CYCCNT-t0);
+ *
+ * @note    The counters wrap around after 2^32 cycles (89 s at 48 MHz).
+ *          Differences are right for shorter intervals
+ *
+ * @note    The cycle counter stops while the processor sleeps (tickless.c),
+ *          so the result is the idle part of the time awake
+ */
+
+#include <stdint.h>
+
+/// Longest turn of the idle loop (cycles)
+#ifndef IDLEMETER_GAP
+#define IDLEMETER_GAP   (1000)
+#endif
+
+void        IdleMeter_Init(void);
+uint32_t    IdleMeter_GetCycles(void);
+uint32_t    IdleMeter_GetPermille(uint32_t idlecycles, uint32_t totalcycles);
+
+#endif // IDLEMETER_H
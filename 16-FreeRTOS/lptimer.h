@@ -0,0 +1,57 @@
+#ifndef LPTIMER_H
+#define LPTIMER_H
+/**
+ * @file    lptimer.h
+ * @brief   Low power timer used for tickless operation
+ *
+ * @note    The timer runs in EM2 (deep sleep). It is a free running counter,
+ *          that wraps around after LPTIMER_MASK, with a compare register
+ *          that generates an interrupt.
+ *
+ * @note    Implemented by lptimer_efm32gg.c (RTC). Copied from 14-TimeTriggered
+ */
+
+#include <stdint.h>
+
+/// Counter frequency (Hz)
+#define LPTIMER_HZ          (32768)
+/// Counter is 24 bit wide
+#define LPTIMER_MASK        (0xFFFFFFu)
+/// Minimum distance between counter and compare value for an interrupt to happen
+#define LPTIMER_MINDELTA    (3)
+
+/**
+ * @fn      LPTimer_Init
+ * @brief   Starts the counter
+ *
+ * @param   callback   function called by the compare interrupt
+ * @return  void
+ */
+void LPTimer_Init(void (*callback)(void));
+
+/**
+ * @fn      LPTimer_Read
+ * @brief   Returns counter value
+ */
+uint32_t LPTimer_Read(void);
+
+/**
+ * @fn      LPTimer_SetCompare
+ * @brief   Sets the counter value that generates the next interrupt
+ */
+void LPTimer_SetCompare(uint32_t c);
+
+/**
+ * @fn      LPTimer_Sleep
+ * @brief   Sleeps until an interrupt
+ *
+ *          Must be called with interrupts disabled. They stay disabled, but the
+ *          pending interrupt wakes the processor
+ *
+ * @param   deep       0: EM1 (sleep), 1: EM2 (deep sleep). In EM2, high
+ *                     frequency peripherals (e.g. UART) stop
+ * @return  void
+ */
+void LPTimer_Sleep(int deep);
+
+#endif // LPTIMER_H
@@ -1,11 +1,26 @@
 /** ***************************************************************************
  * @file    main.c
- * @brief   Simple UART Demo for EFM32GG_STK3700
+ * @brief   FreeRTOS multi-task demo for EFM32GG_STK3700
  * @version 1.0
-******************************************************************************/
+ *
+ * @note    Tasks:
+ *          - Con (console.c) answers single key commands on the serial port
+ *          - LED, But and LCD (app.c) blink the LED, read the buttons and
+ *            show the LED period and the uptime
+ *          - Prf (perf.c) is only used to measure switch time and latency
+ *
+ * @note    This file has the board initialization. The application tasks
+ *          are in app.c, that is also compiled for the host (host/)
+ *
+ * @note    All tasks, stacks and queues are in static memory (.bss)
+ *          (configSUPPORT_STATIC_ALLOCATION). There is no FreeRTOS heap.
+ *
+ * @note    The tick comes from the RTC and the processor sleeps in EM2 when
+ *          all tasks are blocked (tickless.c)
+ ******************************************************************************/
 
 #include <stdint.h>
-#include <stdio.h>
+#include <string.h>
 /*
  * Including this file, it is possible to define which processor using command line
  * E.g. -DEFM32GG995F1024
@@ -16,10 +31,83 @@
 #include "clock_efm32gg.h"
 
 #include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
 
+#include "app.h"
 #include "led.h"
-#include "uart.h"
+#include "button.h"
+#include "lcd.h"
+#include "serial.h"
+#include "idlemeter.h"
+#include "perf.h"
+#include "console.h"
+#include "trace.h"
+
+/// Uncomment to run only the benchmark common to the kernel examples (bench.h)
+//#define BENCHMARK
+
+#ifdef BENCHMARK
+#include "bench.h"
+#endif
+
+/// Priority of the console task
+#define CONSOLEPRIORITY     (tskIDLE_PRIORITY+1)
+
+/**
+ * @brief   Console and idle tasks in static memory
+ */
+///@{
+static StaticTask_t         idletcb;
+static StackType_t          idlestack[configMINIMAL_STACK_SIZE];
+#ifndef BENCHMARK
+static StaticTask_t         contcb;
+static StackType_t          constack[CONSOLE_STACKSIZE];
+#endif
+///@}
+
+/**************************************************************************//**
+ * @brief  Gives the memory for the idle task
+ *
+ * @note   Needed when configSUPPORT_STATIC_ALLOCATION is set
+ */
+
+void vApplicationGetIdleTaskMemory(StaticTask_t **tcb, StackType_t **stack, uint32_t *size) {
+
+    *tcb   = &idletcb;
+    *stack = idlestack;
+    *size  = configMINIMAL_STACK_SIZE;
+}
+
+/**************************************************************************//**
+ * @brief  Called when a stack overflow is detected (configCHECK_FOR_STACK_OVERFLOW)
+ *
+ * @note   Prints the task name polling the UART and stops with both LEDs on
+ */
 
+void vApplicationStackOverflowHook(TaskHandle_t task, char *name) {
+
+    taskDISABLE_INTERRUPTS();
+    (void) Serial_Write("\r\nStack overflow: ",18);
+    (void) Serial_Write(name,strlen(name));
+    LED_Write(0,LED0|LED1);
+    while(1) {}
+}
+
+/**************************************************************************//**
+ * @brief  Sets the clock of the LCD and initializes it. Called by the LCD task
+ *
+ * @note   The LCD is a low energy peripheral. Its clock is LFACLK. The RTC
+ *         uses it too, so it was already set to LFXO (32768 Hz) by
+ *         vPortSetupTimerInterrupt (tickless.c) when the scheduler started
+ */
+
+void App_LCDInit(void) {
+
+    CMU->LFACLKEN0 |= CMU_LFACLKEN0_LCD;                // Enable LFACLK for LCD
+    while( CMU->SYNCBUSY&CMU_SYNCBUSY_LFACLKEN0 ) {}
+    LCD_Init();
+}
 
 /**************************************************************************//**
  * @brief  Main function
@@ -31,7 +119,10 @@
  */
 
 int main(void) {
-char line[100];
+#ifndef BENCHMARK
+QueueHandle_t ledqueue;
+TaskHandle_t task;
+#endif
 
     /* Configure LEDs */
     LED_Init(LED0|LED1);
@@ -42,19 +133,37 @@ char line[100];
     /* Turn on LEDs */
     LED_Write(0,LED0|LED1);
 
-    /* Configure SysTick */
-    SysTick_Config(SystemCoreClock/1000);
+    /* Configure UART again, for the new clock frequency */
+    Serial_Init();
+
+    /* Start cycle counter for idle time and measurements */
+    IdleMeter_Init();
+
+    /* Start recording events. Serial_Init named its mutex already */
+    Trace_Init();
+
+#ifdef BENCHMARK
+    /* Create the benchmark tasks only (bench_freertos.c) */
+    Bench_Start();
+#else
+    /* Configure buttons */
+    Button_Init(BUTTON0|BUTTON1);
+
+    /* Create the application queues and tasks (app.c) */
+    ledqueue = App_Init();
 
-    /* Configure UART */
-    UART_Init();
+    /* Create console and measurement tasks */
+    task = xTaskCreateStatic(Console,"Con",CONSOLE_STACKSIZE,ledqueue,CONSOLEPRIORITY,
+                             constack,&contcb);
+    Console_AddTask(task,CONSOLE_STACKSIZE);
+    task = Perf_Init();
+    Console_AddTask(task,PERF_STACKSIZE);
+#endif
 
-    __enable_irq();
+    /* Start FreeRTOS. It configures the RTC (tickless.c) */
+    vTaskStartScheduler();
 
-    printf("\r\n\n\n\rHello\n\r");
-    while (1) {
-        printf("\r\n\n\n\rWhat is your name?\n");
-        fgets(line,99,stdin);
-        printf("Hello %s\n",line);
-    }
+    // Just in case
+    while (1) {}
 
 }
@@ -0,0 +1,180 @@
+/**
+ * @file    perf.c
+ * @brief   Measures context switch time and interrupt latency
+ *
+ * @note    The interrupt latency is read from TIMER1. It counts HFPERCLK
+ *          cycles and wraps at TOP, setting the overflow flag. The value of
+ *          CNT in the interrupt routine is the number of cycles since the
+ *          overflow. HFPERCLK must be equal to HFCORECLK (see main.c).
+ *
+ * @note    The TIMER1 interrupt level is below configMAX_SYSCALL_INTERRUPT_PRIORITY,
+ *          so it is masked in the kernel critical sections. Their length
+ *          shows up in the maximum latency.
+ *
+ * @note    Only the helper task writes switchto and irqtotask, only the
+ *          interrupt routine writes irqlatency and only the calling task
+ *          writes switchback.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "em_device.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "perf.h"
+#include "tickless.h"
+#include "trace.h"
+
+/**
+ * @brief   Sources of the notification received by the helper
+ */
+///@{
+#define SOURCE_TASK     (0)
+#define SOURCE_ISR      (1)
+///@}
+
+/**
+ * @brief   Helper task in static memory
+ */
+///@{
+static StaticTask_t         helpertcb;
+static StackType_t          helperstack[PERF_STACKSIZE];
+static TaskHandle_t         helper = 0;
+///@}
+
+/**
+ * @brief   Global variables
+ */
+///@{
+static PerfResults_t        *results = 0;   ///< where measurements are stored
+static volatile uint32_t    start = 0;      ///< cycle counter before the notification
+static volatile uint32_t    woken = 0;      ///< cycle counter when the helper runs
+static volatile int         source = SOURCE_TASK;
+///@}
+
+/**
+ * @brief   Adds a sample to a statistics
+ */
+
+static void Add(PerfStat_t *stat, uint32_t cycles) {
+
+    if( stat->n == 0 || cycles < stat->min )
+        stat->min = cycles;
+    if( cycles > stat->max )
+        stat->max = cycles;
+    stat->sum += cycles;
+    stat->n++;
+}
+
+/**
+ * @brief   Helper task
+ *
+ * @note    Reads the cycle counter as soon as it is woken
+ */
+
+static void Helper(void *param) {
+uint32_t now;
+
+    while(1) {
+        (void) ulTaskNotifyTake(pdTRUE,portMAX_DELAY);
+        now = DWT->CYCCNT;
+        woken = now;
+        if( results ) {
+            if( source == SOURCE_ISR )
+                Add(&results->irqtotask,now-start);
+            else
+                Add(&results->switchto,now-start);
+        }
+    }
+}
+
+/**
+ * @brief   TIMER1 interrupt routine
+ *
+ * @note    CNT is read first, even before the trace record. Then the
+ *          helper is notified
+ */
+
+void TIMER1_IRQHandler(void) {
+uint32_t cnt = TIMER1->CNT;
+BaseType_t higher = pdFALSE;
+
+    TRACE_ISR_ENTER();
+    TIMER1->IFC = TIMER_IFC_OF;
+    if( results ) {
+        Add(&results->irqlatency,cnt);
+        source = SOURCE_ISR;
+        start = DWT->CYCCNT;
+        vTaskNotifyGiveFromISR(helper,&higher);
+    }
+    TRACE_ISR_EXIT();
+    portYIELD_FROM_ISR(higher);
+}
+
+/**
+ * @details Creates the helper only in the first call. TIMER1 is stopped
+ *          until Perf_Measure
+ */
+
+TaskHandle_t Perf_Init(void) {
+
+    if( helper == 0 )
+        helper = xTaskCreateStatic(Helper,"Prf",PERF_STACKSIZE,0,PERF_PRIORITY,
+                                   helperstack,&helpertcb);
+
+    CMU->HFPERCLKEN0 |= CMU_HFPERCLKEN0_TIMER1;         // Enable HFPERCLK for TIMER1
+    TIMER1->CMD  = TIMER_CMD_STOP;
+    TIMER1->CTRL = _TIMER_CTRL_RESETVALUE;              // Up count, prescaler 1
+    TIMER1->TOP  = SystemCoreClock/PERF_TIMERFREQ-1;
+    TIMER1->CNT  = 0;
+    TIMER1->IFC  = _TIMER_IFC_MASK;
+    TIMER1->IEN  = TIMER_IEN_OF;
+
+    NVIC_SetPriority(TIMER1_IRQn,PERF_INTLEVEL);
+    NVIC_ClearPendingIRQ(TIMER1_IRQn);
+    NVIC_EnableIRQ(TIMER1_IRQn);
+
+    return helper;
+}
+
+/**
+ * @details The switch measurements are done one at a time: the helper runs
+ *          as soon as it is notified and, when it blocks again, this task
+ *          continues. Then TIMER1 runs during PERF_WINDOW, while the caller
+ *          is blocked and the other tasks run as usual. TIMER1 stops in EM2,
+ *          so EM2 is blocked meanwhile.
+ */
+
+void Perf_Measure(uint32_t n, PerfResults_t *r) {
+uint32_t i,now;
+
+    memset(r,0,sizeof(PerfResults_t));
+    results = r;
+
+    for(i=0;i<n;i++) {
+        source = SOURCE_TASK;
+        start = DWT->CYCCNT;
+        (void) xTaskNotifyGive(helper);
+        now = DWT->CYCCNT;
+        Add(&r->switchback,now-woken);
+    }
+
+    Tickless_BlockEM2();
+    TIMER1->CNT = 0;
+    TIMER1->CMD = TIMER_CMD_START;
+    vTaskDelay(PERF_WINDOW);
+    TIMER1->CMD = TIMER_CMD_STOP;
+    TIMER1->IFC = TIMER_IFC_OF;
+    Tickless_UnblockEM2();
+
+    results = 0;
+}
+
+uint32_t Perf_Average(const PerfStat_t *stat) {
+
+    if( stat->n == 0 )
+        return 0;
+    return (uint32_t) (stat->sum/stat->n);
+}
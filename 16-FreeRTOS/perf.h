@@ -0,0 +1,98 @@
+#ifndef PERF_H
+#define PERF_H
+/**
+ * @file    perf.h
+ * @brief   Measures context switch time and interrupt latency
+ *
+ * @note    All times are in cycles of the cycle counter (DWT), that must be
+ *          enabled before (IdleMeter_Init does it). A helper task with the
+ *          highest priority is blocked in ulTaskNotifyTake and records the
+ *          time it is woken.
+ *
+ *              Perf_Init();
+ *              ...
+ *              Perf_Measure(100,&results);     // only from a task
+ *
+ * @note    Measurements:
+ *          - switchto:   xTaskNotifyGive in the calling task until the helper
+ *                        runs (give, PendSV and switch)
+ *          - switchback: helper blocks again until the calling task runs
+ *          - irqlatency: TIMER1 overflow until the first instruction of its
+ *                        interrupt routine, under the normal load of the tasks
+ *          - irqtotask:  vTaskNotifyGiveFromISR in TIMER1 interrupt until
+ *                        the helper runs
+ */
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/// Priority of the helper task (above all others)
+#ifndef PERF_PRIORITY
+#define PERF_PRIORITY       (configMAX_PRIORITIES-1)
+#endif
+
+/// Stack size of the helper task (words)
+#ifndef PERF_STACKSIZE
+#define PERF_STACKSIZE      (configMINIMAL_STACK_SIZE)
+#endif
+
+/// TIMER1 interrupt level. Must not be above configMAX_SYSCALL_INTERRUPT_PRIORITY
+#ifndef PERF_INTLEVEL
+#define PERF_INTLEVEL       (6)
+#endif
+
+/// TIMER1 overflow frequency during the interrupt measurements (Hz)
+#ifndef PERF_TIMERFREQ
+#define PERF_TIMERFREQ      (1000)
+#endif
+
+/// Duration of the interrupt measurements (ticks)
+#ifndef PERF_WINDOW
+#define PERF_WINDOW         (pdMS_TO_TICKS(1000))
+#endif
+
+/**
+ * @brief   Statistics of a measurement (cycles)
+ */
+typedef struct {
+    uint32_t    n;
+    uint32_t    min;
+    uint32_t    max;
+    uint64_t    sum;
+} PerfStat_t;
+
+/**
+ * @brief   Results of Perf_Measure
+ */
+typedef struct {
+    PerfStat_t  switchto;
+    PerfStat_t  switchback;
+    PerfStat_t  irqlatency;
+    PerfStat_t  irqtotask;
+} PerfResults_t;
+
+/**
+ * @fn      Perf_Init
+ * @brief   Creates the helper task (static memory) and configures TIMER1
+ *
+ * @return  handle of the helper task
+ */
+TaskHandle_t Perf_Init(void);
+
+/**
+ * @fn      Perf_Measure
+ * @brief   Measures n task switches, then the interrupts during PERF_WINDOW
+ *
+ * @note    Must be called by a task with priority below PERF_PRIORITY
+ */
+void Perf_Measure(uint32_t n, PerfResults_t *results);
+
+/**
+ * @fn      Perf_Average
+ * @brief   Returns the average of a statistics, 0 if it is empty
+ */
+uint32_t Perf_Average(const PerfStat_t *stat);
+
+#endif // PERF_H
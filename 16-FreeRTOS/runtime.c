@@ -0,0 +1,124 @@
+/**
+ * @file    runtime.c
+ * @brief   Run time counter and context switch counts for the FreeRTOS statistics
+ *
+ * @note    RunTime_GetCounter is called by the kernel in each context switch,
+ *          with the interrupts masked, and by uxTaskGetSystemState. The
+ *          interrupts are masked while the extended counter is updated.
+ *
+ * @note    RunTime_SleepBegin and RunTime_SleepEnd are called by the idle
+ *          task, with the scheduler suspended, around vPortSuppressTicksAndSleep.
+ *          If the cycle counter counted less than the time measured by the
+ *          RTC, the difference is added.
+ */
+
+#include <stdint.h>
+#include "em_device.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "runtime.h"
+#include "tickless.h"
+
+/**
+ * @brief   Global variables
+ */
+///@{
+static uint64_t cycles = 0;             ///< cycles since RunTime_Init, including sleep
+static uint32_t last = 0;               ///< last value read from the cycle counter
+static uint64_t cyclesbefore = 0;       ///< cycles at the start of the sleep
+static uint64_t sleepstart = 0;         ///< RTC counts at the start of the sleep
+static uint32_t switches[RUNTIME_MAXTASKS];
+///@}
+
+/**
+ * @brief   Adds the cycles counted since the last call
+ *
+ * @note    Must be called with interrupts masked
+ */
+
+static void update(void) {
+uint32_t now = DWT->CYCCNT;
+
+    cycles += now-last;
+    last = now;
+}
+
+/**
+ * @details Called by vTaskStartScheduler. The cycle counter is not cleared,
+ *          since idlemeter.c uses it too
+ */
+
+void RunTime_Init(void) {
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    last   = DWT->CYCCNT;
+    cycles = 0;
+}
+
+uint32_t RunTime_GetCounter(void) {
+UBaseType_t mask;
+uint32_t c;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    update();
+    c = (uint32_t) (cycles>>RUNTIME_SHIFT);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    return c;
+}
+
+/**
+ * @details Counter increments per second
+ */
+
+uint32_t RunTime_GetFrequency(void) {
+
+    return SystemCoreClock>>RUNTIME_SHIFT;
+}
+
+/**
+ * @details Called by the kernel with the number (uxTCBNumber) of the task
+ *          that will run
+ */
+
+void RunTime_SwitchedIn(uint32_t tasknumber) {
+
+    if( tasknumber >= RUNTIME_MAXTASKS )
+        tasknumber = 0;
+    switches[tasknumber]++;
+}
+
+uint32_t RunTime_GetSwitches(uint32_t tasknumber) {
+
+    if( tasknumber >= RUNTIME_MAXTASKS )
+        tasknumber = 0;
+    return switches[tasknumber];
+}
+
+void RunTime_SleepBegin(void) {
+TicklessTimes_t t;
+UBaseType_t mask;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    update();
+    cyclesbefore = cycles;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    Tickless_GetTimes(&t);
+    sleepstart = t.total;
+}
+
+void RunTime_SleepEnd(void) {
+TicklessTimes_t t;
+UBaseType_t mask;
+uint64_t slept;
+
+    Tickless_GetTimes(&t);
+    slept = (t.total-sleepstart)*SystemCoreClock/LPTIMER_HZ;
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    update();
+    if( slept > cycles-cyclesbefore )
+        cycles = cyclesbefore+slept;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
@@ -0,0 +1,46 @@
+#ifndef RUNTIME_H
+#define RUNTIME_H
+/**
+ * @file    runtime.h
+ * @brief   Run time counter and context switch counts for the FreeRTOS statistics
+ *
+ * @note    Used by the macros in FreeRTOSConfig.h:
+ *          - portCONFIGURE_TIMER_FOR_RUN_TIME_STATS calls RunTime_Init
+ *          - portGET_RUN_TIME_COUNTER_VALUE calls RunTime_GetCounter
+ *          - traceTASK_SWITCHED_IN calls RunTime_SwitchedIn
+ *          - traceLOW_POWER_IDLE_BEGIN/END call RunTime_SleepBegin/End
+ *
+ * @note    The counter is the cycle counter (DWT), extended to 64 bits and
+ *          divided by 2^RUNTIME_SHIFT. The cycle counter stops in sleep, so
+ *          the time slept, measured by the RTC (tickless.h), is added on
+ *          wake-up. It is given to the idle task, which was running.
+ *
+ * @note    The counter must be read at least every 2^32 cycles (89 s at
+ *          48 MHz). Each context switch and each sleep reads it.
+ *
+ * @note    The 32 bit value returned wraps around after 2^(32+RUNTIME_SHIFT)
+ *          cycles (47 min). The statistics must be computed as differences
+ *          in a shorter interval.
+ */
+
+#include <stdint.h>
+
+/// Run time counter unit is 2^RUNTIME_SHIFT cycles
+#ifndef RUNTIME_SHIFT
+#define RUNTIME_SHIFT       (5)
+#endif
+
+/// Tasks with a larger number (uxTCBNumber) are counted together in 0
+#ifndef RUNTIME_MAXTASKS
+#define RUNTIME_MAXTASKS    (16)
+#endif
+
+void        RunTime_Init(void);
+uint32_t    RunTime_GetCounter(void);
+uint32_t    RunTime_GetFrequency(void);
+void        RunTime_SwitchedIn(uint32_t tasknumber);
+uint32_t    RunTime_GetSwitches(uint32_t tasknumber);
+void        RunTime_SleepBegin(void);
+void        RunTime_SleepEnd(void);
+
+#endif // RUNTIME_H
@@ -0,0 +1,295 @@
+/**
+ * @file    serial.c
+ * @brief   Interrupt driven serial driver for FreeRTOS (UART0)
+ *
+ * @note    Configure UART0 to work at 115200 bps, 8 bit, no parity, 1 stop bit
+ *          no parity handshake. It communicates with the board controller,
+ *          which relays data to a Virtual COM port in the USB connection.
+ *
+ * @note    Receive: the interrupt puts the chars in a stream buffer. A task
+ *          blocked in xStreamBufferReceive is woken by the kernel when the
+ *          first char arrives.
+ *
+ * @note    Transmit: Serial_Write keeps a pointer to the data and enables the
+ *          TXBL interrupt. The interrupt writes the chars while the transmit
+ *          buffer has space. After the last one, it waits for the end of the
+ *          transmission (TXC) and gives the txdone semaphore, taken by the
+ *          writer. There is no intermediate buffer.
+ *
+ * @note    A binary semaphore is used instead of a task notification, so the
+ *          notification of the writer is left to the application. A
+ *          notification sent to it while it writes does not end the wait
+ *          before TXC, when the interrupt still uses its buffer.
+ *
+ * @note    The UART stops in EM2. EM2 is blocked (tickless.h) while a task
+ *          waits for input and while a transmission is not complete.
+ *
+ * @note    The interrupt level must not be above (numerically below)
+ *          configMAX_SYSCALL_INTERRUPT_PRIORITY, since the FromISR functions
+ *          are called.
+ */
+
+#include <stdint.h>
+/*
+ * Including this file, it is possible to define which processor using command line
+ * E.g. -DEFM32GG995F1024
+ * The alternative is to include the processor specific file directly
+ * #include "efm32gg995f1024.h"
+ */
+#include "em_device.h"
+#include "clock_efm32gg.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+
+#include "serial.h"
+#include "tickless.h"
+#include "trace.h"
+
+/**
+ * @brief   Macros to enhance portability
+ */
+#define BIT(N) (1U<<(N))
+
+/**
+ * @brief   Configuration
+ */
+/// Interrupt level (must be numerically >= configMAX_SYSCALL_INTERRUPT_PRIORITY>>5)
+#define RXINTLEVEL 6
+#define TXINTLEVEL 6
+
+/// baudrate
+static const uint32_t BAUD = 115200;
+static const uint32_t OVERSAMPLING = 16;
+
+/// GPIO Port used for RX/TX
+static GPIO_P_TypeDef * const GPIOE = &(GPIO->P[4]);    // GPIOE
+/// GPIO Port used for enable transceiver
+static GPIO_P_TypeDef * const GPIOF = &(GPIO->P[5]);    // GPIOF
+
+/**
+ * @brief   Global variables
+ *
+ * @note    The stream buffer and the semaphores are in static memory
+ */
+///@{
+static StaticStreamBuffer_t rxstreambuffer;
+static uint8_t              rxstreamarea[SERIAL_RXBUFFERSIZE+1];
+static StaticSemaphore_t    txmutexbuffer;
+static StaticSemaphore_t    txdonebuffer;
+static StreamBufferHandle_t rxstream = 0;
+static SemaphoreHandle_t    txmutex = 0;
+static SemaphoreHandle_t    txdone = 0;         ///< given by the interrupt at TXC
+static const char * volatile txptr = 0;
+static volatile int         txcount = 0;
+static volatile int         txwaiting = 0;      ///< a task waits for txdone
+static volatile uint32_t    overruns = 0;
+///@}
+
+/**
+ * @brief   Tells if the calling task can block
+ */
+
+static inline int CanBlock(void) {
+    return (__get_IPSR() == 0) && (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING);
+}
+
+/**
+ * @details Creates the stream buffer and the semaphores only in the first call.
+ *          Only enables the receive interrupt. The transmit interrupt is
+ *          enabled by Serial_Write
+ */
+
+void Serial_Init(void) {
+uint32_t bauddiv;
+
+    if( rxstream == 0 )
+        rxstream = xStreamBufferCreateStatic(SERIAL_RXBUFFERSIZE,1,rxstreamarea,&rxstreambuffer);
+    if( txmutex == 0 ) {
+        txmutex = xSemaphoreCreateMutexStatic(&txmutexbuffer);
+        Trace_NameQueue(txmutex,"Tx");
+    }
+    if( txdone == 0 ) {
+        txdone = xSemaphoreCreateBinaryStatic(&txdonebuffer);
+        Trace_NameQueue(txdone,"TxDone");
+    }
+
+    /* Enable Clock for GPIO and UART */
+    CMU->HFPERCLKDIV |= CMU_HFPERCLKDIV_HFPERCLKEN;     // Enable HFPERCLK
+    CMU->HFPERCLKEN0 |= CMU_HFPERCLKEN0_GPIO;           // Enable HFPERCLK for GPIO
+
+    // Configure PE0 (TX)
+    GPIOE->MODEL &= ~_GPIO_P_MODEL_MODE0_MASK;          // Clear field
+    GPIOE->MODEL |= GPIO_P_MODEL_MODE0_PUSHPULL;        // Set field
+    GPIOE->DOUT  |= BIT(0);
+
+    // Configure PE1 (RX)
+    GPIOE->MODEL &= ~_GPIO_P_MODEL_MODE1_MASK;          // Clear field
+    GPIOE->MODEL |= GPIO_P_MODEL_MODE1_INPUT;           // Set field
+    GPIOE->DOUT  |= BIT(1);
+
+    // Enable clock for UART0
+    CMU->HFPERCLKEN0 |= CMU_HFPERCLKEN0_UART0;          // Enable HFPERCLK for UART0
+
+    /* Make sure disabled first, before resetting other registers */
+    UART0->CMD = UART_CMD_RXDIS | UART_CMD_TXDIS | UART_CMD_MASTERDIS
+                | UART_CMD_RXBLOCKDIS | UART_CMD_TXTRIDIS | UART_CMD_CLEARTX
+                | UART_CMD_CLEARRX;
+    UART0->CTRL      = _UART_CTRL_RESETVALUE;
+    UART0->FRAME     = _UART_FRAME_RESETVALUE;
+    UART0->TRIGCTRL  = _UART_TRIGCTRL_RESETVALUE;
+    UART0->CLKDIV    = _UART_CLKDIV_RESETVALUE;
+    UART0->IEN       = _UART_IEN_RESETVALUE;
+    UART0->IFC       = _UART_IFC_MASK;
+    UART0->ROUTE     = _UART_ROUTE_RESETVALUE;
+    UART0->IRCTRL    = _UART_IRCTRL_RESETVALUE;
+    UART0->INPUT     = _UART_INPUT_RESETVALUE;
+
+    // 8 bits, no parity, 1 stop bit
+    UART0->FRAME =    UART_FRAME_STOPBITS_ONE
+                    | UART_FRAME_PARITY_NONE
+                    | UART_FRAME_DATABITS_EIGHT;
+
+    // Asynchronous with 16x oversampling
+    UART0->CTRL  = _UART_CTRL_RESETVALUE|UART_CTRL_OVS_X16;
+
+    // Baud rate
+    bauddiv = (GetHFPeripheralClockFrequency()*4)/(OVERSAMPLING*BAUD)-4;
+    UART0->CLKDIV = bauddiv<<_UART_CLKDIV_DIV_SHIFT;
+
+    // Configure PF7 (Enable Transceiver)
+    GPIOF->MODEL &= ~_GPIO_P_MODEL_MODE7_MASK;          // Clear field
+    GPIOF->MODEL |= GPIO_P_MODEL_MODE7_PUSHPULL;        // Set field
+    GPIOF->DOUT  |= BIT(7);
+
+    // Set which location to be used
+    UART0->ROUTE = UART_ROUTE_LOCATION_LOC1 | UART_ROUTE_RXPEN | UART_ROUTE_TXPEN;
+
+    // Enable receive interrupt on UART
+    UART0->IFC = (uint32_t) -1;
+    UART0->IEN = UART_IEN_RXDATAV;
+
+    // Enable interrupts on NVIC
+    NVIC_SetPriority(UART0_RX_IRQn,RXINTLEVEL);
+    NVIC_SetPriority(UART0_TX_IRQn,TXINTLEVEL);
+    NVIC_ClearPendingIRQ(UART0_RX_IRQn);
+    NVIC_ClearPendingIRQ(UART0_TX_IRQn);
+    NVIC_EnableIRQ(UART0_RX_IRQn);
+    NVIC_EnableIRQ(UART0_TX_IRQn);
+
+    // Enable RX and TX
+    UART0->CMD  = UART_CMD_TXEN|UART_CMD_RXEN;
+}
+
+/**
+ * @brief   UART Interrupt routine for receiving data
+ *
+ * @note    Puts the chars in the stream buffer. The kernel wakes the reader
+ */
+
+void UART0_RX_IRQHandler(void) {
+BaseType_t woken = pdFALSE;
+char ch;
+
+    TRACE_ISR_ENTER();
+    while( UART0->STATUS&UART_STATUS_RXDATAV ) {
+        ch = UART0->RXDATA;
+        if( xStreamBufferSendFromISR(rxstream,&ch,1,&woken) != 1 )
+            overruns++;
+    }
+    TRACE_ISR_EXIT();
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief   UART Interrupt routine for transmitting data
+ *
+ * @note    Called while the transmit buffer has space (TXBL). After the last
+ *          char, waits for the transmission to complete (TXC). Then allows
+ *          EM2 and gives txdone to the writer
+ */
+
+void UART0_TX_IRQHandler(void) {
+BaseType_t woken = pdFALSE;
+
+    TRACE_ISR_ENTER();
+    if( (UART0->IEN&UART_IEN_TXC) && (UART0->IF&UART_IF_TXC) ) {
+        UART0->IEN &= ~UART_IEN_TXC;
+        UART0->IFC = UART_IFC_TXC;
+        Tickless_UnblockEM2();
+        if( txwaiting ) {
+            txwaiting = 0;
+            (void) xSemaphoreGiveFromISR(txdone,&woken);
+        }
+    } else {
+        while( txcount && (UART0->STATUS&UART_STATUS_TXBL) ) {
+            UART0->TXDATA = *txptr++;
+            txcount--;
+        }
+        if( txcount == 0 ) {
+            UART0->IEN &= ~UART_IEN_TXBL;
+            UART0->IFC = UART_IFC_TXC;                  // last char is being sent
+            UART0->IEN |= UART_IEN_TXC;
+        }
+    }
+    TRACE_ISR_EXIT();
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @details Blocks in the stream buffer until there is at least one char.
+ *          EM2 is blocked meanwhile, since the UART does not receive in EM2
+ */
+
+int Serial_Read(char *buf, int len, TickType_t timeout) {
+int n;
+
+    Tickless_BlockEM2();
+    n = (int) xStreamBufferReceive(rxstream,buf,len,timeout);
+    Tickless_UnblockEM2();
+    return n;
+}
+
+int Serial_GetChar(TickType_t timeout) {
+char ch;
+
+    if( Serial_Read(&ch,1,timeout) == 0 )
+        return -1;
+    return (unsigned char) ch;
+}
+
+/**
+ * @details When the task can not block, sends polling the TXBL flag
+ */
+
+int Serial_Write(const char *buf, int len) {
+int i;
+
+    if( len <= 0 )
+        return 0;
+
+    if( !CanBlock() ) {
+        for(i=0;i<len;i++) {
+            while( (UART0->STATUS&UART_STATUS_TXBL) == 0 ) {}
+            UART0->TXDATA = buf[i];
+        }
+        return len;
+    }
+
+    (void) xSemaphoreTake(txmutex,portMAX_DELAY);
+    txwaiting = 1;
+    txptr     = buf;
+    txcount   = len;
+    Tickless_BlockEM2();                            // unblocked by the interrupt
+    UART0->IEN |= UART_IEN_TXBL;                    // interrupt starts at once
+    (void) xSemaphoreTake(txdone,portMAX_DELAY);
+    (void) xSemaphoreGive(txmutex);
+    return len;
+}
+
+uint32_t Serial_GetOverruns(void) {
+
+    return overruns;
+}
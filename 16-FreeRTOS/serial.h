@@ -0,0 +1,68 @@
+#ifndef SERIAL_H
+#define SERIAL_H
+/**
+ * @file    serial.h
+ * @brief   Interrupt driven serial driver for FreeRTOS (UART0)
+ *
+ * @note    A task waiting for data or for the end of a transmission is
+ *          blocked and uses no CPU. Received chars go to a stream buffer.
+ *          Serial_Write hands the data to the transmit interrupt and waits
+ *          on a semaphore telling it was all sent. The task notification of
+ *          the writer is not used.
+ *
+ * @note    While a task waits for input or a transmission is in progress,
+ *          the processor does not sleep in EM2 (see tickless.h).
+ *
+ * @note    Serial_Read and Serial_GetChar must only be called by tasks.
+ *          Serial_Write can be called anywhere. Before the scheduler starts,
+ *          with it suspended or in interrupts, it waits for each char (polling).
+ */
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+/// Size of the receive stream buffer (bytes)
+#ifndef SERIAL_RXBUFFERSIZE
+#define SERIAL_RXBUFFERSIZE (64)
+#endif
+
+/**
+ * @fn      Serial_Init
+ * @brief   Configures UART0 for 115200 bps, 8 bits, no parity, 1 stop bit
+ *
+ * @note    Must be called again after changing the clock frequency
+ */
+void Serial_Init(void);
+
+/**
+ * @fn      Serial_Read
+ * @brief   Reads up to len chars, waiting at most timeout ticks for the first one
+ *
+ * @return  number of chars read. 0 if timeout
+ */
+int Serial_Read(char *buf, int len, TickType_t timeout);
+
+/**
+ * @fn      Serial_GetChar
+ * @brief   Reads a char, waiting at most timeout ticks
+ *
+ * @return  the char or -1 if timeout
+ */
+int Serial_GetChar(TickType_t timeout);
+
+/**
+ * @fn      Serial_Write
+ * @brief   Sends len chars and returns when they were all given to the UART
+ *
+ * @note    Writes of different tasks are not mixed
+ */
+int Serial_Write(const char *buf, int len);
+
+/**
+ * @fn      Serial_GetOverruns
+ * @brief   Returns the number of chars lost because the stream buffer was full
+ */
+uint32_t Serial_GetOverruns(void);
+
+#endif // SERIAL_H
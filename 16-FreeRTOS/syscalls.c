@@ -2,9 +2,19 @@
  * @file syscalls.c
  *
  * @note    Following 11. System Calls in Newlib LibC documentation
+ *
+ * @note    Reentrancy in FreeRTOS
+ *          - Each task has its own struct _reent (configUSE_NEWLIB_REENTRANT),
+ *            so each one has its own errno and its own stdout buffer.
+ *          - malloc and the environment are protected by suspending the scheduler.
+ *          - _write sends the whole buffer with Serial_Write, which holds a
+ *            mutex. As stdout is line buffered, lines written by different
+ *            tasks are not mixed.
+ *          - _read blocks the task until a char arrives, using no CPU.
  */
 
 #include <stdlib.h>
+#include <reent.h>
 #include <sys/stat.h>
 #include <sys/times.h>
 
@@ -40,6 +50,13 @@ extern int errno;
 
 #include "em_device.h"
 
+/**
+ * @brief   including FreeRTOS functions
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
 /**
  * @brief compatibility layer
  */
@@ -56,12 +73,28 @@ static inline char * GetStackPointer(void) { return (char *) __get_MSP(); }
  *
  */
 //@{
-#include "uart.h"
+#include "serial.h"
 
-void SerialInit(void)           { UART_Init();                }
-void SerialWrite(char c)        { UART_SendChar(c);           }
-int  SerialRead(void)           { return UART_GetChar();  }
-int  SerialStatus(void)         { return UART_GetStatus();    }
+void SerialInit(void)                       { Serial_Init();                    }
+int  SerialWrite(char *s, int n)            { return Serial_Write(s,n);         }
+int  SerialRead(char *s, int n)             { return Serial_Read(s,n,portMAX_DELAY); }
+//@}
+
+/**
+ * @brief   Locks for newlib
+ *
+ * @note    Before the scheduler starts and in interrupts there is no locking
+ */
+//@{
+static inline int KernelStarted(void) {
+    return (__get_IPSR() == 0) && (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED);
+}
+
+// vTaskSuspendAll can be nested, as newlib does with __malloc_lock
+void __malloc_lock(struct _reent *r)    { if( KernelStarted() ) vTaskSuspendAll();        }
+void __malloc_unlock(struct _reent *r)  { if( KernelStarted() ) (void) xTaskResumeAll();  }
+void __env_lock(struct _reent *r)       { if( KernelStarted() ) vTaskSuspendAll();        }
+void __env_unlock(struct _reent *r)     { if( KernelStarted() ) (void) xTaskResumeAll();  }
 //@}
 
 /**
@@ -208,11 +241,21 @@ int _open(const char *name, int flags, int mode) {
 /**
  * @brief   read
  *
- * @note    Read from a file. Minimal implementation.
+ * @note    Read from a file. Waits for at least one char from the serial
+ *          interface. CR is changed to LF and chars are echoed, so fgets
+ *          works in a terminal.
  */
 
 int _read(int file, char *ptr, int len) {
-    return 0;
+int n,i;
+
+    n = SerialRead(ptr,len);
+    for(i=0;i<n;i++) {
+        if( ptr[i] == '\r' )
+            ptr[i] = '\n';
+    }
+    (void) SerialWrite(ptr,n);
+    return n;
 }
 
 /**
@@ -298,10 +341,6 @@ int _wait(int *status) {
  */
 
 int _write(int file, char *ptr, int len) {
-    int todo;
 
-    for (todo = 0; todo < len; todo++) {
-        SerialWrite(*ptr++);
-    }
-    return len;
+    return SerialWrite(ptr,len);
 }
@@ -6,6 +6,7 @@
  * @note    Following 11. System Calls in Newlib LibC documentation
  */
 #include <stdlib.h>
+#include <reent.h>
 #include <sys/stat.h>
 #include <sys/times.h>
 
@@ -30,4 +31,9 @@ int _unlink(char *name);
 int _wait(int *status);
 int _write(int file, char *ptr, int len);
 
+void __malloc_lock(struct _reent *r);
+void __malloc_unlock(struct _reent *r);
+void __env_lock(struct _reent *r);
+void __env_unlock(struct _reent *r);
+
 #endif
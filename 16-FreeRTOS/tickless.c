@@ -0,0 +1,200 @@
+/**
+ * @file    tickless.c
+ * @brief   FreeRTOS tick and tickless idle using the low power timer (RTC)
+ *
+ * @note    The low power timer is free running. counts accumulates its
+ *          increments, so it does not wrap around. The tick n happens when
+ *          counts reaches n*TICKLESS_COUNTSPERTICK. The compare is always set
+ *          to the next tick, or to the tick that ends the sleep. There is no
+ *          drift, since the counter is never stopped or written.
+ *
+ * @note    The tick interrupt uses the lowest level (configKERNEL_INTERRUPT_PRIORITY),
+ *          as SysTick would. SysTick is not started.
+ *
+ * @note    vPortSuppressTicksAndSleep is called by the idle task with the
+ *          scheduler suspended. Interrupts are disabled (PRIMASK) from the
+ *          confirmation of the sleep until the ticks slept are accounted for.
+ *          The pending interrupt wakes the processor and runs after that.
+ */
+
+#include <stdint.h>
+#include "em_device.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "lptimer.h"
+#include "tickless.h"
+
+/**
+ * @brief   Macros to enhance portability
+ */
+#define LOAD_EXCLUSIVE(A)       __LDREXW((volatile uint32_t *)(A))
+#define STORE_EXCLUSIVE(V,A)    __STREXW((uint32_t)(V),(volatile uint32_t *)(A))
+
+/**
+ * @brief   Global variables
+ *
+ * @note    Changed only with interrupts disabled or in the tick interrupt
+ */
+///@{
+static uint64_t             counts = 0;         ///< counts since the start
+static uint32_t             lastcounter = 0;    ///< last value read from the counter
+static uint64_t             ticks = 0;          ///< ticks given to the kernel
+static uint64_t             em1counts = 0;
+static uint64_t             em2counts = 0;
+static volatile uint32_t    em2blocks = 0;
+///@}
+
+static void
+readcounter(void) {
+uint32_t c = LPTimer_Read();
+
+    counts += (c-lastcounter)&LPTIMER_MASK;
+    lastcounter = c;
+}
+
+/**
+ * @brief   Sets compare for the tick ticks+k
+ *
+ * @note    Must be called with interrupts disabled or from the interrupt
+ */
+
+static void
+program(uint32_t k) {
+uint64_t target;
+
+    target = (ticks+k)*TICKLESS_COUNTSPERTICK;
+    readcounter();
+    if( target < counts+LPTIMER_MINDELTA )
+        target = counts+LPTIMER_MINDELTA;
+    LPTimer_SetCompare(lastcounter+(uint32_t) (target-counts));
+}
+
+/**
+ * @brief   Called by the low power timer interrupt
+ *
+ * @note    Gives the kernel all ticks elapsed since the last call. Normally
+ *          one
+ */
+
+static void
+update(void) {
+UBaseType_t mask;
+BaseType_t yield = pdFALSE;
+uint64_t t;
+
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    readcounter();
+    t = counts/TICKLESS_COUNTSPERTICK;
+    while( ticks < t ) {
+        if( xTaskIncrementTick() != pdFALSE )
+            yield = pdTRUE;
+        ticks++;
+    }
+    program(1);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    portYIELD_FROM_ISR(yield);
+}
+
+/**
+ * @brief   Replaces the SysTick configuration of port.c
+ *
+ * @note    Called by vTaskStartScheduler with interrupts disabled
+ */
+
+void vPortSetupTimerInterrupt(void) {
+
+    configASSERT( (LPTIMER_HZ%configTICK_RATE_HZ) == 0 );
+    LPTimer_Init(update);
+    lastcounter = LPTimer_Read();
+    counts = 0;
+    ticks  = 0;
+    program(1);
+}
+
+/**
+ * @brief   Sleeps until the tick ticks+expected or an interrupt
+ *
+ * @note    When woken by the compare, the interrupt gives the last tick.
+ *          Otherwise the compare is set again to the next tick
+ */
+
+void vPortSuppressTicksAndSleep(TickType_t expected) {
+uint64_t start,t;
+uint32_t step;
+int deep;
+
+    if( expected > TICKLESS_MAXSLEEP )
+        expected = TICKLESS_MAXSLEEP;
+
+    __disable_irq();
+    readcounter();
+    if( (eTaskConfirmSleepModeStatus() == eAbortSleep)
+      || (counts/TICKLESS_COUNTSPERTICK > ticks) ) {    // tick interrupt pending
+        __enable_irq();
+        return;
+    }
+
+    program(expected);
+    deep  = (em2blocks == 0);
+    start = counts;
+    LPTimer_Sleep(deep);
+
+    readcounter();
+    if( deep )
+        em2counts += counts-start;
+    else
+        em1counts += counts-start;
+
+    t = counts/TICKLESS_COUNTSPERTICK;
+    if( t-ticks >= expected ) {
+        step = expected-1;
+        ticks += step;
+    } else {
+        step = (uint32_t) (t-ticks);
+        ticks += step;
+        program(1);
+    }
+    if( step > 0 )
+        vTaskStepTick(step);
+    __enable_irq();
+}
+
+/**
+ * @details Increments with LDREX/STREX, so it can be called by interrupts
+ */
+
+void Tickless_BlockEM2(void) {
+uint32_t v;
+
+    do {
+        v = LOAD_EXCLUSIVE(&em2blocks);
+    } while( STORE_EXCLUSIVE(v+1,&em2blocks) );
+}
+
+void Tickless_UnblockEM2(void) {
+uint32_t v;
+
+    do {
+        v = LOAD_EXCLUSIVE(&em2blocks);
+        if( v == 0 ) {
+            __CLREX();
+            return;
+        }
+    } while( STORE_EXCLUSIVE(v-1,&em2blocks) );
+}
+
+/**
+ * @details The tick interrupt is masked while reading
+ */
+
+void Tickless_GetTimes(TicklessTimes_t *times) {
+
+    taskENTER_CRITICAL();
+    readcounter();
+    times->total = counts;
+    times->em1   = em1counts;
+    times->em2   = em2counts;
+    taskEXIT_CRITICAL();
+}
@@ -0,0 +1,67 @@
+#ifndef TICKLESS_H
+#define TICKLESS_H
+/**
+ * @file    tickless.h
+ * @brief   FreeRTOS tick and tickless idle using the low power timer (RTC)
+ *
+ * @note    Needs configUSE_TICKLESS_IDLE set to 1. tickless.c replaces the
+ *          weak vPortSetupTimerInterrupt and vPortSuppressTicksAndSleep of
+ *          port.c. The tick comes from the RTC (lptimer.h), not from SysTick,
+ *          so it keeps counting in EM2.
+ *
+ * @note    When all tasks are blocked for at least
+ *          configEXPECTED_IDLE_TIME_BEFORE_SLEEP ticks, the processor sleeps
+ *          until the next task is unblocked or an interrupt happens. Then
+ *          the tick count is advanced by the time slept (vTaskStepTick).
+ *
+ * @note    It sleeps in EM2 unless a driver needs the high frequency clocks
+ *          (UART, TIMER) and called Tickless_BlockEM2. Then it sleeps in EM1.
+ */
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "lptimer.h"
+
+/// Low power timer counts per tick. configTICK_RATE_HZ must divide LPTIMER_HZ
+#define TICKLESS_COUNTSPERTICK  (LPTIMER_HZ/configTICK_RATE_HZ)
+
+/// Maximum sleep (ticks). Must be less than the low power timer wrap around
+#ifndef TICKLESS_MAXSLEEP
+#define TICKLESS_MAXSLEEP       (256*configTICK_RATE_HZ)
+#endif
+
+/**
+ * @brief   Time spent in each energy mode (low power timer counts)
+ *
+ * @note    EM0 (running) is total-em1-em2
+ */
+typedef struct {
+    uint64_t    total;
+    uint64_t    em1;
+    uint64_t    em2;
+} TicklessTimes_t;
+
+/**
+ * @fn      Tickless_BlockEM2
+ * @brief   Prevents sleeping in EM2, until Tickless_UnblockEM2 is called
+ *
+ * @note    Calls are counted. Can be called by interrupts
+ */
+void Tickless_BlockEM2(void);
+
+/**
+ * @fn      Tickless_UnblockEM2
+ * @brief   Undoes one call of Tickless_BlockEM2
+ */
+void Tickless_UnblockEM2(void);
+
+/**
+ * @fn      Tickless_GetTimes
+ * @brief   Returns the time spent in each energy mode since the scheduler started
+ *
+ * @note    Only called by tasks
+ */
+void Tickless_GetTimes(TicklessTimes_t *times);
+
+#endif // TICKLESS_H
@@ -0,0 +1,321 @@
+/**
+ * @file    trace2json.c
+ * @brief   Converts a trace dump of 16-FreeRTOS (t command) to a Chrome trace
+ *
+ * @note    Host program. Build and use:
+ *
+ *              gcc -O2 -o trace2json trace2json.c
+ *              ./trace2json terminal.log > trace.json
+ *
+ *          The input is the terminal log. Lines before #TRACE and after #END
+ *          are ignored. The output can be opened in chrome://tracing or in
+ *          ui.perfetto.dev.
+ *
+ * @note    Each task, each interrupt and the sleep are a thread. Task
+ *          switches, interrupts and sleeps are slices, queue operations are
+ *          instant events in the thread that did them and the number of
+ *          messages of each queue is a counter.
+ *
+ * @note    The time line is rebuilt from the differences of the cycle
+ *          counter, which wraps around, plus the time slept given by the
+ *          wake-up records.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief   Events. Must match trace.h
+ */
+///@{
+#define TRACE_EV_SWITCH                (1)
+#define TRACE_EV_QUEUE_SEND            (2)
+#define TRACE_EV_QUEUE_SEND_FAILED     (3)
+#define TRACE_EV_QUEUE_RECEIVE         (4)
+#define TRACE_EV_QUEUE_RECEIVE_FAILED  (5)
+#define TRACE_EV_QUEUE_BLOCK_SEND      (6)
+#define TRACE_EV_QUEUE_BLOCK_RECEIVE   (7)
+#define TRACE_EV_ISR_ENTER             (8)
+#define TRACE_EV_ISR_EXIT              (9)
+#define TRACE_EV_SLEEP                 (10)
+#define TRACE_EV_WAKE                  (11)
+///@}
+
+/**
+ * @brief   Thread ids of the interrupts and of the sleep
+ */
+///@{
+#define TID_ISR         (1000)
+#define TID_SLEEP       (999)
+#define MAXNESTING      (8)
+///@}
+
+/// Interrupt names of the EFM32GG (startup_efm32gg.c)
+static const char *irqnames[] = {
+    "DMA",      "GPIO_EVEN","TIMER0",   "USART0_RX","USART0_TX","USB",
+    "ACMP0",    "ADC0",     "DAC0",     "I2C0",     "I2C1",     "GPIO_ODD",
+    "TIMER1",   "TIMER2",   "TIMER3",   "USART1_RX","USART1_TX","LESENSE",
+    "USART2_RX","USART2_TX","UART0_RX", "UART0_TX", "UART1_RX", "UART1_TX",
+    "LEUART0",  "LEUART1",  "LETIMER0", "PCNT0",    "PCNT1",    "PCNT2",
+    "RTC",      "BURTC",    "CMU",      "VCMP",     "LCD",      "MSC",
+    "AES",      "EBI",      "EMU"
+};
+#define NIRQNAMES   (sizeof(irqnames)/sizeof(irqnames[0]))
+
+/**
+ * @brief   Global variables
+ */
+///@{
+static char     tasknames[256][32];
+static char     queuenames[256][32];
+static int      irqused[256];
+static double   cpuhz = 48000000.0;
+static double   rtchz = 32768.0;
+static int      nevents = 0;            ///< events written, for the commas
+///@}
+
+/**
+ * @brief   Prints the start of an event, with a comma when needed
+ */
+
+static void Begin(void) {
+
+    printf("%s\n  ",nevents?",":"");
+    nevents++;
+}
+
+/**
+ * @brief   Prints a name as a JSON string
+ */
+
+static void PrintString(const char *s) {
+
+    putchar('"');
+    for(;*s;s++) {
+        if( *s == '"' || *s == '\\' )
+            putchar('\\');
+        if( (unsigned char) *s >= ' ' )
+            putchar(*s);
+    }
+    putchar('"');
+}
+
+static const char *TaskName(unsigned n) {
+static char buf[32];
+
+    if( tasknames[n&0xFF][0] )
+        return tasknames[n&0xFF];
+    snprintf(buf,sizeof(buf),"Task %u",n);
+    return buf;
+}
+
+static const char *QueueName(unsigned n) {
+static char buf[32];
+
+    if( queuenames[n&0xFF][0] )
+        return queuenames[n&0xFF];
+    snprintf(buf,sizeof(buf),"Queue %u",n);
+    return buf;
+}
+
+static const char *IRQName(unsigned n) {
+static char buf[32];
+
+    if( n < NIRQNAMES )
+        return irqnames[n];
+    snprintf(buf,sizeof(buf),"IRQ %u",n);
+    return buf;
+}
+
+/**
+ * @brief   Prints a slice begin (B) or end (E)
+ */
+
+static void Slice(char ph, int tid, const char *name, double ts) {
+
+    Begin();
+    printf("{\"ph\":\"%c\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"name\":",ph,tid,ts);
+    PrintString(name);
+    printf("}");
+}
+
+/**
+ * @brief   Prints a queue operation and, when known, the queue level
+ */
+
+static void Queue(int tid, const char *op, unsigned q, int messages, double ts) {
+char name[64];
+
+    snprintf(name,sizeof(name),"%s %s",op,QueueName(q));
+    Begin();
+    printf("{\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"name\":",tid,ts);
+    PrintString(name);
+    if( messages < 0 ) {
+        printf("}");
+        return;
+    }
+    printf(",\"args\":{\"messages\":%d}}",messages);
+    snprintf(name,sizeof(name),"Queue %s",QueueName(q));
+    Begin();
+    printf("{\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"name\":",ts);
+    PrintString(name);
+    printf(",\"args\":{\"messages\":%d}}",messages);
+}
+
+/**
+ * @brief   Prints the thread names
+ */
+
+static void ThreadName(int tid, const char *name, int order) {
+
+    Begin();
+    printf("{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":",tid);
+    PrintString(name);
+    printf("}}");
+    Begin();
+    printf("{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_sort_index\","
+           "\"args\":{\"sort_index\":%d}}",tid,order);
+}
+
+int main(int argc, char *argv[]) {
+FILE *in = stdin;
+char line[256],name[64];
+unsigned long a,b,c,d;
+unsigned event,id,arg,n,i;
+uint32_t time,last = 0;
+double ts = 0.0;
+int started = 0,first = 1;
+int task = -1;                          ///< task running
+int sleeping = 0;
+int isr[MAXNESTING],nesting = 0;
+int tid;
+
+    if( argc > 1 ) {
+        in = fopen(argv[1],"r");
+        if( !in ) {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+
+    printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    while( fgets(line,sizeof(line),in) ) {
+        if( !started ) {
+            if( sscanf(line,"#TRACE %lu %lu %lu %lu",&a,&b,&c,&d) == 4 ) {
+                cpuhz = (double) a;
+                rtchz = (double) b;
+                fprintf(stderr,"%lu records, %lu lost\n",c,d);
+                started = 1;
+            }
+            continue;
+        }
+        if( strncmp(line,"#END",4) == 0 )
+            break;
+        if( sscanf(line,"#TASK %lu %31s",&a,name) == 2 ) {
+            strcpy(tasknames[a&0xFF],name);
+            continue;
+        }
+        if( sscanf(line,"#QUEUE %lu %31s",&a,name) == 2 ) {
+            strcpy(queuenames[a&0xFF],name);
+            continue;
+        }
+        if( sscanf(line,"%lx %lx",&a,&b) != 2 )
+            continue;
+
+        time  = (uint32_t) a;
+        event = (unsigned) (b>>24)&0xFF;
+        id    = (unsigned) (b>>16)&0xFF;
+        arg   = (unsigned) b&0xFFFF;
+        if( !first )
+            ts += (double) (uint32_t) (time-last)*1e6/cpuhz;
+        first = 0;
+        last  = time;
+        tid = nesting ? TID_ISR+isr[nesting-1] : (task >= 0 ? task : 0);
+
+        switch(event) {
+        case TRACE_EV_SWITCH:
+            if( task >= 0 )
+                Slice('E',task,TaskName(task),ts);
+            task = id;
+            Slice('B',task,TaskName(task),ts);
+            break;
+        case TRACE_EV_QUEUE_SEND:
+            Queue(tid,"send",id,arg+1,ts);
+            break;
+        case TRACE_EV_QUEUE_SEND_FAILED:
+            Queue(tid,"send failed",id,-1,ts);
+            break;
+        case TRACE_EV_QUEUE_RECEIVE:
+            Queue(tid,"receive",id,arg ? (int) arg-1 : 0,ts);
+            break;
+        case TRACE_EV_QUEUE_RECEIVE_FAILED:
+            Queue(tid,"receive failed",id,-1,ts);
+            break;
+        case TRACE_EV_QUEUE_BLOCK_SEND:
+            Queue(tid,"block on send",id,-1,ts);
+            break;
+        case TRACE_EV_QUEUE_BLOCK_RECEIVE:
+            Queue(tid,"block on receive",id,-1,ts);
+            break;
+        case TRACE_EV_ISR_ENTER:
+            irqused[id] = 1;
+            Slice('B',TID_ISR+id,IRQName(id),ts);
+            if( nesting < MAXNESTING )
+                isr[nesting++] = id;
+            break;
+        case TRACE_EV_ISR_EXIT:
+            if( nesting > 0 && isr[nesting-1] == (int) id ) {
+                Slice('E',TID_ISR+id,IRQName(id),ts);
+                nesting--;
+            }
+            break;
+        case TRACE_EV_SLEEP:
+            Slice('B',TID_SLEEP,"Sleep",ts);
+            sleeping = 1;
+            break;
+        case TRACE_EV_WAKE:
+            ts += (double) ((id<<16)|arg)*1e6/rtchz;
+            if( sleeping )
+                Slice('E',TID_SLEEP,"Sleep",ts);
+            sleeping = 0;
+            break;
+        default:
+            break;
+        }
+    }
+
+    /* Close the open slices */
+    if( task >= 0 )
+        Slice('E',task,TaskName(task),ts);
+    while( nesting > 0 ) {
+        nesting--;
+        Slice('E',TID_ISR+isr[nesting],IRQName(isr[nesting]),ts);
+    }
+    if( sleeping )
+        Slice('E',TID_SLEEP,"Sleep",ts);
+
+    /* Names */
+    Begin();
+    printf("{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"EFM32GG FreeRTOS\"}}");
+    for(n=0;n<256;n++) {
+        if( tasknames[n][0] )
+            ThreadName(n,tasknames[n],n);
+    }
+    ThreadName(TID_SLEEP,"Sleep",TID_SLEEP);
+    for(i=0;i<256;i++) {
+        if( irqused[i] ) {
+            snprintf(name,sizeof(name),"ISR %s",IRQName(i));
+            ThreadName(TID_ISR+i,name,TID_ISR+i);
+        }
+    }
+    printf("\n]}\n");
+
+    if( in != stdin )
+        fclose(in);
+    if( !started ) {
+        fprintf(stderr,"No #TRACE line found\n");
+        return 1;
+    }
+    return 0;
+}
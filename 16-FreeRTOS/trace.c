@@ -0,0 +1,184 @@
+/**
+ * @file    trace.c
+ * @brief   Records kernel and interrupt events in a RAM ring buffer
+ *
+ * @note    count is the number of records written since Trace_Init. The
+ *          next record goes to count modulo TRACE_SIZE, overwriting the
+ *          oldest one. Recording costs a few dozen cycles: masking the
+ *          interrupts, reading the cycle counter and two stores.
+ *
+ * @note    The dump format is, one item per line:
+ *
+ *              #TRACE <cpu Hz> <rtc Hz> <records> <lost>
+ *              #TASK <number> <name>
+ *              #QUEUE <number> <name>
+ *              <time> <info>                   (hex, oldest first)
+ *              #END
+ *
+ *          Other lines of the terminal log are ignored by the converter.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "em_device.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "trace.h"
+#include "tickless.h"
+
+/// Maximal number of tasks listed by Trace_Dump
+#define MAXTASKS        (16)
+
+/**
+ * @brief   Global variables
+ */
+///@{
+static TraceRecord_t        buffer[TRACE_SIZE];
+static uint32_t             count = 0;          ///< records written
+static volatile int         recording = 0;
+static uint64_t             sleepstart = 0;     ///< RTC counts at the start of the sleep
+///@}
+
+/**
+ * @brief   Named queues
+ */
+///@{
+static const char           *queuenames[TRACE_MAXQUEUES+1];
+static UBaseType_t          nqueues = 0;
+///@}
+
+/// Tasks listed by Trace_Dump. Too large for the stack
+static TaskStatus_t         status[MAXTASKS];
+
+/**
+ * @details Clears the buffer and starts recording. Must be called before
+ *          the kernel objects are created. The cycle counter is enabled by
+ *          IdleMeter_Init
+ */
+
+void Trace_Init(void) {
+
+    count = 0;
+    recording = 1;
+}
+
+void Trace_Start(void) {
+
+    recording = 1;
+}
+
+void Trace_Stop(void) {
+
+    recording = 0;
+}
+
+/**
+ * @details Can be called by tasks, by the kernel and by interrupts up to
+ *          configMAX_SYSCALL_INTERRUPT_PRIORITY
+ */
+
+void Trace_Record(uint32_t event, uint32_t id, uint32_t arg) {
+UBaseType_t mask;
+TraceRecord_t *r;
+
+    if( !recording )
+        return;
+    mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    r = &buffer[count&(TRACE_SIZE-1)];
+    r->time = DWT->CYCCNT;
+    r->info = TRACE_INFO(event,id,arg);
+    count++;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+/**
+ * @details The IRQ number is read from IPSR
+ */
+
+void Trace_ISREnter(void) {
+
+    Trace_Record(TRACE_EV_ISR_ENTER,__get_IPSR()-16,0);
+}
+
+void Trace_ISRExit(void) {
+
+    Trace_Record(TRACE_EV_ISR_EXIT,__get_IPSR()-16,0);
+}
+
+/**
+ * @details Called by the idle task, with the scheduler suspended, around
+ *          vPortSuppressTicksAndSleep
+ */
+
+void Trace_SleepBegin(void) {
+TicklessTimes_t t;
+
+    Tickless_GetTimes(&t);
+    sleepstart = t.total;
+    Trace_Record(TRACE_EV_SLEEP,0,0);
+}
+
+void Trace_SleepEnd(void) {
+TicklessTimes_t t;
+uint32_t slept;
+
+    Tickless_GetTimes(&t);
+    slept = (uint32_t) (t.total-sleepstart);
+    if( slept > 0xFFFFFF )
+        slept = 0xFFFFFF;
+    Trace_Record(TRACE_EV_WAKE,slept>>16,slept);
+}
+
+/**
+ * @details Gives the queue the next number. Queues beyond TRACE_MAXQUEUES
+ *          keep number 0
+ */
+
+void Trace_NameQueue(void *queue, const char *name) {
+
+    if( nqueues < TRACE_MAXQUEUES ) {
+        nqueues++;
+        queuenames[nqueues] = name;
+        vQueueSetQueueNumber((QueueHandle_t) queue,nqueues);
+    }
+}
+
+/**
+ * @details Recording stops during the dump, so the printing is not traced.
+ *          The buffer is cleared afterwards
+ */
+
+void Trace_Dump(void) {
+UBaseType_t i,n;
+uint32_t first,lost;
+TraceRecord_t *r;
+
+    Trace_Stop();
+    if( count > TRACE_SIZE ) {
+        first = count-TRACE_SIZE;
+        lost  = first;
+    } else {
+        first = 0;
+        lost  = 0;
+    }
+
+    printf("\r\n#TRACE %lu %lu %lu %lu\r\n",(unsigned long) SystemCoreClock,
+            (unsigned long) LPTIMER_HZ,(unsigned long) (count-first),(unsigned long) lost);
+    n = uxTaskGetSystemState(status,MAXTASKS,0);
+    for(i=0;i<n;i++)
+        printf("#TASK %lu %s\r\n",(unsigned long) status[i].xTaskNumber,status[i].pcTaskName);
+    for(i=1;i<=nqueues;i++)
+        printf("#QUEUE %lu %s\r\n",(unsigned long) i,queuenames[i]);
+    while( first != count ) {
+        r = &buffer[first&(TRACE_SIZE-1)];
+        printf("%08lx %08lx\r\n",(unsigned long) r->time,(unsigned long) r->info);
+        first++;
+    }
+    printf("#END\r\n");
+
+    count = 0;
+    Trace_Start();
+}
@@ -0,0 +1,93 @@
+#ifndef TRACE_H
+#define TRACE_H
+/**
+ * @file    trace.h
+ * @brief   Records kernel and interrupt events in a RAM ring buffer
+ *
+ * @note    Each event is a record of 8 bytes: the cycle counter (DWT) and
+ *          the event, the task, queue or IRQ number and an argument. The
+ *          buffer keeps the last TRACE_SIZE events. Trace_Dump prints them
+ *          as text, to be converted on the host by tools/trace2json.c into
+ *          a Chrome trace (chrome://tracing or ui.perfetto.dev).
+ *
+ * @note    Used by the trace macros in FreeRTOSConfig.h (switches, queues,
+ *          sleep) and by TRACE_ISR_ENTER/TRACE_ISR_EXIT in the interrupt
+ *          routines. It includes no FreeRTOS header, since FreeRTOSConfig.h
+ *          includes it.
+ *
+ * @note    Trace_Record masks the interrupts up to configMAX_SYSCALL_INTERRUPT_PRIORITY,
+ *          so the records are in time order. Interrupts above it must not
+ *          record events.
+ *
+ * @note    The cycle counter stops in sleep and wraps around after 89 s
+ *          awake. The wake-up record has the time slept in RTC counts, so
+ *          the converter can rebuild the time line.
+ *
+ * @note    Queues are numbered by Trace_NameQueue. Semaphores and mutexes
+ *          are queues too. Unnamed queues have number 0.
+ */
+
+#include <stdint.h>
+
+/// Number of records. Must be a power of 2
+#ifndef TRACE_SIZE
+#define TRACE_SIZE          (512)
+#endif
+
+/// Maximal number of named queues
+#ifndef TRACE_MAXQUEUES
+#define TRACE_MAXQUEUES     (8)
+#endif
+
+/**
+ * @brief   Events
+ */
+///@{
+#define TRACE_EV_SWITCH                (1)     ///< id = task number
+#define TRACE_EV_QUEUE_SEND            (2)     ///< id = queue number, arg = messages before
+#define TRACE_EV_QUEUE_SEND_FAILED     (3)
+#define TRACE_EV_QUEUE_RECEIVE         (4)
+#define TRACE_EV_QUEUE_RECEIVE_FAILED  (5)
+#define TRACE_EV_QUEUE_BLOCK_SEND      (6)
+#define TRACE_EV_QUEUE_BLOCK_RECEIVE   (7)
+#define TRACE_EV_ISR_ENTER             (8)     ///< id = IRQ number
+#define TRACE_EV_ISR_EXIT              (9)
+#define TRACE_EV_SLEEP                 (10)
+#define TRACE_EV_WAKE                  (11)    ///< id and arg = RTC counts slept (24 bits)
+///@}
+
+/**
+ * @brief   Record layout
+ */
+///@{
+typedef struct {
+    uint32_t    time;                       ///< cycle counter
+    uint32_t    info;                       ///< event (31:24), id (23:16), arg (15:0)
+} TraceRecord_t;
+
+#define TRACE_INFO(E,I,A)   ( ((uint32_t) (E)<<24)|(((uint32_t) (I)&0xFF)<<16)|((uint32_t) (A)&0xFFFF) )
+///@}
+
+/// Used by the queue trace macros of FreeRTOSConfig.h (Q is a Queue_t *)
+#define TRACE_QUEUE(E,Q)    Trace_Record((E),(Q)->uxQueueNumber,(Q)->uxMessagesWaiting)
+
+/**
+ * @brief   Used in the interrupt routines
+ */
+///@{
+#define TRACE_ISR_ENTER()   Trace_ISREnter()
+#define TRACE_ISR_EXIT()    Trace_ISRExit()
+///@}
+
+void Trace_Init(void);
+void Trace_Start(void);
+void Trace_Stop(void);
+void Trace_Record(uint32_t event, uint32_t id, uint32_t arg);
+void Trace_ISREnter(void);
+void Trace_ISRExit(void);
+void Trace_SleepBegin(void);
+void Trace_SleepEnd(void);
+void Trace_NameQueue(void *queue, const char *name);
+void Trace_Dump(void);
+
+#endif // TRACE_H
@@ -0,0 +1,114 @@
+/**
+ * @file    app_hooks.c
+ * @brief   Application hooks called by uC/OS-II
+ *
+ * @note    They are called from the processor port (os_cpu_c.c), because
+ *          OS_CPU_HOOKS_EN and OS_APP_HOOKS_EN are set in os_cfg.h
+ *
+ * @note    The hooks give each task its own newlib reentrancy structure
+ *          (errno, stdio buffers, strtok state, etc.). A pointer to it is
+ *          stored in task register REENT_REG and installed in _impure_ptr
+ *          on every context switch.
+ */
+
+#include <stdlib.h>
+#include <reent.h>
+
+#include "ucos_ii.h"
+
+/// Task register reserved for the newlib reentrancy structure
+#define REENT_REG   0
+
+#if OS_TASK_REG_TBL_SIZE <= REENT_REG
+#error "OS_TASK_REG_TBL_SIZE must be at least 1 for newlib reentrancy"
+#endif
+
+/**
+ * @brief   Called when a task is created
+ *
+ * @note    If there is no memory, the task uses the global reentrancy structure
+ */
+
+void App_TaskCreateHook(OS_TCB *ptcb) {
+struct _reent *r;
+
+    r = malloc(sizeof(struct _reent));
+    if( r ) {
+        _REENT_INIT_PTR(r);
+    }
+    ptcb->OSTCBRegTbl[REENT_REG] = (INT32U) r;
+}
+
+/**
+ * @brief   Called when a task is deleted
+ *
+ * @note    Open streams of the task are closed and its buffers freed
+ */
+
+void App_TaskDelHook(OS_TCB *ptcb) {
+struct _reent *r = (struct _reent *) ptcb->OSTCBRegTbl[REENT_REG];
+
+    if( !r )
+        return;
+    ptcb->OSTCBRegTbl[REENT_REG] = 0;
+    if( _impure_ptr == r )
+        _impure_ptr = _global_impure_ptr;
+    _reclaim_reent(r);
+    free(r);
+}
+
+/**
+ * @brief   Called when a task returns instead of deleting itself
+ */
+
+void App_TaskReturnHook(OS_TCB *ptcb) {
+
+}
+
+/**
+ * @brief   Called in the idle task loop
+ */
+
+void App_TaskIdleHook(void) {
+
+}
+
+/**
+ * @brief   Called every second by the statistic task
+ */
+
+void App_TaskStatHook(void) {
+
+}
+
+/**
+ * @brief   Called on a context switch, with interrupts disabled
+ *
+ * @note    OSTCBHighRdy is the task about to run
+ */
+
+#if OS_TASK_SW_HOOK_EN > 0u
+void App_TaskSwHook(void) {
+struct _reent *r = (struct _reent *) OSTCBHighRdy->OSTCBRegTbl[REENT_REG];
+
+    _impure_ptr = r ? r : _global_impure_ptr;
+}
+#endif
+
+/**
+ * @brief   Called when a TCB is initialized, before the create hook
+ */
+
+void App_TCBInitHook(OS_TCB *ptcb) {
+
+}
+
+/**
+ * @brief   Called on every tick
+ */
+
+#if OS_TIME_TICK_HOOK_EN > 0u
+void App_TimeTickHook(void) {
+
+}
+#endif
@@ -0,0 +1,189 @@
+/**
+ * @file    bench.c
+ * @brief   Benchmark common to the kernel examples (14 to 18)
+ *
+ * @note    Only formats and prints the results. printf is not used, because
+ *          not all examples have it. Each line is built in a static buffer
+ *          and given to the write function of the port at once.
+ *
+ * @note    The image size comes from the symbols of efm32gg.ld. Flash is
+ *          code, constants and the initial values of .data. RAM is .data
+ *          and .bss, without the heap and the main stack.
+ */
+
+#include <stdint.h>
+#include "em_device.h"
+
+#include "bench.h"
+
+/// Readings of the counter to find its cost
+#define CALIBRATION     (16)
+
+/**
+ * @brief   Symbols of the linker script
+ */
+///@{
+extern char __etext[];
+extern char __data_start__[];
+extern char __data_end__[];
+extern char __bss_start__[];
+extern char __bss_end__[];
+///@}
+
+/**
+ * @brief   Global variables
+ */
+///@{
+static const char   *name = "";
+static void         (*output)(const char *s) = 0;
+static uint32_t     overhead = 0;           ///< cycles of a reading of the counter
+static char         line[80];
+static unsigned     pos = 0;
+///@}
+
+/**
+ * @brief   Appends a string to the line
+ */
+
+static void
+put(const char *s) {
+
+    while( *s && pos < sizeof(line)-3 )
+        line[pos++] = *s++;
+}
+
+/**
+ * @brief   Appends a space and n in decimal to the line
+ */
+
+static void
+putnumber(uint32_t n) {
+char digits[12];
+int i = sizeof(digits)-1;
+
+    digits[i] = '\0';
+    do {
+        digits[--i] = '0'+n%10;
+        n /= 10;
+    } while( n );
+    put(" ");
+    put(&digits[i]);
+}
+
+/**
+ * @brief   Starts a line with the prefix, the kernel and the item
+ */
+
+static void
+begin(const char *item) {
+
+    pos = 0;
+    put("BENCH ");
+    put(name);
+    put(" ");
+    put(item);
+}
+
+/**
+ * @brief   Ends the line and writes it
+ */
+
+static void
+end(void) {
+
+    line[pos++] = '\r';
+    line[pos++] = '\n';
+    line[pos]   = '\0';
+    if( output )
+        output(line);
+}
+
+/**
+ * @details The cost of reading the counter is the minimum of CALIBRATION
+ *          back to back readings. BENCH_IRQn gets the lowest level but one,
+ *          that is allowed to call the kernels
+ */
+
+void Bench_Init(const char *kernel, void (*write)(const char *s)) {
+uint32_t c,min;
+int i;
+
+    name   = kernel;
+    output = write;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    min = UINT32_MAX;
+    for(i=0;i<CALIBRATION;i++) {
+        c = BENCH_NOW();
+        c = BENCH_NOW()-c;
+        if( c < min )
+            min = c;
+    }
+    overhead = min;
+
+    NVIC_SetPriority(BENCH_IRQn,BENCH_INTLEVEL);
+    NVIC_ClearPendingIRQ(BENCH_IRQn);
+    NVIC_EnableIRQ(BENCH_IRQn);
+
+    begin("clock");
+    putnumber(SystemCoreClock);
+    end();
+}
+
+void Bench_Clear(BenchStat_t *stat) {
+
+    stat->n   = 0;
+    stat->min = 0;
+    stat->max = 0;
+    stat->sum = 0;
+}
+
+void Bench_Add(BenchStat_t *stat, uint32_t cycles) {
+
+    cycles = (cycles > overhead) ? cycles-overhead : 0;
+    if( stat->n == 0 || cycles < stat->min )
+        stat->min = cycles;
+    if( cycles > stat->max )
+        stat->max = cycles;
+    stat->sum += cycles;
+    stat->n++;
+}
+
+void Bench_Report(const char *test, const BenchStat_t *stat) {
+
+    begin(test);
+    if( stat == 0 || stat->n == 0 ) {
+        put(" n/a");
+    } else {
+        putnumber(stat->n);
+        putnumber(stat->min);
+        putnumber((uint32_t) (stat->sum/stat->n));
+        putnumber(stat->max);
+    }
+    end();
+}
+
+void Bench_ReportMemory(uint32_t taskbytes) {
+uint32_t data = (uint32_t) (__data_end__-__data_start__);
+
+    begin("flash");
+    putnumber((uint32_t) __etext+data);
+    end();
+    begin("ram");
+    putnumber(data+(uint32_t) (__bss_end__-__bss_start__));
+    end();
+    begin("task");
+    if( taskbytes )
+        putnumber(taskbytes);
+    else
+        put(" n/a");
+    end();
+}
+
+void Bench_End(void) {
+
+    begin("end");
+    end();
+}
@@ -0,0 +1,126 @@
+#ifndef BENCH_H
+#define BENCH_H
+/**
+ * @file    bench.h
+ * @brief   Benchmark common to the kernel examples (14 to 18)
+ *
+ * @note    The same tests run on each kernel, in the style of Thread-Metric,
+ *          but timing single operations with the cycle counter (DWT):
+ *          - coop:     a task gives up the processor until the next task runs
+ *          - preempt:  a task wakes a higher priority one until it runs
+ *          - isr:      an interrupt is set pending until the task it wakes runs
+ *          - message:  a message of BENCH_MSGSIZE bytes is sent to a queue
+ *                      and received back by the same task
+ *          - sem:      round trip of a semaphore ping-pong between two tasks
+ *          and the memory used: flash and static RAM of the whole image and
+ *          RAM used by each task (control block and stack).
+ *          Tests a kernel has no means for are reported as n/a.
+ *
+ * @note    Output, one line per item. Times in cycles, sizes in bytes:
+ *
+ *              BENCH <kernel> clock <Hz>
+ *              BENCH <kernel> <test> <samples> <min> <avg> <max>
+ *              BENCH <kernel> <test> n/a
+ *              BENCH <kernel> flash|ram|task <bytes>
+ *              BENCH <kernel> end
+ *
+ *          so the logs of all kernels can be merged with grep and sort.
+ *
+ * @note    bench.c is the same in all examples. The tests are in the port
+ *          to each kernel (bench_<kernel>.c), that provides Bench_Start.
+ *          The interrupt of the isr test is BENCH_IRQn, set pending by
+ *          software. Its routine is in the port too.
+ */
+
+#include <stdint.h>
+#include "em_device.h"
+
+/// Samples of each test
+#ifndef BENCH_SAMPLES
+#define BENCH_SAMPLES       (1000)
+#endif
+
+/// Size of the message of the message test (bytes)
+#define BENCH_MSGSIZE       (16)
+
+/**
+ * @brief   Interrupt of the isr test. Not used by the examples
+ */
+///@{
+#define BENCH_IRQn          TIMER3_IRQn
+#define BENCH_IRQHandler    TIMER3_IRQHandler
+#ifndef BENCH_INTLEVEL
+#define BENCH_INTLEVEL      (6)
+#endif
+///@}
+
+/// Reads the cycle counter
+#define BENCH_NOW()         (DWT->CYCCNT)
+
+/// Sets the interrupt of the isr test pending
+#define BENCH_TRIGGER()     NVIC_SetPendingIRQ(BENCH_IRQn)
+
+/**
+ * @brief   Statistics of a test (cycles)
+ */
+typedef struct {
+    uint32_t    n;
+    uint32_t    min;
+    uint32_t    max;
+    uint64_t    sum;
+} BenchStat_t;
+
+/**
+ * @fn      Bench_Init
+ * @brief   Starts the cycle counter, measures the cost of reading it and
+ *          enables BENCH_IRQn. Prints the clock line
+ *
+ * @param   kernel     name in the output
+ * @param   write      writes a string. Called once per line
+ */
+void Bench_Init(const char *kernel, void (*write)(const char *s));
+
+/**
+ * @fn      Bench_Clear
+ * @brief   Empties a statistics
+ */
+void Bench_Clear(BenchStat_t *stat);
+
+/**
+ * @fn      Bench_Add
+ * @brief   Adds the time between two readings of BENCH_NOW to a statistics
+ *
+ * @note    The cost of reading the counter is discounted
+ */
+void Bench_Add(BenchStat_t *stat, uint32_t cycles);
+
+/**
+ * @fn      Bench_Report
+ * @brief   Prints the line of a test. An empty statistics is printed as n/a
+ */
+void Bench_Report(const char *test, const BenchStat_t *stat);
+
+/**
+ * @fn      Bench_ReportMemory
+ * @brief   Prints the flash and RAM lines, from the linker symbols, and the
+ *          task line. taskbytes = 0 is printed as n/a
+ */
+void Bench_ReportMemory(uint32_t taskbytes);
+
+/**
+ * @fn      Bench_End
+ * @brief   Prints the end line
+ */
+void Bench_End(void);
+
+/**
+ * @fn      Bench_Start
+ * @brief   Runs the tests. Provided by the port
+ *
+ * @note    In the kernels without task stacks (tt, pt) it runs them and
+ *          returns. In the others, it creates the task that runs them when
+ *          the scheduler is started.
+ */
+void Bench_Start(void);
+
+#endif // BENCH_H
@@ -0,0 +1,287 @@
+/**
+ * @file    bench_ucos2.c
+ * @brief   Port of the common benchmark (bench.h) to uC/OS-II
+ *
+ * @note    A controller task with the highest priority creates the tasks of
+ *          each test, waits until they post the done semaphore and deletes
+ *          them, so the priorities and stacks are reused:
+ *          - preempt:  OSTaskResume in PreemptLow until PreemptHigh, that
+ *                      suspended itself, runs
+ *          - isr:      BENCH_IRQn set pending by IsrSource until IsrWaiter,
+ *                      pending on a semaphore, runs. The interrupt posts it
+ *          - message:  OSQPost and OSQPend of a BENCH_MSGSIZE message,
+ *                      without blocking. uC/OS-II queues only carry a
+ *                      pointer, so the message is not copied
+ *          - sem:      OSSemPost(ping) in SemPing until it gets pong,
+ *                      posted back by SemPong, that has a higher priority
+ *          Each priority has one task and there is no yield, so coop is n/a.
+ *          task is the size of the TCB plus the largest stack used by the
+ *          tasks of the tests (OSTaskStkChk).
+ *
+ * @note    The tick is started by the controller, as uC/OS-II requires.
+ *          The timer and statistic tasks have lower priorities than the
+ *          tasks of the tests.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "em_device.h"
+
+#include "ucos_ii.h"
+
+#include "bench.h"
+
+/**
+ * @brief   Task parameters
+ */
+///@{
+#define CONTROLPRIO         (4)
+#define HIGHPRIO            (5)
+#define LOWPRIO             (6)
+#define CONTROLSTACKSIZE    (512)
+#define STACKSIZE           (128)
+///@}
+
+/// Messages in the queue
+#define QUEUESIZE           (4)
+
+/**
+ * @brief   Stacks, semaphores and queue
+ */
+///@{
+static OS_STK               controlstack[CONTROLSTACKSIZE];
+static OS_STK               highstack[STACKSIZE];
+static OS_STK               lowstack[STACKSIZE];
+
+static OS_EVENT             *done, *isrsem, *ping, *pong, *queue;
+static void                 *queuetable[QUEUESIZE];
+///@}
+
+/**
+ * @brief   Global variables
+ */
+///@{
+static BenchStat_t          stat;
+static volatile uint32_t    stamp = 0;      ///< cycle counter at the start of a sample
+static uint32_t             stackused = 0;  ///< largest stack used (bytes)
+static uint8_t              message[BENCH_MSGSIZE];
+///@}
+
+/**
+ * @brief   Writes a line through newlib (syscalls.c)
+ */
+
+static void Write(const char *s) {
+
+    fputs(s,stdout);
+    fflush(stdout);
+}
+
+/**
+ * @brief   Tells the controller the test is over. It deletes the task
+ */
+
+static void Done(void) {
+
+    (void) OSSemPost(done);
+    while(1) {
+        (void) OSTaskSuspend(OS_PRIO_SELF);
+    }
+}
+
+/**
+ * @brief   Interrupt of the isr test
+ */
+
+void BENCH_IRQHandler(void) {
+#if OS_CRITICAL_METHOD == 3u
+OS_CPU_SR cpu_sr;
+#endif
+
+    OS_ENTER_CRITICAL();
+    OSIntEnter();
+    OS_EXIT_CRITICAL();
+
+    (void) OSSemPost(isrsem);
+
+    OSIntExit();
+}
+
+/**
+ * @brief   preempt tasks
+ */
+///@{
+static void PreemptHigh(void *param) {
+
+    while(1) {
+        (void) OSTaskSuspend(OS_PRIO_SELF);
+        Bench_Add(&stat,BENCH_NOW()-stamp);
+    }
+}
+
+static void PreemptLow(void *param) {
+int i;
+
+    for(i=0;i<BENCH_SAMPLES;i++) {
+        stamp = BENCH_NOW();
+        (void) OSTaskResume(HIGHPRIO);
+    }
+    Done();
+}
+///@}
+
+/**
+ * @brief   isr tasks
+ */
+///@{
+static void IsrWaiter(void *param) {
+INT8U err;
+
+    while(1) {
+        OSSemPend(isrsem,0,&err);
+        Bench_Add(&stat,BENCH_NOW()-stamp);
+    }
+}
+
+static void IsrSource(void *param) {
+int i;
+
+    for(i=0;i<BENCH_SAMPLES;i++) {
+        stamp = BENCH_NOW();
+        BENCH_TRIGGER();
+    }
+    Done();
+}
+///@}
+
+/**
+ * @brief   message task
+ */
+
+static void Message(void *param) {
+INT8U err;
+uint32_t c;
+int i;
+
+    for(i=0;i<BENCH_SAMPLES;i++) {
+        c = BENCH_NOW();
+        (void) OSQPost(queue,message);
+        (void) OSQPend(queue,0,&err);
+        Bench_Add(&stat,BENCH_NOW()-c);
+    }
+    Done();
+}
+
+/**
+ * @brief   sem tasks
+ */
+///@{
+static void SemPong(void *param) {
+INT8U err;
+
+    while(1) {
+        OSSemPend(ping,0,&err);
+        (void) OSSemPost(pong);
+    }
+}
+
+static void SemPing(void *param) {
+INT8U err;
+int i;
+
+    for(i=0;i<BENCH_SAMPLES;i++) {
+        stamp = BENCH_NOW();
+        (void) OSSemPost(ping);
+        OSSemPend(pong,0,&err);
+        Bench_Add(&stat,BENCH_NOW()-stamp);
+    }
+    Done();
+}
+///@}
+
+/**
+ * @brief   Creates a task with stack checking
+ */
+
+static void Create(void (*f)(void *), INT8U prio, OS_STK *stack) {
+
+    (void) OSTaskCreateExt(f,0,&stack[STACKSIZE-1],prio,prio,stack,STACKSIZE,0,
+                           OS_TASK_OPT_STK_CHK|OS_TASK_OPT_STK_CLR);
+}
+
+/**
+ * @brief   Updates the largest stack used and deletes a task
+ */
+
+static void Delete(INT8U prio) {
+OS_STK_DATA data;
+
+    if( OSTaskStkChk(prio,&data) == OS_ERR_NONE && data.OSUsed > stackused )
+        stackused = data.OSUsed;
+    (void) OSTaskDel(prio);
+}
+
+/**
+ * @brief   Creates the tasks of a test, waits for its end and deletes them
+ *
+ * @note    The controller has the highest priority, so they only run when
+ *          it pends on done
+ */
+
+static void Run(const char *test, void (*high)(void *), void (*low)(void *)) {
+INT8U err;
+
+    Bench_Clear(&stat);
+    if( high )
+        Create(high,HIGHPRIO,highstack);
+    if( low )
+        Create(low,LOWPRIO,lowstack);
+    OSSemPend(done,0,&err);
+    if( high )
+        Delete(HIGHPRIO);
+    if( low )
+        Delete(LOWPRIO);
+    Bench_Report(test,&stat);
+}
+
+/**
+ * @brief   Controller task
+ */
+
+static void Control(void *param) {
+
+    OS_CPU_SysTickInit(SystemCoreClock/OS_TICKS_PER_SEC);
+#if OS_TASK_STAT_EN > 0u
+    OSStatInit();
+#endif
+
+    Bench_Init("ucos2",Write);
+
+    Bench_Report("coop",0);
+    Run("preempt",PreemptHigh,PreemptLow);
+    Run("isr",IsrWaiter,IsrSource);
+    Run("message",0,Message);
+    Run("sem",SemPong,SemPing);
+    Bench_ReportMemory(sizeof(OS_TCB)+stackused);
+    Bench_End();
+
+    (void) OSTaskDel(OS_PRIO_SELF);
+}
+
+/**
+ * @details Creates the semaphores, the queue and the controller, the only
+ *          task before OSStart. Must be called after OSInit
+ */
+
+void Bench_Start(void) {
+
+    done   = OSSemCreate(0);
+    isrsem = OSSemCreate(0);
+    ping   = OSSemCreate(0);
+    pong   = OSSemCreate(0);
+    queue  = OSQCreate(queuetable,QUEUESIZE);
+
+    (void) OSTaskCreateExt(Control,0,&controlstack[CONTROLSTACKSIZE-1],
+                           CONTROLPRIO,CONTROLPRIO,controlstack,CONTROLSTACKSIZE,0,
+                           OS_TASK_OPT_STK_CHK|OS_TASK_OPT_STK_CLR);
+}
@@ -20,6 +20,14 @@
 #include "led.h"
 #include "uart.h"
 
+/*
+ * Uncomment to run the kernel benchmark (bench_ucos2.c) instead of the demo
+ */
+//#define BENCHMARK
+#ifdef BENCHMARK
+#include "bench.h"
+#endif
+
 
 /**************************************************************************//**
  * @brief  Main function
@@ -31,7 +39,9 @@
  */
 
 int main(void) {
+#ifndef BENCHMARK
 char line[100];
+#endif
 
     /* Configure LEDs */
     LED_Init(LED0|LED1);
@@ -42,12 +52,16 @@ char line[100];
     /* Turn on LEDs */
     LED_Write(0,LED0|LED1);
 
-    /* Configure SysTick */
-    SysTick_Config(SystemCoreClock/1000);
-
     /* Configure UART */
     UART_Init();
 
+#ifdef BENCHMARK
+    /* SysTick is started by the first task (OS_CPU_SysTickInit) */
+    OSInit();
+    Bench_Start();
+    OSStart();
+#endif
+
     __enable_irq();
 
     printf("\r\n\n\n\rHello\n\r");
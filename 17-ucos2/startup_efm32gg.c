@@ -165,6 +165,10 @@ void SVC_Handler             (void) __attribute__ ((weak, alias("Default_Handler
 void PendSV_Handler          (void) __attribute__ ((weak, alias("Default_Handler")));
 void SysTick_Handler         (void) __attribute__ ((weak, alias("Default_Handler")));
 
+/* uC/OS-II context switch and tick (os_cpu_a.S and os_cpu_c.c) */
+void OS_CPU_PendSVHandler    (void);
+void OS_CPU_SysTickHandler   (void);
+
 /* Part Specific Interrupts */
 void DMA_IRQHandler(void)           __attribute__ ((weak, alias("Default_Handler")));
 void GPIO_EVEN_IRQHandler(void)     __attribute__ ((weak, alias("Default_Handler")));
@@ -227,8 +231,8 @@ const pFunc __Vectors[] __attribute__ ((section(".vectors"))) = {
   SVC_Handler,                              /*      SVCall Handler            */
   DebugMon_Handler,                         /*      Debug Monitor Handler     */
   Default_Handler,                          /*      Reserved                  */
-  PendSV_Handler,                           /*      PendSV Handler            */
-  SysTick_Handler,                          /*      SysTick Handler           */
+  OS_CPU_PendSVHandler,                     /*      PendSV Handler            */
+  OS_CPU_SysTickHandler,                    /*      SysTick Handler           */
 
   /* External interrupts */
 
@@ -2,9 +2,18 @@
  * @file syscalls.c
  *
  * @note    Following 11. System Calls in Newlib LibC documentation
+ *
+ * @note    Reentrancy in uC/OS-II
+ *          - Each task has its own struct _reent, allocated by App_TaskCreateHook
+ *            and installed in _impure_ptr by App_TaskSwHook (see app_hooks.c),
+ *            so each one has its own errno and its own stdout buffer.
+ *          - malloc and the environment are protected by locking the scheduler.
+ *          - _write sends the whole buffer while holding a semaphore. As stdout is
+ *            line buffered, lines written by different tasks are not mixed.
  */
 
 #include <stdlib.h>
+#include <reent.h>
 #include <sys/stat.h>
 #include <sys/times.h>
 
@@ -40,6 +49,12 @@ extern int errno;
 
 #include "em_device.h"
 
+/**
+ * @brief   including uC/OS-II functions
+ */
+
+#include "ucos_ii.h"
+
 /**
  * @brief compatibility layer
  */
@@ -64,6 +79,50 @@ int  SerialRead(void)           { return UART_GetChar();  }
 int  SerialStatus(void)         { return UART_GetStatus();    }
 //@}
 
+/**
+ * @brief   Locks for newlib
+ *
+ * @note    Before the kernel starts and in interrupts there is no locking
+ */
+//@{
+static inline int KernelRunning(void) {
+    return (__get_IPSR() == 0) && (OSRunning == OS_TRUE);
+}
+
+// OSSchedLock can be nested, as newlib does with __malloc_lock
+void __malloc_lock(struct _reent *r)    { if( KernelRunning() ) OSSchedLock();    }
+void __malloc_unlock(struct _reent *r)  { if( KernelRunning() ) OSSchedUnlock();  }
+void __env_lock(struct _reent *r)       { if( KernelRunning() ) OSSchedLock();    }
+void __env_unlock(struct _reent *r)     { if( KernelRunning() ) OSSchedUnlock();  }
+
+// The semaphore can not be taken when the scheduler is locked (e.g. _sbrk message)
+
+static OS_EVENT *writesem = 0;
+
+static int WriteLock(void) {
+INT8U err;
+
+    if( !KernelRunning() || (OSLockNesting > 0) )
+        return 0;
+    if( writesem == 0 ) {
+        OSSchedLock();
+        if( writesem == 0 )
+            writesem = OSSemCreate(1);
+        OSSchedUnlock();
+    }
+    if( writesem == 0 )
+        return 0;
+    OSSemPend(writesem,0,&err);
+    return err == OS_ERR_NONE;
+}
+
+static void WriteUnlock(int locked) {
+
+    if( locked )
+        (void) OSSemPost(writesem);
+}
+//@}
+
 /**
  * @brief   Library initialization
  *
@@ -299,9 +358,12 @@ int _wait(int *status) {
 
 int _write(int file, char *ptr, int len) {
     int todo;
+    int locked;
 
+    locked = WriteLock();
     for (todo = 0; todo < len; todo++) {
         SerialWrite(*ptr++);
     }
+    WriteUnlock(locked);
     return len;
 }
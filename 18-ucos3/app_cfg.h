@@ -1,11 +1,17 @@
 #ifndef APP_CFG_H
 #define APP_CFG_H
 /**
+ * @file    app_cfg.h
+ * @brief   Application configuration
  *
- *
+ * @note    Priorities of the internal tasks are in os_cfg_app.h
  */
 
-#define OS_TASK_TMR_PRIO        10
-
+/// Trace output of the Micrium modules
+///@{
+#define TRACE_LEVEL_OFF     0u
+#define APP_TRACE_LEVEL     TRACE_LEVEL_OFF
+#define APP_TRACE(x)
+///@}
 
 #endif
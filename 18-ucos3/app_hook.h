@@ -0,0 +1,31 @@
+#ifndef APP_HOOK_H
+#define APP_HOOK_H
+/**
+ * @file    app_hook.h
+ * @brief   Application hooks of uC/OS-III (app_hooks.c)
+ */
+
+#include "os.h"
+
+/**
+ * @brief   Sets or clears the pointers uC/OS-III uses to call the hooks
+ */
+///@{
+void App_OS_SetAllHooks(void);
+void App_OS_ClrAllHooks(void);
+///@}
+
+/**
+ * @brief   Hooks
+ */
+///@{
+void App_OS_TaskCreateHook(OS_TCB *p_tcb);
+void App_OS_TaskDelHook(OS_TCB *p_tcb);
+void App_OS_TaskReturnHook(OS_TCB *p_tcb);
+void App_OS_IdleTaskHook(void);
+void App_OS_StatTaskHook(void);
+void App_OS_TaskSwHook(void);
+void App_OS_TimeTickHook(void);
+///@}
+
+#endif // APP_HOOK_H
@@ -0,0 +1,137 @@
+/**
+ * @file    app_hooks.c
+ * @brief   Application hooks called by uC/OS-III
+ *
+ * @note    uC/OS-III calls them through pointers, that are set by
+ *          App_OS_SetAllHooks after OSInit (OS_CFG_APP_HOOKS_EN in os_cfg.h)
+ *
+ * @note    The hooks give each task its own newlib reentrancy structure
+ *          (errno, stdio buffers, strtok state, etc.). A pointer to it is
+ *          stored in task register REENT_REG and installed in _impure_ptr
+ *          on every context switch.
+ */
+
+#include <stdlib.h>
+#include <reent.h>
+
+#include "os.h"
+#include "app_hook.h"
+
+/// Task register reserved for the newlib reentrancy structure
+#define REENT_REG   0
+
+#if OS_CFG_TASK_REG_TBL_SIZE <= REENT_REG
+#error "OS_CFG_TASK_REG_TBL_SIZE must be at least 1 for newlib reentrancy"
+#endif
+
+/**
+ * @brief   Called when a task is created
+ *
+ * @note    If there is no memory, the task uses the global reentrancy structure
+ */
+
+void App_OS_TaskCreateHook(OS_TCB *p_tcb) {
+struct _reent *r;
+
+    r = malloc(sizeof(struct _reent));
+    if( r ) {
+        _REENT_INIT_PTR(r);
+    }
+    p_tcb->RegTbl[REENT_REG] = (OS_REG) r;
+}
+
+/**
+ * @brief   Called when a task is deleted
+ *
+ * @note    Open streams of the task are closed and its buffers freed
+ */
+
+void App_OS_TaskDelHook(OS_TCB *p_tcb) {
+struct _reent *r = (struct _reent *) p_tcb->RegTbl[REENT_REG];
+
+    if( !r )
+        return;
+    p_tcb->RegTbl[REENT_REG] = 0;
+    if( _impure_ptr == r )
+        _impure_ptr = _global_impure_ptr;
+    _reclaim_reent(r);
+    free(r);
+}
+
+/**
+ * @brief   Called when a task returns instead of deleting itself
+ *
+ * @note    uC/OS-III deletes the task after the hook
+ */
+
+void App_OS_TaskReturnHook(OS_TCB *p_tcb) {
+
+}
+
+/**
+ * @brief   Called in the idle task loop
+ */
+
+void App_OS_IdleTaskHook(void) {
+
+}
+
+/**
+ * @brief   Called by the statistic task, OS_CFG_STAT_TASK_RATE_HZ times a second
+ */
+
+void App_OS_StatTaskHook(void) {
+
+}
+
+/**
+ * @brief   Called on a context switch, with interrupts disabled
+ *
+ * @note    OSTCBHighRdyPtr is the task about to run
+ */
+
+void App_OS_TaskSwHook(void) {
+struct _reent *r = (struct _reent *) OSTCBHighRdyPtr->RegTbl[REENT_REG];
+
+    _impure_ptr = r ? r : _global_impure_ptr;
+}
+
+/**
+ * @brief   Called on every tick
+ */
+
+void App_OS_TimeTickHook(void) {
+
+}
+
+/**
+ * @details Must be called after OSInit and before any task is created
+ */
+
+void App_OS_SetAllHooks(void) {
+CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    OS_AppTaskCreateHookPtr = App_OS_TaskCreateHook;
+    OS_AppTaskDelHookPtr    = App_OS_TaskDelHook;
+    OS_AppTaskReturnHookPtr = App_OS_TaskReturnHook;
+    OS_AppIdleTaskHookPtr   = App_OS_IdleTaskHook;
+    OS_AppStatTaskHookPtr   = App_OS_StatTaskHook;
+    OS_AppTaskSwHookPtr     = App_OS_TaskSwHook;
+    OS_AppTimeTickHookPtr   = App_OS_TimeTickHook;
+    CPU_CRITICAL_EXIT();
+}
+
+void App_OS_ClrAllHooks(void) {
+CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    OS_AppTaskCreateHookPtr = (OS_APP_HOOK_TCB) 0;
+    OS_AppTaskDelHookPtr    = (OS_APP_HOOK_TCB) 0;
+    OS_AppTaskReturnHookPtr = (OS_APP_HOOK_TCB) 0;
+    OS_AppIdleTaskHookPtr   = (OS_APP_HOOK_VOID) 0;
+    OS_AppStatTaskHookPtr   = (OS_APP_HOOK_VOID) 0;
+    OS_AppTaskSwHookPtr     = (OS_APP_HOOK_VOID) 0;
+    OS_AppTimeTickHookPtr   = (OS_APP_HOOK_VOID) 0;
+    CPU_CRITICAL_EXIT();
+}
@@ -0,0 +1,355 @@
+/**
+ * @file    bench_ucos3.c
+ * @brief   Port of the common benchmark (bench.h) to uC/OS-III
+ *
+ * @note    A controller task with the highest priority creates the tasks of
+ *          each test, waits until they post the done semaphore and deletes
+ *          them, so the control blocks and stacks are reused:
+ *          - coop:     OSSchedRoundRobinYield in CoopFirst until CoopSecond
+ *                      runs. Both have the same priority
+ *          - preempt:  OSTaskSemPost in PreemptLow until PreemptHigh,
+ *                      pending on its task semaphore, runs
+ *          - isr:      BENCH_IRQn set pending by IsrSource until IsrWaiter,
+ *                      pending on a semaphore, runs. The interrupt posts it
+ *          - message:  OSQPost and OSQPend of a BENCH_MSGSIZE message,
+ *                      without blocking. uC/OS-III queues only carry a
+ *                      pointer and a size, so the message is not copied
+ *          - sem:      OSSemPost(ping) in SemPing until it gets pong,
+ *                      posted back by SemPong, that has a higher priority
+ *          task is the size of the TCB plus the largest stack used by the
+ *          tasks of the tests. Stacks are cleared on creation and the
+ *          unused part is found by looking for the first non zero entry.
+ *
+ * @note    The tick is started by the controller, as uC/OS-III requires.
+ *          The tick, timer and statistic tasks have lower priorities than
+ *          the tasks of the tests.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "em_device.h"
+
+#include "os.h"
+
+#include "bench.h"
+
+/**
+ * @brief   Task parameters
+ */
+///@{
+#define CONTROLPRIO         (4u)
+#define HIGHPRIO            (5u)
+#define LOWPRIO             (6u)
+#define CONTROLSTACKSIZE    (512u)
+#define STACKSIZE           (128u)
+#define SLOTS               (2)
+///@}
+
+/// Messages in the queue
+#define QUEUESIZE           (4u)
+
+/**
+ * @brief   Tasks, semaphores and queue
+ */
+///@{
+static OS_TCB               controltcb;
+static CPU_STK              controlstack[CONTROLSTACKSIZE];
+static OS_TCB               tcb[SLOTS];
+static CPU_STK              stack[SLOTS][STACKSIZE];
+static int                  slots = 0;
+
+static OS_SEM               done, isrsem, ping, pong;
+static OS_Q                 queue;
+///@}
+
+/**
+ * @brief   Global variables
+ */
+///@{
+static BenchStat_t          stat;
+static volatile uint32_t    stamp = 0;      ///< cycle counter at the start of a sample
+static volatile int         stamped = 0;    ///< CoopFirst set stamp
+static volatile int         finished = 0;   ///< CoopSecond has all samples
+static uint32_t             stackused = 0;  ///< largest stack used (bytes)
+static uint8_t              message[BENCH_MSGSIZE];
+///@}
+
+/**
+ * @brief   Writes a line through newlib (syscalls.c)
+ */
+
+static void Write(const char *s) {
+
+    fputs(s,stdout);
+    fflush(stdout);
+}
+
+/**
+ * @brief   Suspends the task until the controller deletes it
+ */
+
+static void Park(void) {
+OS_ERR err;
+
+    while(1) {
+        OSTaskSuspend((OS_TCB *) 0,&err);
+    }
+}
+
+/**
+ * @brief   Tells the controller the test is over
+ */
+
+static void Done(void) {
+OS_ERR err;
+
+    (void) OSSemPost(&done,OS_OPT_POST_1,&err);
+    Park();
+}
+
+/**
+ * @brief   Interrupt of the isr test
+ */
+
+void BENCH_IRQHandler(void) {
+CPU_SR_ALLOC();
+OS_ERR err;
+
+    CPU_CRITICAL_ENTER();
+    OSIntEnter();
+    CPU_CRITICAL_EXIT();
+
+    (void) OSSemPost(&isrsem,OS_OPT_POST_1,&err);
+
+    OSIntExit();
+}
+
+/**
+ * @brief   coop tasks. The first one to run may be any of them
+ */
+///@{
+static void CoopFirst(void *param) {
+OS_ERR err;
+
+    while( !finished ) {
+        stamp = BENCH_NOW();
+        stamped = 1;
+        OSSchedRoundRobinYield(&err);
+    }
+    Park();
+}
+
+static void CoopSecond(void *param) {
+OS_ERR err;
+uint32_t now;
+
+    while( stat.n < BENCH_SAMPLES ) {
+        now = BENCH_NOW();
+        if( stamped )
+            Bench_Add(&stat,now-stamp);
+        stamped = 0;
+        OSSchedRoundRobinYield(&err);
+    }
+    finished = 1;
+    Done();
+}
+///@}
+
+/**
+ * @brief   preempt tasks. PreemptHigh is in the first slot
+ */
+///@{
+static void PreemptHigh(void *param) {
+OS_ERR err;
+CPU_TS ts;
+
+    while(1) {
+        (void) OSTaskSemPend(0,OS_OPT_PEND_BLOCKING,&ts,&err);
+        Bench_Add(&stat,BENCH_NOW()-stamp);
+    }
+}
+
+static void PreemptLow(void *param) {
+OS_ERR err;
+int i;
+
+    for(i=0;i<BENCH_SAMPLES;i++) {
+        stamp = BENCH_NOW();
+        (void) OSTaskSemPost(&tcb[0],OS_OPT_POST_NONE,&err);
+    }
+    Done();
+}
+///@}
+
+/**
+ * @brief   isr tasks
+ */
+///@{
+static void IsrWaiter(void *param) {
+OS_ERR err;
+CPU_TS ts;
+
+    while(1) {
+        (void) OSSemPend(&isrsem,0,OS_OPT_PEND_BLOCKING,&ts,&err);
+        Bench_Add(&stat,BENCH_NOW()-stamp);
+    }
+}
+
+static void IsrSource(void *param) {
+int i;
+
+    for(i=0;i<BENCH_SAMPLES;i++) {
+        stamp = BENCH_NOW();
+        BENCH_TRIGGER();
+    }
+    Done();
+}
+///@}
+
+/**
+ * @brief   message task
+ */
+
+static void Message(void *param) {
+OS_ERR err;
+OS_MSG_SIZE size;
+CPU_TS ts;
+uint32_t c;
+int i;
+
+    for(i=0;i<BENCH_SAMPLES;i++) {
+        c = BENCH_NOW();
+        OSQPost(&queue,message,BENCH_MSGSIZE,OS_OPT_POST_FIFO,&err);
+        (void) OSQPend(&queue,0,OS_OPT_PEND_NON_BLOCKING,&size,&ts,&err);
+        Bench_Add(&stat,BENCH_NOW()-c);
+    }
+    Done();
+}
+
+/**
+ * @brief   sem tasks
+ */
+///@{
+static void SemPong(void *param) {
+OS_ERR err;
+CPU_TS ts;
+
+    while(1) {
+        (void) OSSemPend(&ping,0,OS_OPT_PEND_BLOCKING,&ts,&err);
+        (void) OSSemPost(&pong,OS_OPT_POST_1,&err);
+    }
+}
+
+static void SemPing(void *param) {
+OS_ERR err;
+CPU_TS ts;
+int i;
+
+    for(i=0;i<BENCH_SAMPLES;i++) {
+        stamp = BENCH_NOW();
+        (void) OSSemPost(&ping,OS_OPT_POST_1,&err);
+        (void) OSSemPend(&pong,0,OS_OPT_PEND_BLOCKING,&ts,&err);
+        Bench_Add(&stat,BENCH_NOW()-stamp);
+    }
+    Done();
+}
+///@}
+
+/**
+ * @brief   Creates a task in the next slot, with a cleared stack
+ */
+
+static void Create(OS_TASK_PTR f, OS_PRIO prio) {
+OS_ERR err;
+
+    OSTaskCreate(&tcb[slots],"Bench",f,0,prio,stack[slots],STACKSIZE/10u,STACKSIZE,
+                 0u,0u,0,OS_OPT_TASK_STK_CHK|OS_OPT_TASK_STK_CLR,&err);
+    slots++;
+}
+
+/**
+ * @brief   Updates the largest stack used and deletes the tasks of the slots
+ *
+ * @note    Stacks grow down, so the unused part is at the start of the array
+ */
+
+static void DeleteAll(void) {
+OS_ERR err;
+uint32_t used;
+int i,k;
+
+    for(i=0;i<slots;i++) {
+        for(k=0;k<(int) STACKSIZE && stack[i][k]==0;k++) {}
+        used = (STACKSIZE-k)*sizeof(CPU_STK);
+        if( used > stackused )
+            stackused = used;
+        OSTaskDel(&tcb[i],&err);
+    }
+    slots = 0;
+}
+
+/**
+ * @brief   Creates the tasks of a test, waits for its end and deletes them
+ *
+ * @note    The controller has the highest priority, so they only run when
+ *          it pends on done
+ */
+
+static void Run(const char *test, OS_TASK_PTR f1, OS_PRIO p1,
+                                  OS_TASK_PTR f2, OS_PRIO p2) {
+OS_ERR err;
+CPU_TS ts;
+
+    Bench_Clear(&stat);
+    Create(f1,p1);
+    if( f2 )
+        Create(f2,p2);
+    (void) OSSemPend(&done,0,OS_OPT_PEND_BLOCKING,&ts,&err);
+    DeleteAll();
+    Bench_Report(test,&stat);
+}
+
+/**
+ * @brief   Controller task
+ */
+
+static void Control(void *param) {
+OS_ERR err;
+
+    OS_CPU_SysTickInit(SystemCoreClock/OS_CFG_TICK_RATE_HZ);
+#if OS_CFG_STAT_TASK_EN > 0u
+    OSStatTaskCPUUsageInit(&err);
+#endif
+    OSSchedRoundRobinCfg(DEF_ENABLED,0u,&err);
+
+    Bench_Init("ucos3",Write);
+
+    Run("coop",CoopFirst,LOWPRIO,CoopSecond,LOWPRIO);
+    Run("preempt",PreemptHigh,HIGHPRIO,PreemptLow,LOWPRIO);
+    Run("isr",IsrWaiter,HIGHPRIO,IsrSource,LOWPRIO);
+    Run("message",Message,LOWPRIO,0,0u);
+    Run("sem",SemPong,HIGHPRIO,SemPing,LOWPRIO);
+    Bench_ReportMemory(sizeof(OS_TCB)+stackused);
+    Bench_End();
+
+    OSTaskDel((OS_TCB *) 0,&err);
+}
+
+/**
+ * @details Creates the semaphores, the queue and the controller, the only
+ *          task before OSStart. Must be called after OSInit
+ */
+
+void Bench_Start(void) {
+OS_ERR err;
+
+    OSSemCreate(&done,"Done",0,&err);
+    OSSemCreate(&isrsem,"Isr",0,&err);
+    OSSemCreate(&ping,"Ping",0,&err);
+    OSSemCreate(&pong,"Pong",0,&err);
+    OSQCreate(&queue,"Bench",QUEUESIZE,&err);
+
+    OSTaskCreate(&controltcb,"Bench",Control,0,CONTROLPRIO,
+                 controlstack,CONTROLSTACKSIZE/10u,CONTROLSTACKSIZE,
+                 0u,0u,0,OS_OPT_TASK_STK_CHK|OS_OPT_TASK_STK_CLR,&err);
+}
@@ -0,0 +1,212 @@
+/**
+ * @file    console.c
+ * @brief   Console task: single key commands on the UART
+ *
+ * @note    Commands:
+ *          - s: CPU usage, context switches, stack used and longest time
+ *            with interrupts disabled of each task
+ *          - i: longest time with interrupts disabled since the last reset
+ *          - r: resets the maxima (OSStatReset and the interrupt measurement)
+ *          - + and -: more or less load (Load task in main.c)
+ *          - anything else: help
+ *
+ * @note    The figures are computed by uC/OS-III: the CPU usage and the
+ *          stack used by the statistic task (OS_CFG_STAT_TASK_EN and
+ *          OS_CFG_STAT_TASK_STK_CHK_EN), the switches and the time with
+ *          interrupts disabled by the switch hook of the port
+ *          (OS_CFG_TASK_PROFILE_EN and CPU_CFG_INT_DIS_MEAS_EN). Times are
+ *          timestamps (CPU_TS), that are cycles of the DWT counter (cpu_bsp.c).
+ *
+ * @note    The UART driver has no blocking read, so the task polls it once a
+ *          tick. This shows up as a small CPU usage of the console.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "em_device.h"
+
+#include "os.h"
+
+#include "console.h"
+#include "uart.h"
+
+#if OS_CFG_DBG_EN == 0u || OS_CFG_TASK_PROFILE_EN == 0u
+#error "The console needs OS_CFG_DBG_EN and OS_CFG_TASK_PROFILE_EN (os_cfg.h)"
+#endif
+#if OS_CFG_STAT_TASK_EN == 0u || OS_CFG_STAT_TASK_STK_CHK_EN == 0u
+#error "The console needs OS_CFG_STAT_TASK_EN and OS_CFG_STAT_TASK_STK_CHK_EN (os_cfg.h)"
+#endif
+#ifndef CPU_CFG_INT_DIS_MEAS_EN
+#error "The console needs CPU_CFG_INT_DIS_MEAS_EN (cpu_cfg.h)"
+#endif
+
+/// Maximal number of tasks shown by the s command
+#define MAXTASKS        (12)
+
+/// Step of the + and - commands (percent)
+#define LOADSTEP        (10u)
+
+/**
+ * @brief   Snapshot of the tasks for the s command. Too large for the stack
+ *
+ * @note    Taken with the scheduler locked, so the list does not change, and
+ *          printed after
+ */
+///@{
+static struct {
+    const CPU_CHAR  *name;
+    OS_PRIO         prio;
+    OS_CPU_USAGE    cpu;                ///< 0.01 %
+    OS_CPU_USAGE    cpumax;             ///< 0.01 %
+    OS_CTR          switches;
+    CPU_STK_SIZE    used;               ///< CPU_STK words
+    CPU_STK_SIZE    size;               ///< CPU_STK words
+    CPU_TS          intdismax;          ///< cycles
+} tasks[MAXTASKS];
+static int ntasks = 0;
+///@}
+
+static const char help[] =
+    "\r\nCommands: s (statistics), i (interrupts disabled), r (reset maxima),"
+    " + (more load), - (less load)\r\n";
+
+/**
+ * @brief   Converts cycles to ns
+ */
+
+static uint32_t Nanoseconds(uint32_t cycles) {
+uint32_t mhz = SystemCoreClock/1000000;
+
+    return (uint32_t) ((uint64_t) cycles*1000/mhz);
+}
+
+/**
+ * @brief   Copies the figures of the tasks
+ */
+
+static void Snapshot(void) {
+OS_TCB *p;
+OS_ERR err;
+
+    OSSchedLock(&err);
+    ntasks = 0;
+    for(p=OSTaskDbgListPtr;p && ntasks<MAXTASKS;p=p->DbgNextPtr) {
+        tasks[ntasks].name      = p->NamePtr;
+        tasks[ntasks].prio      = p->Prio;
+        tasks[ntasks].cpu       = p->CPUUsage;
+        tasks[ntasks].cpumax    = p->CPUUsageMax;
+        tasks[ntasks].switches  = p->CtxSwCtr;
+        tasks[ntasks].used      = p->StkUsed;
+        tasks[ntasks].size      = p->StkSize;
+        tasks[ntasks].intdismax = p->IntDisTimeMax;
+        ntasks++;
+    }
+    OSSchedUnlock(&err);
+}
+
+/**
+ * @brief   Prints the statistics of each task
+ *
+ * @note    Updated by the statistic task OS_CFG_STAT_TASK_RATE_HZ times a
+ *          second. The stack used is the largest since the task started
+ */
+
+static void Statistics(void) {
+int i;
+
+    Snapshot();
+    printf("\r\nCPU %u.%02u %% (max %u.%02u %%)  switches %lu\r\n",
+            OSStatTaskCPUUsage/100u,OSStatTaskCPUUsage%100u,
+            OSStatTaskCPUUsageMax/100u,OSStatTaskCPUUsageMax%100u,
+            (unsigned long) OSTaskCtxSwCtr);
+    printf("Task             pri   CPU %%   max %%   switches  stack used/size (bytes)  int dis max (ns)\r\n");
+    for(i=0;i<ntasks;i++) {
+        printf("%-16.16s %3u  %3u.%02u  %3u.%02u  %9lu  %9lu/%-5lu  %16lu\r\n",
+                tasks[i].name,(unsigned) tasks[i].prio,
+                tasks[i].cpu/100u,tasks[i].cpu%100u,
+                tasks[i].cpumax/100u,tasks[i].cpumax%100u,
+                (unsigned long) tasks[i].switches,
+                (unsigned long) (tasks[i].used*sizeof(CPU_STK)),
+                (unsigned long) (tasks[i].size*sizeof(CPU_STK)),
+                (unsigned long) Nanoseconds(tasks[i].intdismax));
+    }
+}
+
+/**
+ * @brief   Prints the longest time with interrupts disabled (all tasks and
+ *          interrupts) and the number of critical sections
+ *
+ * @note    The cost of the measurement itself is discounted by uC/CPU
+ */
+
+static void InterruptsDisabled(void) {
+CPU_TS_TMR max = CPU_IntDisMeasMaxGet();
+
+    printf("\r\nInterrupts disabled: max %lu cycles (%lu ns), %u sections (16 bit counter),"
+           " overhead %lu cycles\r\n",
+            (unsigned long) max,(unsigned long) Nanoseconds(max),
+            (unsigned) CPU_IntDisMeasCtr,(unsigned long) CPU_IntDisMeasOvrhd);
+}
+
+/**
+ * @brief   Clears the maxima
+ *
+ * @note    The critical section that clears CPU_IntDisMeasMax is measured
+ *          too, so the maximum starts with its length
+ */
+
+static void Reset(void) {
+OS_ERR err;
+CPU_SR_ALLOC();
+
+    OSStatReset(&err);
+    CPU_CRITICAL_ENTER();
+    CPU_IntDisMeasMax = 0;
+    CPU_CRITICAL_EXIT();
+    printf("\r\nMaxima cleared\r\n");
+}
+
+/**************************************************************************//**
+ * @brief  Console task
+ *
+ * @note   param points to the load of the Load task (percent)
+ */
+
+void Console(void *param) {
+volatile uint32_t *load = (volatile uint32_t *) param;
+OS_ERR err;
+char cmd;
+
+    printf("%s",help);
+    while(1) {
+        cmd = (char) UART_GetCharNoWait();
+        if( cmd == 0 ) {
+            OSTimeDly(1,OS_OPT_TIME_DLY,&err);
+            continue;
+        }
+        switch(cmd) {
+        case 's':
+            Statistics();
+            break;
+        case 'i':
+            InterruptsDisabled();
+            break;
+        case 'r':
+            Reset();
+            break;
+        case '+':
+            if( *load < CONSOLE_MAXLOAD )
+                *load += LOADSTEP;
+            printf("\r\nLoad %lu %%\r\n",(unsigned long) *load);
+            break;
+        case '-':
+            if( *load > 0 )
+                *load -= LOADSTEP;
+            printf("\r\nLoad %lu %%\r\n",(unsigned long) *load);
+            break;
+        default:
+            printf("%s",help);
+            break;
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+/**
+ * @file    console.h
+ * @brief   Console task: single key commands on the UART
+ *
+ * @note    The task parameter is a pointer to the load of the Load task
+ *          (volatile uint32_t, in percent). The commands + and - change it.
+ */
+
+#include <stdint.h>
+
+#include "os.h"
+
+/// Priority of the console task
+#ifndef CONSOLE_PRIO
+#define CONSOLE_PRIO        (12u)
+#endif
+
+/// Stack size of the console task (CPU_STK words). printf needs a large stack
+#ifndef CONSOLE_STACKSIZE
+#define CONSOLE_STACKSIZE   (400u)
+#endif
+
+/// Maximal load set by + (percent). The statistic task needs some time
+#ifndef CONSOLE_MAXLOAD
+#define CONSOLE_MAXLOAD     (90u)
+#endif
+
+void Console(void *param);
+
+#endif // CONSOLE_H
@@ -0,0 +1,74 @@
+/**
+ * @file    cpu_bsp.c
+ * @brief   Timestamp timer of uC/CPU (CPU_TS)
+ *
+ * @note    The timestamps are the cycle counter of the DWT unit. It runs at
+ *          the core clock and needs no interrupt, so CPU_TS_TmrRd is a single
+ *          load. It is called in every critical section when the time with
+ *          interrupts disabled is measured (CPU_CFG_INT_DIS_MEAS_EN).
+ *
+ * @note    The counter wraps around after 89 s at 48 MHz. uC/CPU extends it
+ *          when CPU_TS_Update is called (by the statistic task).
+ *
+ * @note    The counter stops while a debugger halts the core.
+ */
+
+#include "em_device.h"
+
+#include "cpu.h"
+#include "cpu_core.h"
+
+#if (CPU_CFG_TS_TMR_EN == DEF_ENABLED)
+/**
+ * @brief   Starts the cycle counter. Called by CPU_Init
+ *
+ * @note    The frequency is the core clock, so it must be set before
+ */
+
+void CPU_TS_TmrInit(void) {
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    CPU_TS_TmrFreqSet((CPU_TS_TMR_FREQ) SystemCoreClock);
+}
+
+/**
+ * @brief   Reads the cycle counter. It counts up, as uC/CPU requires
+ */
+
+CPU_TS_TMR CPU_TS_TmrRd(void) {
+
+    return (CPU_TS_TMR) DWT->CYCCNT;
+}
+#endif
+
+/**
+ * @brief   Converts timestamps to microseconds
+ */
+///@{
+#if (CPU_CFG_TS_32_EN == DEF_ENABLED)
+CPU_INT64U CPU_TS32_to_uSec(CPU_TS32 ts_cnts) {
+CPU_TS_TMR_FREQ freq;
+CPU_ERR err;
+
+    freq = CPU_TS_TmrFreqGet(&err);
+    if( err != CPU_ERR_NONE || freq == 0 )
+        return 0;
+    return ((CPU_INT64U) ts_cnts*1000000u)/freq;
+}
+#endif
+
+#if (CPU_CFG_TS_64_EN == DEF_ENABLED)
+CPU_INT64U CPU_TS64_to_uSec(CPU_TS64 ts_cnts) {
+CPU_TS_TMR_FREQ freq;
+CPU_ERR err;
+
+    freq = CPU_TS_TmrFreqGet(&err);
+    if( err != CPU_ERR_NONE || freq == 0 )
+        return 0;
+    return (ts_cnts/freq)*1000000u+((ts_cnts%freq)*1000000u)/freq;
+}
+#endif
+///@}
@@ -0,0 +1,40 @@
+#ifndef CPU_CFG_H
+#define CPU_CFG_H
+/**
+ * @file    cpu_cfg.h
+ * @brief   Configuration of uC/CPU for the EFM32GG (Cortex-M3)
+ *
+ * @note    The timestamps (CPU_TS) are 32 bit cycles of the DWT counter
+ *          (cpu_bsp.c). They are used by the kernel for the CPU usage of the
+ *          tasks and by uC/CPU to measure the time with interrupts disabled
+ */
+
+/// CPU name
+///@{
+#define  CPU_CFG_NAME_EN                        DEF_ENABLED
+#define  CPU_CFG_NAME_SIZE                      16u
+///@}
+
+/// Timestamps
+///@{
+#define  CPU_CFG_TS_32_EN                       DEF_ENABLED
+#define  CPU_CFG_TS_64_EN                       DEF_DISABLED
+#define  CPU_CFG_TS_TMR_SIZE                    CPU_WORD_SIZE_32
+///@}
+
+/// Measures the time with interrupts disabled in every critical section
+///@{
+#define  CPU_CFG_INT_DIS_MEAS_EN
+#define  CPU_CFG_INT_DIS_MEAS_OVRHD_NBR         1u
+///@}
+
+/// Cortex-M3 has CLZ, used by the scheduler to find the highest priority
+#define  CPU_CFG_LEAD_ZEROS_ASM_PRESENT
+
+/// EFM32GG implements 3 priority bits. Levels from the boundary on may call the kernel
+///@{
+#define  CPU_CFG_NVIC_PRIO_BITS                 3u
+#define  CPU_CFG_KA_IPL_BOUNDARY                4u
+///@}
+
+#endif // CPU_CFG_H
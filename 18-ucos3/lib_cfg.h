@@ -0,0 +1,18 @@
+#ifndef LIB_CFG_H
+#define LIB_CFG_H
+/**
+ * @file    lib_cfg.h
+ * @brief   Configuration of uC/LIB
+ *
+ * @note    Memory is allocated by newlib (malloc), so the uC/LIB heap is
+ *          not used
+ */
+
+#define  LIB_MEM_CFG_ARG_CHK_EXT_EN         DEF_DISABLED
+#define  LIB_MEM_CFG_OPTIMIZE_ASM_EN        DEF_DISABLED
+#define  LIB_MEM_CFG_ALLOC_EN               DEF_DISABLED
+#define  LIB_MEM_CFG_HEAP_SIZE              0u
+
+#define  LIB_STR_CFG_FP_EN                  DEF_DISABLED
+
+#endif // LIB_CFG_H
@@ -1,7 +1,18 @@
 /** ***************************************************************************
  * @file    main.c
- * @brief   Simple UART Demo for EFM32GG_STK3700
+ * @brief   uC/OS-III application for EFM32GG_STK3700
  * @version 1.0
+ *
+ * @note    Tasks (a lower number is a higher priority):
+ *          - Start (2):    starts the tick, calibrates the statistic task and
+ *                          creates the other tasks. Then deletes itself
+ *          - Console (12): single key commands on the UART (console.c)
+ *          - Blink (13):   toggles LED0 every 500 ms
+ *          - Load (20):    busy loop for a part of each 100 ms, set by the
+ *                          console, so the CPU usage can be seen changing
+ *          The tick (10) and timer (11) tasks are above Console, so the
+ *          delays are not late when Load is busy. The statistic task (62)
+ *          only runs in the time left by Load (at most 90 %).
 ******************************************************************************/
 
 #include <stdint.h>
@@ -15,11 +26,121 @@
 #include "em_device.h"
 #include "clock_efm32gg.h"
 
-#include "ucos_ii.h"
+#include "os.h"
+#include "app_hook.h"
 
 #include "led.h"
 #include "uart.h"
 
+/*
+ * Uncomment to run the kernel benchmark (bench_ucos3.c) instead of the application
+ */
+//#define BENCHMARK
+#ifdef BENCHMARK
+#include "bench.h"
+#else
+#include "console.h"
+#endif
+
+#ifndef BENCHMARK
+/**
+ * @brief   Task parameters (stack sizes in CPU_STK words)
+ */
+///@{
+#define START_PRIO          (2u)
+#define BLINK_PRIO          (13u)
+#define LOAD_PRIO           (20u)
+#define START_STACKSIZE     (256u)
+#define BLINK_STACKSIZE     (128u)
+#define LOAD_STACKSIZE      (128u)
+///@}
+
+/// Period of the Load task (ms)
+#define LOAD_PERIOD         (100u)
+
+/// Options of all tasks. The stacks are checked by the statistic task
+#define TASK_OPT            (OS_OPT_TASK_STK_CHK|OS_OPT_TASK_STK_CLR)
+
+/**
+ * @brief   Tasks
+ */
+///@{
+static OS_TCB   starttcb, blinktcb, loadtcb, consoletcb;
+static CPU_STK  startstack[START_STACKSIZE];
+static CPU_STK  blinkstack[BLINK_STACKSIZE];
+static CPU_STK  loadstack[LOAD_STACKSIZE];
+static CPU_STK  consolestack[CONSOLE_STACKSIZE];
+///@}
+
+/// Busy time of Load, in percent of LOAD_PERIOD. Changed by the console
+static volatile uint32_t load = 0;
+
+/**
+ * @brief   Toggles LED0 every 500 ms
+ */
+
+static void Blink(void *param) {
+OS_ERR err;
+
+    while(1) {
+        LED_Toggle(LED0);
+        OSTimeDlyHMSM(0,0,0,500,OS_OPT_TIME_HMSM_STRICT,&err);
+    }
+}
+
+/**
+ * @brief   Busy for load % of each period, using the timestamps (CPU_TS)
+ *
+ * @note    load is at most 90 %, so the delay is at least one tick
+ */
+
+static void Load(void *param) {
+OS_ERR err;
+CPU_TS32 start,busy;
+uint32_t pct;
+
+    while(1) {
+        pct   = load;
+        busy  = pct*(LOAD_PERIOD/100u)*(SystemCoreClock/1000u);
+        start = CPU_TS_Get32();
+        while( (CPU_TS32) (CPU_TS_Get32()-start) < busy ) {}
+        OSTimeDly(((100u-pct)*(LOAD_PERIOD/100u)*OS_CFG_TICK_RATE_HZ)/1000u,
+                  OS_OPT_TIME_DLY,&err);
+    }
+}
+
+/**
+ * @brief   First task. The only one when the statistic task is calibrated
+ *
+ * @note    As uC/OS-III requires, the tick is started here and not before
+ *          OSStart. The maximal time with interrupts disabled is cleared,
+ *          since the one of the initialization is not of interest
+ */
+
+static void Start(void *param) {
+OS_ERR err;
+
+    OS_CPU_SysTickInit(SystemCoreClock/OS_CFG_TICK_RATE_HZ);
+#if OS_CFG_STAT_TASK_EN > 0u
+    OSStatTaskCPUUsageInit(&err);
+#endif
+#ifdef CPU_CFG_INT_DIS_MEAS_EN
+    CPU_IntDisMeasMaxCurReset();
+#endif
+
+    OSTaskCreate(&consoletcb,"Console",Console,(void *) &load,CONSOLE_PRIO,
+                 consolestack,CONSOLE_STACKSIZE/10u,CONSOLE_STACKSIZE,
+                 0u,0u,0,TASK_OPT,&err);
+    OSTaskCreate(&blinktcb,"Blink",Blink,0,BLINK_PRIO,
+                 blinkstack,BLINK_STACKSIZE/10u,BLINK_STACKSIZE,
+                 0u,0u,0,TASK_OPT,&err);
+    OSTaskCreate(&loadtcb,"Load",Load,0,LOAD_PRIO,
+                 loadstack,LOAD_STACKSIZE/10u,LOAD_STACKSIZE,
+                 0u,0u,0,TASK_OPT,&err);
+
+    OSTaskDel((OS_TCB *) 0,&err);
+}
+#endif
 
 /**************************************************************************//**
  * @brief  Main function
@@ -28,10 +149,13 @@
  *         HFCLK = HFXO
  *         HFCORECLK = HFCLK
  *         HFPERCLK  = HFCLK
+ *
+ * @note   CPU_Init starts the timestamp timer (cpu_bsp.c) with the clock
+ *         frequency, so it is called after the clock is set
  */
 
 int main(void) {
-char line[100];
+OS_ERR err;
 
     /* Configure LEDs */
     LED_Init(LED0|LED1);
@@ -42,19 +166,22 @@ char line[100];
     /* Turn on LEDs */
     LED_Write(0,LED0|LED1);
 
-    /* Configure SysTick */
-    SysTick_Config(SystemCoreClock/1000);
-
     /* Configure UART */
     UART_Init();
 
-    __enable_irq();
-
-    printf("\r\n\n\n\rHello\n\r");
-    while (1) {
-        printf("\r\n\n\n\rWhat is your name?\n");
-        fgets(line,99,stdin);
-        printf("Hello %s\n",line);
-    }
+    /* SysTick is started by the first task (OS_CPU_SysTickInit) */
+    CPU_Init();
+    OSInit(&err);
+    App_OS_SetAllHooks();
+#ifdef BENCHMARK
+    Bench_Start();
+#else
+    OSTaskCreate(&starttcb,"Start",Start,0,START_PRIO,
+                 startstack,START_STACKSIZE/10u,START_STACKSIZE,
+                 0u,0u,0,TASK_OPT,&err);
+#endif
+    OSStart(&err);
 
+    /* Never reached */
+    while(1) {}
 }
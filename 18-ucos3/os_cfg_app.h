@@ -0,0 +1,48 @@
+#ifndef OS_CFG_APP_H
+#define OS_CFG_APP_H
+/**
+ * @file    os_cfg_app.h
+ * @brief   Sizes and priorities of the uC/OS-III internal tasks
+ *
+ * @note    Used by os_cfg_app.c, that allocates their stacks and tables.
+ *          The tick and timer tasks have lower priorities (higher numbers)
+ *          than the tasks of the benchmark, but higher than the console and
+ *          the other tasks of main.c, so the delays are not late when they
+ *          are busy.
+ */
+
+                                                /* ---------------------- MISCELLANEOUS ----------------------- */
+#define OS_CFG_MSG_POOL_SIZE            32u     /* Maximum number of messages                                   */
+#define OS_CFG_ISR_STK_SIZE            128u     /* Stack size of ISR stack (number of CPU_STK elements)         */
+#define OS_CFG_TASK_STK_LIMIT_PCT_EMPTY 10u     /* Stack limit position in percentage to empty                  */
+
+
+                                                /* ---------------------- IDLE TASK --------------------------- */
+#define OS_CFG_IDLE_TASK_STK_SIZE      128u     /* Stack size (number of CPU_STK elements)                      */
+
+
+                                                /* ------------------ ISR HANDLER TASK ------------------------ */
+#define OS_CFG_INT_Q_SIZE               10u     /* Size of ISR handler task queue                               */
+#define OS_CFG_INT_Q_TASK_STK_SIZE     128u     /* Stack size (number of CPU_STK elements)                      */
+
+
+                                                /* ------------------- STATISTIC TASK ------------------------- */
+#define OS_CFG_STAT_TASK_PRIO           62u     /* Priority                                                     */
+#define OS_CFG_STAT_TASK_RATE_HZ        10u     /* Rate of execution (1 to 10 Hz)                               */
+#define OS_CFG_STAT_TASK_STK_SIZE      128u     /* Stack size (number of CPU_STK elements)                      */
+
+
+                                                /* ------------------------ TICKS ----------------------------- */
+#define OS_CFG_TICK_RATE_HZ            100u     /* Tick rate in Hertz (10 to 1000 Hz)                           */
+#define OS_CFG_TICK_TASK_PRIO           10u     /* Priority                                                     */
+#define OS_CFG_TICK_TASK_STK_SIZE      128u     /* Stack size (number of CPU_STK elements)                      */
+#define OS_CFG_TICK_WHEEL_SIZE          17u     /* Number of 'spokes' in tick  wheel; SHOULD be prime           */
+
+
+                                                /* ----------------------- TIMERS ----------------------------- */
+#define OS_CFG_TMR_TASK_PRIO            11u     /* Priority of 'Timer Task'                                     */
+#define OS_CFG_TMR_TASK_RATE_HZ         10u     /* Rate for timers (10 Hz Typ.)                                 */
+#define OS_CFG_TMR_TASK_STK_SIZE       128u     /* Stack size (number of CPU_STK elements)                      */
+#define OS_CFG_TMR_WHEEL_SIZE           17u     /* Number of 'spokes' in timer wheel; SHOULD be prime           */
+
+#endif // OS_CFG_APP_H
@@ -2,9 +2,18 @@
  * @file syscalls.c
  *
  * @note    Following 11. System Calls in Newlib LibC documentation
+ *
+ * @note    Reentrancy in uC/OS-III
+ *          - Each task has its own struct _reent, allocated by App_OS_TaskCreateHook
+ *            and installed in _impure_ptr by App_OS_TaskSwHook (see app_hooks.c),
+ *            so each one has its own errno and its own stdout buffer.
+ *          - malloc and the environment are protected by locking the scheduler.
+ *          - _write sends the whole buffer while holding a semaphore. As stdout is
+ *            line buffered, lines written by different tasks are not mixed.
  */
 
 #include <stdlib.h>
+#include <reent.h>
 #include <sys/stat.h>
 #include <sys/times.h>
 
@@ -40,6 +49,12 @@ extern int errno;
 
 #include "em_device.h"
 
+/**
+ * @brief   including uC/OS-III functions
+ */
+
+#include "os.h"
+
 /**
  * @brief compatibility layer
  */
@@ -64,6 +79,58 @@ int  SerialRead(void)           { return UART_GetChar();  }
 int  SerialStatus(void)         { return UART_GetStatus();    }
 //@}
 
+/**
+ * @brief   Locks for newlib
+ *
+ * @note    Before the kernel starts and in interrupts there is no locking
+ */
+//@{
+static inline int KernelRunning(void) {
+    return (__get_IPSR() == 0) && (OSRunning == OS_STATE_OS_RUNNING);
+}
+
+static inline void SchedLock(void)      { OS_ERR err; OSSchedLock(&err);      }
+static inline void SchedUnlock(void)    { OS_ERR err; OSSchedUnlock(&err);    }
+
+// OSSchedLock can be nested, as newlib does with __malloc_lock
+void __malloc_lock(struct _reent *r)    { if( KernelRunning() ) SchedLock();    }
+void __malloc_unlock(struct _reent *r)  { if( KernelRunning() ) SchedUnlock();  }
+void __env_lock(struct _reent *r)       { if( KernelRunning() ) SchedLock();    }
+void __env_unlock(struct _reent *r)     { if( KernelRunning() ) SchedUnlock();  }
+
+// The semaphore can not be taken when the scheduler is locked (e.g. _sbrk message)
+
+static OS_SEM writesem;
+static int    writesemcreated = 0;
+
+static int WriteLock(void) {
+OS_ERR err;
+CPU_TS ts;
+
+    if( !KernelRunning() || (OSSchedLockNestingCtr > 0) )
+        return 0;
+    if( !writesemcreated ) {
+        SchedLock();
+        if( !writesemcreated ) {
+            OSSemCreate(&writesem,"write",1,&err);
+            writesemcreated = (err == OS_ERR_NONE);
+        }
+        SchedUnlock();
+    }
+    if( !writesemcreated )
+        return 0;
+    (void) OSSemPend(&writesem,0,OS_OPT_PEND_BLOCKING,&ts,&err);
+    return err == OS_ERR_NONE;
+}
+
+static void WriteUnlock(int locked) {
+OS_ERR err;
+
+    if( locked )
+        (void) OSSemPost(&writesem,OS_OPT_POST_1,&err);
+}
+//@}
+
 /**
  * @brief   Library initialization
  *
@@ -299,9 +366,12 @@ int _wait(int *status) {
 
 int _write(int file, char *ptr, int len) {
     int todo;
+    int locked;
 
+    locked = WriteLock();
     for (todo = 0; todo < len; todo++) {
         SerialWrite(*ptr++);
     }
+    WriteUnlock(locked);
     return len;
 }
@@ -16,7 +16,7 @@
  * #include "efm32gg995f1024.h"
  */
 #include "em_device.h"
-#include "system_efm32gg-ext.h"
+#include "clock_efm32gg.h"
 
 /**
  * @function        GetProdRev
@@ -121,6 +121,8 @@ SystemCoreClockSet(ClockSource_t source, uint32_t hclkdiv, uint32_t corediv) {
     // Set HFCLK divisor to 1
     CMU->CTRL      = (CMU->CTRL&~(_CMU_CTRL_HFCLKDIV_MASK));
 
+    band = 0;
+    tuning = 0;
     switch(source) {
     case CLOCK_HFRCO_1MHZ:
         if ( GetProdRev() >= 19 )
@@ -271,11 +273,11 @@ SystemCoreClockSet(ClockSource_t source, uint32_t hclkdiv, uint32_t corediv) {
 
     // Set divisors in HFCORECLKDIV and HFPERCLKDIV registers
     CMU->HFCORECLKDIV =   (CMU->HFCORECLKDIV
-                       & ~((_CMU_HFCORECLKDIV_HFCORECLKDIV_MASK<<_CMU_HFCORECLKDIV_HFCORECLKDIV_SHIFT)))
-                    | (divcode<<_CMU_HFCORECLKDIV_HFCORECLKDIV_SHIFT);
+                            & ~(_CMU_HFCORECLKDIV_HFCORECLKDIV_MASK))
+                        | (divcode<<_CMU_HFCORECLKDIV_HFCORECLKDIV_SHIFT);
     CMU->HFPERCLKDIV =   (CMU->HFPERCLKDIV
-                       & ~((_CMU_HFPERCLKDIV_HFPERCLKDIV_MASK<<_CMU_HFPERCLKDIV_HFPERCLKDIV_SHIFT)))
-                    | (divcode<<_CMU_HFPERCLKDIV_HFPERCLKDIV_SHIFT);
+                            & ~(_CMU_HFPERCLKDIV_HFPERCLKDIV_MASK))
+                        | (divcode<<_CMU_HFPERCLKDIV_HFPERCLKDIV_SHIFT);
 
     /*
      * Update global SystemCoreClock variable
@@ -306,38 +308,38 @@ uint32_t corefreq,corediv;
 uint32_t perfreq,perdiv;
 
     status = CMU->STATUS;
-    hclkdiv    = (CMU->CTRL&~(_CMU_CTRL_HFCLKDIV_MASK))>>_CMU_CTRL_HFCLKDIV_SHIFT;
+    hclkdiv    = (CMU->CTRL&_CMU_CTRL_HFCLKDIV_MASK)>>_CMU_CTRL_HFCLKDIV_SHIFT;
 
     if( status&CMU_STATUS_HFRCOSEL) {
         // HFRCO selected. See MODE field in CMU_HFRCOCTRL to see the frequency
         switch( CMU->HFRCOCTRL&_CMU_HFRCOCTRL_BAND_MASK ) {
-        case _CMU_HFRCOCTRL_BAND_1MHZ:
+        case CMU_HFRCOCTRL_BAND_1MHZ:
             if ( GetProdRev() >= 19 )
                 basefreq = 1200000;
             else
                 basefreq = 1000000;
             source   = CLOCK_HFRCO_1MHZ;
             break;
-        case _CMU_HFRCOCTRL_BAND_7MHZ:
+        case CMU_HFRCOCTRL_BAND_7MHZ:
             if ( GetProdRev() >= 19 )
                 basefreq = 6600000;
             else
                 basefreq = 7000000L;
             source   = CLOCK_HFRCO_7MHZ;
             break;
-        case _CMU_HFRCOCTRL_BAND_11MHZ:
+        case CMU_HFRCOCTRL_BAND_11MHZ:
             basefreq = 11000000L;
             source   = CLOCK_HFRCO_11MHZ;
             break;
-        case _CMU_HFRCOCTRL_BAND_14MHZ:
+        case CMU_HFRCOCTRL_BAND_14MHZ:
             basefreq = 14000000L;
             source   = CLOCK_HFRCO_14MHZ;
             break;
-        case _CMU_HFRCOCTRL_BAND_21MHZ:
+        case CMU_HFRCOCTRL_BAND_21MHZ:
             basefreq = 21000000L;
             source   = CLOCK_HFRCO_21MHZ;
             break;
-        case _CMU_HFRCOCTRL_BAND_28MHZ:
+        case CMU_HFRCOCTRL_BAND_28MHZ:
             basefreq = 28000000L;
             source   = CLOCK_HFRCO_28MHZ;
             break;
@@ -357,9 +359,9 @@ uint32_t perfreq,perdiv;
 
     hclkfreq = basefreq/(hclkdiv+1);
     corediv  = (CMU->HFCORECLKDIV&_CMU_HFCORECLKDIV_HFCORECLKDIV_MASK)>>_CMU_HFCORECLKDIV_HFCORECLKDIV_SHIFT;
-    corefreq = hclkfreq/(corediv+1);
+    corefreq = hclkfreq/(1U<<corediv);
     perdiv   = (CMU->HFPERCLKDIV&_CMU_HFPERCLKDIV_HFPERCLKDIV_MASK)>>_CMU_HFPERCLKDIV_HFPERCLKDIV_SHIFT;
-    perfreq  = hclkfreq/(perdiv+1);
+    perfreq  = hclkfreq/(1U<<perdiv);
 
     if( p ) {
         p->source   = source;
@@ -367,9 +369,9 @@ uint32_t perfreq,perdiv;
         p->hclkdiv  = hclkdiv+1;
         p->hclkfreq = hclkfreq;
         p->corefreq = corefreq;
-        p->corediv  = corediv+1;
+        p->corediv  = 1U<<corediv;
         p->perfreq  = perfreq;
-        p->perdiv   = perdiv+1;
+        p->perdiv   = 1U<<perdiv;
     }
 
     return basefreq;
@@ -403,11 +405,11 @@ uint32_t newctrl;
 
     if( freq <= 16000000UL ) {
         newreadctrl |= (MSC_READCTRL_MODE_WS0|MSC_READCTRL_MODE_WS1|MSC_READCTRL_MODE_WS2
-                    |MSC_READCTRL_MODE_WS0SCBTP|MSC_READCTRL_MODE_WS1SCBTP|MSC_READCTRL_MODE_WS2SCBTP);
+                    |   MSC_READCTRL_MODE_WS0SCBTP|MSC_READCTRL_MODE_WS1SCBTP|MSC_READCTRL_MODE_WS2SCBTP);
         newctrl     |= CMU_CTRL_HFXOBUFCUR_BOOSTUPTO32MHZ;
     } else if ( freq <= 32000000UL ) {
         newreadctrl |= (MSC_READCTRL_MODE_WS1|MSC_READCTRL_MODE_WS2
-                    |MSC_READCTRL_MODE_WS1SCBTP|MSC_READCTRL_MODE_WS2SCBTP);
+                    |   MSC_READCTRL_MODE_WS1SCBTP|MSC_READCTRL_MODE_WS2SCBTP);
         newctrl     |= CMU_CTRL_HFXOBUFCUR_BOOSTUPTO32MHZ;
     } else { // Maximum is 48 MHz
         newreadctrl |= (MSC_READCTRL_MODE_WS2|MSC_READCTRL_MODE_WS2SCBTP);
@@ -421,7 +423,7 @@ uint32_t newctrl;
 
 
 void
-ClockSetHFCLockDivisor(uint32_t div) {
+ClockSetHFClockDivisor(uint32_t div) {
 
     // Put div in valid range
     if ( div > 8 ) div = 8;
@@ -444,8 +446,8 @@ ClockSetHFCLockDivisor(uint32_t div) {
 void
 ClockSetPrescalers(uint32_t corediv, uint32_t perdiv) {
 uint32_t c,p;
-const uint32_t COREDIVMASK = (_CMU_HFCORECLKDIV_HFCORECLKDIV_MASK<<_CMU_HFCORECLKDIV_HFCORECLKDIV_SHIFT);
-const uint32_t PERDIVMASK  = (_CMU_HFPERCLKDIV_HFPERCLKDIV_MASK<<_CMU_HFPERCLKDIV_HFPERCLKDIV_SHIFT);
+const uint32_t COREDIVMASK = _CMU_HFCORECLKDIV_HFCORECLKDIV_MASK;
+const uint32_t PERDIVMASK  = _CMU_HFPERCLKDIV_HFPERCLKDIV_MASK;
 
     // Configure for worst case
     ClockConfigureForFrequency(EFM32_HFXO_FREQ);
@@ -454,17 +456,15 @@ const uint32_t PERDIVMASK  = (_CMU_HFPERCLKDIV_HFPERCLKDIV_MASK<<_CMU_HFPERCLKDI
     if( perdiv  == 0 ) perdiv  = 1;
 
     c = nearestpower2exp(corediv);
-    if( c == 0 ) c = 1;
     if( c > 9  ) c = 9;
 
     p = nearestpower2exp(perdiv);
-    if( p == 0 ) p = 1;
     if( p > 9  ) p = 9;
 
     // Configure for new frequency
 
     CMU->HFCORECLKDIV = (CMU->HFCORECLKDIV&~COREDIVMASK)|(c<<_CMU_HFCORECLKDIV_HFCORECLKDIV_SHIFT);
-    CMU->HFPERCLKDIV  = (CMU->HFPERCLKDIV&~PERDIVMASK)|(p<<_CMU_HFPERCLKDIV_HFPERCLKDIV_SHIFT);
+    CMU->HFPERCLKDIV  = (CMU->HFPERCLKDIV&~PERDIVMASK)  |(p<<_CMU_HFPERCLKDIV_HFPERCLKDIV_SHIFT);
 
     // Update global SystemCoreClock variable
     SystemCoreClockUpdate();
@@ -472,3 +472,24 @@ const uint32_t PERDIVMASK  = (_CMU_HFPERCLKDIV_HFPERCLKDIV_MASK<<_CMU_HFPERCLKDI
     // Optime for set clock frequency
     ClockConfigureForFrequency(SystemCoreClock);
 }
+
+
+uint32_t
+GetHFPeripheralClockFrequency(void) {
+ClockConfiguration_t clockconf;
+
+    ClockGetConfiguration(&clockconf);
+
+    return clockconf.perfreq;
+
+}
+
+uint32_t
+GetHFCoreClockFrequency(void) {
+ClockConfiguration_t clockconf;
+
+    ClockGetConfiguration(&clockconf);
+
+    return clockconf.corefreq;
+
+}
@@ -0,0 +1,103 @@
+/**
+ * @file    ecc.c
+ * @brief   Hamming code for 256 byte blocks (SmartMedia style)
+ *
+ * @note    Each of the 2048 bits has an 11 bit index (byte index * 8 + bit).
+ *          For each index bit k, two parities are stored: P1[k] over all bits
+ *          whose index has bit k set and P0[k] over the others.
+ *
+ * @note    A single bit error changes exactly one of P1[k] and P0[k] for all k.
+ *          The changed P1 bits give the index of the wrong bit.
+ */
+
+#include "ecc.h"
+
+#define MASK11 0x7FF
+
+/**
+ * @brief   Parity of a byte
+ */
+
+static int
+parity8(uint8_t x) {
+
+    x ^= x>>4;
+    x ^= x>>2;
+    x ^= x>>1;
+    return x&1;
+}
+
+/**
+ * @brief   Calculates P1 parities. P0 is P1 complemented when the overall
+ *          parity is odd
+ */
+
+static uint32_t
+calcp1(const uint8_t *data, int *total) {
+uint8_t col = 0;
+uint32_t row = 0;
+int i;
+
+    for(i=0;i<ECC_BLOCKSIZE;i++) {
+        col ^= data[i];
+        if( parity8(data[i]) )
+            row ^= i;
+    }
+    *total = parity8(col);
+
+    return  (row<<3)
+          | (parity8(col&0xF0)<<2)
+          | (parity8(col&0xCC)<<1)
+          | (parity8(col&0xAA));
+}
+
+/**
+ * @brief   Calculates ECC of a 256 byte block
+ *
+ * @note    Stored as P1 (bits 0-10) and P0 (bits 11-21) in little endian order.
+ *          Bits 22 and 23 are set, like in an erased page.
+ */
+
+void ECC_Calculate(const uint8_t *data, uint8_t *ecc) {
+uint32_t p1,p0;
+int total;
+
+    p1 = calcp1(data,&total);
+    p0 = total ? (p1^MASK11) : p1;
+    p1 = p1 | (p0<<11) | (3UL<<22);
+    ecc[0] = p1;
+    ecc[1] = p1>>8;
+    ecc[2] = p1>>16;
+}
+
+/**
+ * @brief   Verifies and corrects a 256 byte block
+ */
+
+int ECC_Correct(uint8_t *data, const uint8_t *ecc) {
+uint32_t stored,p1,p0,d1,d0,d;
+int total;
+int n;
+
+    stored = ecc[0] | ((uint32_t) ecc[1]<<8) | ((uint32_t) ecc[2]<<16);
+
+    p1 = calcp1(data,&total);
+    p0 = total ? (p1^MASK11) : p1;
+
+    d1 = (stored&MASK11)^p1;
+    d0 = ((stored>>11)&MASK11)^p0;
+    if( (d1 == 0) && (d0 == 0) )
+        return ECC_OK;
+
+    if( (d1^d0) == MASK11 ) {
+        data[d1>>3] ^= 1<<(d1&7);
+        return ECC_CORRECTED;
+    }
+
+    d = d1 | (d0<<11);
+    for(n=0;d;d&=d-1) n++;
+    if( n == 1 )
+        return ECC_ECCERROR;
+
+    return ECC_UNCORRECTABLE;
+}
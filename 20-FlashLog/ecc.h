@@ -0,0 +1,26 @@
+#ifndef ECC_H
+#define ECC_H
+/**
+ * @file    ecc.h
+ * @brief   Hamming code for 256 byte blocks (SmartMedia style)
+ *
+ * @note    Generates 3 bytes for every 256 bytes. Corrects 1 bit errors and
+ *          detects 2 bit errors.
+ */
+#include <stdint.h>
+
+#define ECC_BLOCKSIZE   256
+#define ECC_SIZE        3
+
+/// Return codes of ECC_Correct
+///@{
+#define ECC_OK              0       ///< No error
+#define ECC_CORRECTED       1       ///< One bit error in data was corrected
+#define ECC_ECCERROR        2       ///< One bit error in ECC. Data is correct
+#define ECC_UNCORRECTABLE   (-1)    ///< More than one bit error
+///@}
+
+void ECC_Calculate(const uint8_t *data, uint8_t *ecc);
+int  ECC_Correct(uint8_t *data, const uint8_t *ecc);
+
+#endif // ECC_H
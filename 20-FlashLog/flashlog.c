@@ -0,0 +1,577 @@
+/**
+ * @file    flashlog.c
+ * @brief   Log structured store for NAND flash
+ *
+ * @note    Layout of spare area of each page
+ *
+ *          | Byte   | Contents                                           |
+ *          |--------|----------------------------------------------------|
+ *          |  0-3   | Sequence number of page (little endian)            |
+ *          |   4    | CRC8 of bytes 0-3 and 12-15                        |
+ *          |   5    | Factory bad block marker (not used)                |
+ *          |  6-11  | ECC (3 bytes for each 256 bytes of data)           |
+ *          | 12-13  | Bytes used in data area                            |
+ *          | 14-15  | Erase count of block                               |
+ *
+ * @note    After an erase, only the erase count is programmed in the spare
+ *          area of page 0, so it is kept while the block is free. When page 0
+ *          is written, the same count is programmed again and the other fields
+ *          are added (partial page programming). A page 0 with only the erase
+ *          count is an erased page. 0xFFFF means the count is not known.
+ *
+ * @note    Data area holds records as a 16 bit length (little endian)
+ *          followed by the record contents. Unused bytes are 0xFF.
+ *
+ * @note    Sequence numbers increase by one at each page programmed. The
+ *          order of blocks is given by the sequence number of their first page.
+ *
+ * @note    Wear leveling: a new block is always the free block with the lowest
+ *          erase count. As the log is circular, all blocks are reused. The
+ *          counts survive a remount, for used and free blocks.
+ *
+ * @note    Bad blocks: factory marked blocks are never used. When a program
+ *          or erase operation fails, the block is marked bad. Its pages already
+ *          written are kept until the block is reclaimed.
+ */
+
+#include <string.h>
+#include "ecc.h"
+#include "flashlog.h"
+
+/// Special values for seqs
+///@{
+#define SEQ_FREE        0xFFFFFFFFUL
+#define SEQ_BAD         0xFFFFFFFEUL
+///@}
+
+/// Spare area positions
+///@{
+#define SP_SEQ          0
+#define SP_CRC          4
+#define SP_ECC          6
+#define SP_FILL         12
+#define SP_ERASES       14
+///@}
+
+/// Maximum number of retries when a program operation fails
+#define MAXRETRIES      4
+
+#define RETIRED(L,B)    ((L)->retired[(B)>>3]&(1<<((B)&7)))
+
+/**
+ * @brief   CRC8 (polynomial 0x07) of metadata in spare area
+ */
+
+static uint8_t
+sparecrc(const uint8_t *spare) {
+static const uint8_t pos[] = { 0, 1, 2, 3, 12, 13, 14, 15 };
+uint8_t crc = 0;
+int i,j;
+
+    for(i=0;i<sizeof(pos);i++) {
+        crc ^= spare[pos[i]];
+        for(j=0;j<8;j++)
+            crc = (crc&0x80) ? (crc<<1)^0x07 : (crc<<1);
+    }
+    return crc;
+}
+
+/**
+ * @brief   Helpers to access little endian fields
+ */
+///@{
+static uint32_t get32(const uint8_t *p) {
+    return p[0] | ((uint32_t) p[1]<<8) | ((uint32_t) p[2]<<16) | ((uint32_t) p[3]<<24);
+}
+
+static uint16_t get16(const uint8_t *p) {
+    return p[0] | (p[1]<<8);
+}
+
+static void put32(uint8_t *p, uint32_t v) {
+    p[0] = v; p[1] = v>>8; p[2] = v>>16; p[3] = v>>24;
+}
+
+static void put16(uint8_t *p, uint16_t v) {
+    p[0] = v; p[1] = v>>8;
+}
+///@}
+
+/**
+ * @brief   Classifies a page by its spare area
+ *
+ * @return  1 when page is valid, 0 when erased and -1 when corrupted
+ */
+
+static int
+checkspare(const uint8_t *spare) {
+int i;
+
+    for(i=0;i<FLOG_MINSPARESIZE;i++) {
+        if( (i != 5) && (i != SP_ERASES) && (i != SP_ERASES+1) && (spare[i] != 0xFF) )
+            break;
+    }
+    if( i == FLOG_MINSPARESIZE )
+        return 0;
+    if( sparecrc(spare) != spare[SP_CRC] )
+        return -1;
+    return 1;
+}
+
+/**
+ * @brief   Erases a block and updates index. Marks it bad when erase fails
+ *
+ * @note    The new erase count is programmed in page 0. If that fails, the
+ *          count is not known at the next mount
+ */
+
+static int
+eraseblock(FLog_t *log, int b) {
+NAND_t *nand = log->nand;
+uint8_t spare[FLOG_MINSPARESIZE];
+
+    if( RETIRED(log,b) || (nand->erase(nand->dev,b) < 0) ) {
+        nand->markbad(nand->dev,b);
+        log->seqs[b] = SEQ_BAD;
+        log->stats.badblocks++;
+        return -1;
+    }
+    if( log->erasecount[b] < 0xFFFE )
+        log->erasecount[b]++;
+    if( log->erasecount[b] != 0xFFFF ) {
+        memset(spare,0xFF,sizeof(spare));
+        put16(spare+SP_ERASES,log->erasecount[b]);
+        (void) nand->program(nand->dev,b*nand->pagesperblock,0,spare);
+    }
+    log->seqs[b] = SEQ_FREE;
+    log->stats.erases++;
+    log->stats.freeblocks++;
+    return 0;
+}
+
+/**
+ * @brief   Returns used block with lowest sequence number or -1
+ *
+ * @note    Block exclude is not considered
+ */
+
+static int
+oldestblock(FLog_t *log, int exclude) {
+int b,oldest = -1;
+
+    for(b=0;b<log->nand->blocks;b++) {
+        if( (log->seqs[b] < SEQ_BAD) && (b != exclude)
+            && ((oldest < 0) || (log->seqs[b] < log->seqs[oldest])) )
+            oldest = b;
+    }
+    return oldest;
+}
+
+/**
+ * @brief   Returns used block with the lowest sequence number above seq or -1
+ */
+
+static int
+nextblock(FLog_t *log, uint32_t seq) {
+int b,next = -1;
+
+    for(b=0;b<log->nand->blocks;b++) {
+        if( (log->seqs[b] < SEQ_BAD) && (log->seqs[b] > seq)
+            && ((next < 0) || (log->seqs[b] < log->seqs[next])) )
+            next = b;
+    }
+    return next;
+}
+
+/**
+ * @brief   Gets a free block for writing
+ *
+ * @note    Chooses the free block with lowest erase count (wear leveling)
+ * @note    When there are only FLOG_RESERVE free blocks, erases the oldest one
+ */
+
+static int
+allocblock(FLog_t *log) {
+int b,best;
+
+    while( log->stats.freeblocks <= FLOG_RESERVE ) {
+        b = oldestblock(log,log->block);
+        if( b < 0 )
+            break;
+        log->stats.usedblocks--;
+        log->stats.reclaimed++;
+        (void) eraseblock(log,b);
+    }
+
+    best = -1;
+    for(b=0;b<log->nand->blocks;b++) {
+        if( (log->seqs[b] == SEQ_FREE)
+            && ((best < 0) || (log->erasecount[b] < log->erasecount[best])) )
+            best = b;
+    }
+    if( best < 0 )
+        return -1;
+
+    log->stats.freeblocks--;
+    log->stats.usedblocks++;
+    log->block = best;
+    log->page  = 0;
+    return best;
+}
+
+/**
+ * @brief   Programs buffer into next page
+ *
+ * @note    When programming fails, the block is retired and the page is written
+ *          in a new block
+ */
+
+static int
+writepage(FLog_t *log) {
+NAND_t *nand = log->nand;
+uint8_t spare[FLOG_MINSPARESIZE];
+int retries,i,b;
+
+    memset(log->buffer+log->fill,0xFF,nand->pagesize-log->fill);
+
+    for(retries=0;retries<MAXRETRIES;retries++) {
+        if( (log->block < 0) || (log->page >= nand->pagesperblock) ) {
+            if( allocblock(log) < 0 )
+                return -1;
+        }
+        b = log->block;
+
+        memset(spare,0xFF,sizeof(spare));
+        put32(spare+SP_SEQ,log->seq);
+        put16(spare+SP_FILL,log->fill);
+        put16(spare+SP_ERASES,log->erasecount[b]);
+        for(i=0;i<nand->pagesize/ECC_BLOCKSIZE;i++)
+            ECC_Calculate(log->buffer+i*ECC_BLOCKSIZE,spare+SP_ECC+i*ECC_SIZE);
+        spare[SP_CRC] = sparecrc(spare);
+
+        if( nand->program(nand->dev,b*nand->pagesperblock+log->page,log->buffer,spare) == 0 ) {
+            if( log->page == 0 )
+                log->seqs[b] = log->seq;
+            log->page++;
+            log->seq++;
+            log->fill = 0;
+            log->stats.pageswritten++;
+            return 0;
+        }
+
+        // Program failed. Retire block and use another one
+        log->stats.programfailures++;
+        log->retired[b>>3] |= 1<<(b&7);
+        if( log->page == 0 ) {
+            // Nothing in block. Mark it bad now
+            log->stats.usedblocks--;
+            (void) eraseblock(log,b);
+        }
+        log->block = -1;
+    }
+    return -1;
+}
+
+/**
+ * @brief   Initializes log structure
+ */
+
+static int
+init(FLog_t *log, NAND_t *nand) {
+
+    if( (nand->blocks > FLOG_MAXBLOCKS) || (nand->pagesize > FLOG_MAXPAGESIZE)
+        || (nand->pagesize%ECC_BLOCKSIZE) || (nand->pagesize/ECC_BLOCKSIZE > 2)
+        || (nand->sparesize < FLOG_MINSPARESIZE) )
+        return -1;
+
+    memset(log,0,sizeof(FLog_t));
+    log->nand  = nand;
+    log->block = -1;
+    return 0;
+}
+
+/**
+ * @brief   Finds minimum and maximum erase counts
+ */
+
+static void
+erasestats(FLog_t *log) {
+int b;
+
+    log->stats.minerases = 0xFFFF;
+    log->stats.maxerases = 0;
+    for(b=0;b<log->nand->blocks;b++) {
+        if( log->seqs[b] == SEQ_BAD )
+            continue;
+        if( log->erasecount[b] < log->stats.minerases )
+            log->stats.minerases = log->erasecount[b];
+        if( log->erasecount[b] > log->stats.maxerases )
+            log->stats.maxerases = log->erasecount[b];
+    }
+}
+
+/**
+ * @brief   Erases all good blocks
+ *
+ * @note    Erase counts found in flash are kept
+ */
+
+int FLog_Format(FLog_t *log, NAND_t *nand) {
+uint8_t spare[FLOG_MINSPARESIZE];
+int b;
+
+    if( init(log,nand) < 0 )
+        return -1;
+
+    for(b=0;b<nand->blocks;b++) {
+        if( nand->isbad(nand->dev,b) ) {
+            log->seqs[b] = SEQ_BAD;
+            log->stats.badblocks++;
+            continue;
+        }
+        if( (nand->read(nand->dev,b*nand->pagesperblock,0,spare) == 0)
+            && (checkspare(spare) >= 0) && (get16(spare+SP_ERASES) != 0xFFFF) )
+            log->erasecount[b] = get16(spare+SP_ERASES);
+        (void) eraseblock(log,b);
+    }
+    erasestats(log);
+    return 0;
+}
+
+/**
+ * @brief   Rebuilds RAM index from flash
+ *
+ * @note    Reads the spare area of first page of each block and of all pages of
+ *          the last written block.
+ * @note    Erase counts are in page 0 of used and free blocks. When one is not
+ *          known (erase interrupted, page 0 corrupted or an image written
+ *          before the counts were kept), the mean of the others is used.
+ */
+
+int FLog_Mount(FLog_t *log, NAND_t *nand) {
+uint8_t spare[FLOG_MINSPARESIZE];
+uint32_t sum = 0;
+int known = 0;
+int b,p,head,rc;
+
+    if( init(log,nand) < 0 )
+        return -1;
+
+    head = -1;
+    for(b=0;b<nand->blocks;b++) {
+        log->erasecount[b] = 0xFFFF;
+        if( nand->isbad(nand->dev,b) ) {
+            log->seqs[b] = SEQ_BAD;
+            log->stats.badblocks++;
+            continue;
+        }
+        rc = -1;
+        if( nand->read(nand->dev,b*nand->pagesperblock,0,spare) == 0 )
+            rc = checkspare(spare);
+        if( rc > 0 ) {
+            log->seqs[b] = get32(spare+SP_SEQ);
+            log->erasecount[b] = get16(spare+SP_ERASES);
+            sum += log->erasecount[b];
+            known++;
+            log->stats.usedblocks++;
+            if( (head < 0) || (log->seqs[b] > log->seqs[head]) )
+                head = b;
+        } else {
+            // Erased or first page corrupted
+            if( (rc == 0) && (get16(spare+SP_ERASES) != 0xFFFF) ) {
+                log->erasecount[b] = get16(spare+SP_ERASES);
+                sum += log->erasecount[b];
+                known++;
+            }
+            log->seqs[b] = SEQ_FREE;
+            log->stats.freeblocks++;
+            if( rc < 0 ) {
+                log->stats.freeblocks--;
+                (void) eraseblock(log,b);
+            }
+        }
+    }
+
+    // Unknown erase counts
+    for(b=0;b<nand->blocks;b++) {
+        if( log->erasecount[b] == 0xFFFF )
+            log->erasecount[b] = known ? sum/known : 0;
+    }
+    erasestats(log);
+
+    if( head < 0 ) {
+        log->seq = 0;
+        return 0;
+    }
+
+    // Find first erased page in last block
+    log->block = head;
+    log->seq   = log->seqs[head]+1;
+    for(p=1;p<nand->pagesperblock;p++) {
+        if( nand->read(nand->dev,head*nand->pagesperblock+p,0,spare) < 0 )
+            continue;
+        rc = checkspare(spare);
+        if( rc == 0 )
+            break;
+        if( rc > 0 )
+            log->seq = get32(spare+SP_SEQ)+1;
+    }
+    log->page = p;
+    return 0;
+}
+
+/**
+ * @brief   Largest record that can be appended
+ */
+
+int FLog_MaxRecordSize(FLog_t *log) {
+    return log->nand->pagesize-2;
+}
+
+/**
+ * @brief   Appends a record
+ *
+ * @note    The record is kept in RAM until the page is full or FLog_Sync is called
+ * @note    Returns -1 when record is too big or flash could not be written
+ */
+
+int FLog_Append(FLog_t *log, const void *data, int len) {
+int pagesize = log->nand->pagesize;
+
+    if( (len < 0) || (len > pagesize-2) )
+        return -1;
+
+    if( log->fill+2+len > pagesize ) {
+        if( writepage(log) < 0 )
+            return -1;
+    }
+
+    put16(log->buffer+log->fill,len);
+    memcpy(log->buffer+log->fill+2,data,len);
+    log->fill += 2+len;
+
+    if( log->fill > pagesize-2 )
+        return writepage(log);
+    return 0;
+}
+
+/**
+ * @brief   Writes records in RAM into flash
+ *
+ * @note    Unused space in page is lost
+ */
+
+int FLog_Sync(FLog_t *log) {
+
+    if( log->fill == 0 )
+        return 0;
+    return writepage(log);
+}
+
+/**
+ * @brief   Loads next valid page into cursor
+ *
+ * @return  0 when a page was loaded. -1 at end of log
+ */
+
+static int
+loadpage(FLog_t *log, FLogCursor_t *cur) {
+NAND_t *nand = log->nand;
+uint8_t spare[FLOG_MINSPARESIZE];
+int i,rc,err;
+
+    while( cur->block >= 0 ) {
+        if( cur->page >= nand->pagesperblock ) {
+            cur->block = nextblock(log,log->seqs[cur->block]);
+            cur->page = 0;
+            continue;
+        }
+        if( nand->read(nand->dev,cur->block*nand->pagesperblock+cur->page,cur->data,spare) < 0 ) {
+            log->stats.uncorrectable++;
+            cur->page++;
+            continue;
+        }
+        cur->page++;
+        rc = checkspare(spare);
+        if( rc == 0 ) {
+            // End of written pages in this block
+            cur->page = nand->pagesperblock;
+            continue;
+        }
+        if( rc < 0 ) {
+            log->stats.uncorrectable++;
+            continue;
+        }
+        err = 0;
+        for(i=0;i<nand->pagesize/ECC_BLOCKSIZE;i++) {
+            switch( ECC_Correct(cur->data+i*ECC_BLOCKSIZE,spare+SP_ECC+i*ECC_SIZE) ) {
+            case ECC_CORRECTED:
+                log->stats.corrected++;
+                break;
+            case ECC_UNCORRECTABLE:
+                err = 1;
+                break;
+            }
+        }
+        if( err ) {
+            log->stats.uncorrectable++;
+            continue;
+        }
+        cur->fill   = get16(spare+SP_FILL);
+        cur->offset = 0;
+        if( cur->fill > nand->pagesize )
+            continue;
+        return 0;
+    }
+    return -1;
+}
+
+/**
+ * @brief   Positions cursor at oldest record
+ */
+
+int FLog_Rewind(FLog_t *log, FLogCursor_t *cur) {
+
+    cur->block  = oldestblock(log,-1);
+    cur->page   = 0;
+    cur->offset = 0;
+    cur->fill   = 0;
+    return 0;
+}
+
+/**
+ * @brief   Reads next record
+ *
+ * @return  Size of record. -1 at end of log
+ * @note    Record is truncated to maxlen
+ * @note    Records not yet written in flash (see FLog_Sync) are not read
+ */
+
+int FLog_Read(FLog_t *log, FLogCursor_t *cur, void *data, int maxlen) {
+int len;
+
+    while( cur->offset+2 > cur->fill ) {
+        if( loadpage(log,cur) < 0 )
+            return -1;
+    }
+
+    len = get16(cur->data+cur->offset);
+    if( cur->offset+2+len > cur->fill ) {
+        // Corrupted length. Skip rest of page
+        cur->offset = cur->fill;
+        return FLog_Read(log,cur,data,maxlen);
+    }
+    memcpy(data,cur->data+cur->offset+2,(len<maxlen)?len:maxlen);
+    cur->offset += 2+len;
+    return len;
+}
+
+/**
+ * @brief   Gets statistics
+ */
+
+void FLog_GetStats(FLog_t *log, FLogStats_t *stats) {
+
+    erasestats(log);
+    *stats = log->stats;
+}
@@ -0,0 +1,85 @@
+#ifndef FLASHLOG_H
+#define FLASHLOG_H
+/**
+ * @file    flashlog.h
+ * @brief   Log structured store for NAND flash
+ *
+ * @note    Records are packed into a page buffer and written a page at a time.
+ *          Blocks are used as a circular log. When there are no more free
+ *          blocks, the oldest one is erased (oldest records are lost).
+ * @note    The index in RAM (sequence number and erase count of each block)
+ *          is rebuilt by FLog_Mount reading the spare area of the pages.
+ */
+#include <stdint.h>
+#include "nand.h"
+
+/// Limits
+///@{
+#ifndef FLOG_MAXBLOCKS
+#define FLOG_MAXBLOCKS      NAND256W3A_BLOCKS
+#endif
+#define FLOG_MAXPAGESIZE    512
+#define FLOG_MINSPARESIZE   16
+/// Free blocks kept. When reached, the oldest block is erased
+#define FLOG_RESERVE        2
+///@}
+
+/**
+ * @typedef FLogStats_t
+ * @brief   Statistics
+ */
+typedef struct {
+    uint32_t    pageswritten;       ///< Pages programmed
+    uint32_t    erases;             ///< Blocks erased
+    uint32_t    reclaimed;          ///< Used blocks erased to get space (data lost)
+    uint32_t    programfailures;    ///< Page program failures (block retired)
+    uint32_t    corrected;          ///< Pages with a corrected bit error
+    uint32_t    uncorrectable;      ///< Pages with uncorrectable errors (skipped)
+    int         freeblocks;         ///< Blocks erased and ready to be used
+    int         usedblocks;         ///< Blocks with data
+    int         badblocks;          ///< Blocks not used
+    uint16_t    minerases;          ///< Minimum erase count
+    uint16_t    maxerases;          ///< Maximum erase count
+} FLogStats_t;
+
+/**
+ * @typedef FLog_t
+ * @brief   Log store
+ *
+ * @note    It is big (about 12 kB for the STK3700 NAND). Declare it static
+ */
+typedef struct {
+    NAND_t      *nand;
+    uint32_t    seq;                        ///< Sequence number of next page
+    int         block;                      ///< Block being written. -1 when none
+    int         page;                       ///< Next page to be written in block
+    int         fill;                       ///< Bytes in buffer
+    FLogStats_t stats;
+    uint8_t     buffer[FLOG_MAXPAGESIZE];   ///< Page being filled
+    uint32_t    seqs[FLOG_MAXBLOCKS];       ///< Sequence number of first page of block
+    uint16_t    erasecount[FLOG_MAXBLOCKS]; ///< Number of erases of block
+    uint8_t     retired[(FLOG_MAXBLOCKS+7)/8];///< Blocks to be marked bad when reclaimed
+} FLog_t;
+
+/**
+ * @typedef FLogCursor_t
+ * @brief   Position for reading records
+ */
+typedef struct {
+    int         block;                      ///< Block being read. -1 at end
+    int         page;                       ///< Page in block
+    int         offset;                     ///< Position of next record in data
+    int         fill;                       ///< Bytes in data
+    uint8_t     data[FLOG_MAXPAGESIZE];     ///< Page contents
+} FLogCursor_t;
+
+int FLog_Format(FLog_t *log, NAND_t *nand);
+int FLog_Mount(FLog_t *log, NAND_t *nand);
+int FLog_Append(FLog_t *log, const void *data, int len);
+int FLog_Sync(FLog_t *log);
+int FLog_MaxRecordSize(FLog_t *log);
+int FLog_Rewind(FLog_t *log, FLogCursor_t *cur);
+int FLog_Read(FLog_t *log, FLogCursor_t *cur, void *data, int maxlen);
+void FLog_GetStats(FLog_t *log, FLogStats_t *stats);
+
+#endif // FLASHLOG_H
@@ -0,0 +1,212 @@
+/**
+ * @file    flogsim.c
+ * @brief   Runs the log store on a host against a NAND emulated in a file
+ *
+ * @note    Usage: flogsim [-b blocks] [-e bitflips] [-f failures] image command
+ *
+ *          | Command         | Action                                               |
+ *          |-----------------|------------------------------------------------------|
+ *          | format          | Erases all good blocks                               |
+ *          | append          | Appends each line of stdin as a record               |
+ *          | dump            | Writes all records to stdout, one per line           |
+ *          | stats           | Shows statistics of the store                        |
+ *          | bench N SIZE    | Appends N records of SIZE bytes, remounts, verifies  |
+ *          |                 | them and shows throughput                            |
+ *
+ * @note    -b gives the number of blocks of a new image (default the one of
+ *          NAND256W3A). An existing image has the blocks given by its size,
+ *          and -b, when given, must match it.
+ *
+ * @note    -e N flips a bit once every N page reads. -f N makes one of every N
+ *          program or erase operations fail.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "nand_file.h"
+#include "flashlog.h"
+
+static FLog_t       flog;
+static FLogCursor_t cursor;
+static NAND_t       nand;
+static NANDFile_t   nandfile;
+
+static double
+now(void) {
+struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return ts.tv_sec+ts.tv_nsec*1e-9;
+}
+
+static void
+printstats(const FLogStats_t *st) {
+
+    printf("Blocks          free %d used %d bad %d\n",st->freeblocks,st->usedblocks,st->badblocks);
+    printf("Erase count     min %u max %u\n",st->minerases,st->maxerases);
+    printf("Pages written   %lu\n",(unsigned long) st->pageswritten);
+    printf("Erases          %lu (reclaimed %lu)\n",(unsigned long) st->erases,(unsigned long) st->reclaimed);
+    printf("Program fails   %lu\n",(unsigned long) st->programfailures);
+    printf("ECC             corrected %lu uncorrectable %lu\n",
+                    (unsigned long) st->corrected,(unsigned long) st->uncorrectable);
+}
+
+/**
+ * @brief   Record i has its number in the first 4 bytes followed by a pattern
+ */
+
+static void
+makerecord(uint8_t *rec, int size, uint32_t i) {
+int k;
+
+    for(k=0;k<size;k++)
+        rec[k] = (k<4) ? (i>>(8*k)) : (uint8_t) (i+k);
+}
+
+/**
+ * @brief   Appends n records, remounts and verifies them
+ *
+ * @note    The mount clears the counters of the store, so those of the
+ *          appends are saved before it and printed first
+ */
+
+static int
+bench(long n, int size) {
+uint8_t rec[FLOG_MAXPAGESIZE],got[FLOG_MAXPAGESIZE];
+FLogStats_t appendstats,verifystats;
+uint32_t first,expected;
+long i,count,errors;
+double t0,t1,t2;
+int len;
+
+    if( (size < 4) || (size > FLog_MaxRecordSize(&flog)) ) {
+        fprintf(stderr,"Record size must be between 4 and %d\n",FLog_MaxRecordSize(&flog));
+        return 1;
+    }
+
+    t0 = now();
+    for(i=0;i<n;i++) {
+        makerecord(rec,size,i);
+        if( FLog_Append(&flog,rec,size) < 0 ) {
+            fprintf(stderr,"Append failed at record %ld\n",i);
+            return 1;
+        }
+    }
+    FLog_Sync(&flog);
+    t1 = now();
+    FLog_GetStats(&flog,&appendstats);
+
+    // Remount to verify that index is rebuilt from flash
+    if( FLog_Mount(&flog,&nand) < 0 ) {
+        fprintf(stderr,"Mount failed\n");
+        return 1;
+    }
+
+    // Oldest records may have been reclaimed. Records must be consecutive
+    FLog_Rewind(&flog,&cursor);
+    count = errors = 0;
+    first = expected = 0;
+    while( (len = FLog_Read(&flog,&cursor,got,sizeof(got))) >= 0 ) {
+        if( count == 0 )
+            first = expected = got[0]|(got[1]<<8)|(got[2]<<16)|((uint32_t) got[3]<<24);
+        makerecord(rec,size,expected);
+        if( (len != size) || memcmp(rec,got,size) )
+            errors++;
+        expected++;
+        count++;
+    }
+    t2 = now();
+
+    printf("Records         %ld of %d bytes (%ld kept, first %lu)\n",n,size,count,(unsigned long) first);
+    printf("Errors          %ld\n",errors);
+    printf("Append          %.0f records/s %.2f MB/s\n",n/(t1-t0),n*size/(t1-t0)/1e6);
+    printf("Read            %.0f records/s\n",count/(t2-t1));
+    printf("NAND            %u reads %u programs %u erases\n",nandfile.reads,nandfile.programs,nandfile.erases);
+    printf("-- Append\n");
+    printstats(&appendstats);
+    FLog_GetStats(&flog,&verifystats);
+    printf("-- Mount and verify\n");
+    printstats(&verifystats);
+    return errors || (expected != (uint32_t) n);
+}
+
+int
+main(int argc, char *argv[]) {
+char line[FLOG_MAXPAGESIZE+1];
+int blocks = 0;
+int bitflips = 0, failures = 0;
+int opt,len,rc = 0;
+const char *cmd;
+FLogStats_t st;
+
+    while( (opt = getopt(argc,argv,"b:e:f:")) != -1 ) {
+        switch(opt) {
+        case 'b':
+            blocks = atoi(optarg);
+            if( blocks > 0 )
+                break;
+            fprintf(stderr,"Invalid number of blocks %s\n",optarg);
+            return 2;
+        case 'e': bitflips = atoi(optarg); break;
+        case 'f': failures = atoi(optarg); break;
+        default:
+            fprintf(stderr,"Usage: %s [-b blocks] [-e bitflips] [-f failures] image "
+                           "format|append|dump|stats|bench N SIZE\n",argv[0]);
+            return 2;
+        }
+    }
+    if( optind+2 > argc ) {
+        fprintf(stderr,"Missing image or command\n");
+        return 2;
+    }
+    rc = NAND_File_Init(&nand,&nandfile,argv[optind],blocks);
+    if( rc == -2 ) {
+        fprintf(stderr,"%s: size is not a whole number of blocks%s\n",argv[optind],
+                blocks?" or does not match -b":"");
+        return 1;
+    }
+    if( rc < 0 ) {
+        perror(argv[optind]);
+        return 1;
+    }
+    nandfile.bitflips = bitflips;
+    nandfile.failures = failures;
+    cmd = argv[optind+1];
+
+    if( strcmp(cmd,"format") == 0 ) {
+        rc = FLog_Format(&flog,&nand);
+    } else if( FLog_Mount(&flog,&nand) < 0 ) {
+        fprintf(stderr,"Mount failed\n");
+        rc = 1;
+    } else if( strcmp(cmd,"append") == 0 ) {
+        while( fgets(line,FLog_MaxRecordSize(&flog)+1,stdin) ) {
+            len = strcspn(line,"\n");
+            if( FLog_Append(&flog,line,len) < 0 ) {
+                rc = 1;
+                break;
+            }
+        }
+        FLog_Sync(&flog);
+    } else if( strcmp(cmd,"dump") == 0 ) {
+        FLog_Rewind(&flog,&cursor);
+        while( (len = FLog_Read(&flog,&cursor,line,sizeof(line)-1)) >= 0 ) {
+            fwrite(line,1,len,stdout);
+            putchar('\n');
+        }
+    } else if( strcmp(cmd,"stats") == 0 ) {
+        FLog_GetStats(&flog,&st);
+        printstats(&st);
+    } else if( (strcmp(cmd,"bench") == 0) && (optind+4 <= argc) ) {
+        rc = bench(atol(argv[optind+2]),atoi(argv[optind+3]));
+    } else {
+        fprintf(stderr,"Unknown command %s\n",cmd);
+        rc = 2;
+    }
+
+    NAND_File_Close(&nandfile);
+    return rc < 0 ? 1 : rc;
+}
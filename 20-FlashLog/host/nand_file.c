@@ -0,0 +1,176 @@
+/**
+ * @file    nand_file.c
+ * @brief   NAND flash emulated in a file (host only)
+ *
+ * @note    Each page is stored as data followed by spare area. A new file is
+ *          created erased (all 0xFF) and without bad blocks
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "nand_file.h"
+
+#define PAGESIZE        NAND256W3A_PAGESIZE
+#define SPARESIZE       NAND256W3A_SPARESIZE
+#define RAWSIZE         (PAGESIZE+SPARESIZE)
+#define PAGESPERBLOCK   NAND256W3A_PAGESPERBLOCK
+
+static int
+rawread(NANDFile_t *nf, int page, uint8_t *raw) {
+
+    if( fseek(nf->file,(long) page*RAWSIZE,SEEK_SET) )
+        return -1;
+    return fread(raw,RAWSIZE,1,nf->file) == 1 ? 0 : -1;
+}
+
+static int
+rawwrite(NANDFile_t *nf, int page, const uint8_t *raw) {
+
+    if( fseek(nf->file,(long) page*RAWSIZE,SEEK_SET) )
+        return -1;
+    return fwrite(raw,RAWSIZE,1,nf->file) == 1 ? 0 : -1;
+}
+
+static int
+fail(NANDFile_t *nf) {
+    return nf->failures && (rand()%nf->failures == 0);
+}
+
+static int
+nf_read(void *dev, int page, uint8_t *data, uint8_t *spare) {
+NANDFile_t *nf = dev;
+uint8_t raw[RAWSIZE];
+int bit;
+
+    if( rawread(nf,page,raw) < 0 )
+        return -1;
+    nf->reads++;
+    if( nf->bitflips && (rand()%nf->bitflips == 0) ) {
+        bit = rand()%(PAGESIZE*8);
+        raw[bit>>3] ^= 1<<(bit&7);
+    }
+    if( data )
+        memcpy(data,raw,PAGESIZE);
+    if( spare )
+        memcpy(spare,raw+PAGESIZE,SPARESIZE);
+    return 0;
+}
+
+static int
+nf_program(void *dev, int page, const uint8_t *data, const uint8_t *spare) {
+NANDFile_t *nf = dev;
+uint8_t raw[RAWSIZE];
+int i;
+
+    if( rawread(nf,page,raw) < 0 )
+        return -1;
+    nf->programs++;
+    if( fail(nf) )
+        return -1;
+    for(i=0;i<PAGESIZE;i++)
+        raw[i] &= data ? data[i] : 0xFF;
+    for(i=0;i<SPARESIZE;i++)
+        raw[PAGESIZE+i] &= spare ? spare[i] : 0xFF;
+    return rawwrite(nf,page,raw);
+}
+
+static int
+nf_erase(void *dev, int block) {
+NANDFile_t *nf = dev;
+uint8_t raw[RAWSIZE];
+int p;
+
+    nf->erases++;
+    if( fail(nf) )
+        return -1;
+    memset(raw,0xFF,RAWSIZE);
+    for(p=0;p<PAGESPERBLOCK;p++) {
+        if( rawwrite(nf,block*PAGESPERBLOCK+p,raw) < 0 )
+            return -1;
+    }
+    return 0;
+}
+
+static int
+nf_isbad(void *dev, int block) {
+uint8_t spare[SPARESIZE];
+
+    if( nf_read(dev,block*PAGESPERBLOCK,0,spare) < 0 )
+        return 1;
+    return spare[NAND256W3A_BADBLOCKPOS] != 0xFF;
+}
+
+static int
+nf_markbad(void *dev, int block) {
+uint8_t spare[SPARESIZE];
+NANDFile_t *nf = dev;
+int failures = nf->failures;
+int rc;
+
+    memset(spare,0xFF,SPARESIZE);
+    spare[NAND256W3A_BADBLOCKPOS] = 0;
+    nf->failures = 0;
+    rc = nf_program(dev,block*PAGESPERBLOCK,0,spare);
+    nf->failures = failures;
+    return rc;
+}
+
+/**
+ * @brief   Opens emulator file. Creates it erased when it does not exist
+ *
+ * @note    blocks can be less than in NAND256W3A, to speed up tests. When 0,
+ *          the number of blocks is given by the size of the file, or is the
+ *          one of NAND256W3A for a new file
+ *
+ * @return  0 when ok, -1 when the file cannot be opened or created, -2 when
+ *          its size is not a whole number of blocks or does not match blocks
+ */
+
+int NAND_File_Init(NAND_t *nand, NANDFile_t *nf, const char *path, int blocks) {
+uint8_t raw[RAWSIZE];
+long p,size;
+
+    memset(nf,0,sizeof(NANDFile_t));
+    nf->file = fopen(path,"r+b");
+    if( nf->file ) {
+        if( fseek(nf->file,0,SEEK_END) || ((size = ftell(nf->file)) < 0) ) {
+            NAND_File_Close(nf);
+            return -1;
+        }
+        if( (size == 0) || (size%((long) PAGESPERBLOCK*RAWSIZE) != 0)
+            || (blocks && (size != (long) blocks*PAGESPERBLOCK*RAWSIZE)) ) {
+            NAND_File_Close(nf);
+            return -2;
+        }
+        blocks = size/((long) PAGESPERBLOCK*RAWSIZE);
+    } else {
+        nf->file = fopen(path,"w+b");
+        if( !nf->file )
+            return -1;
+        if( blocks == 0 )
+            blocks = NAND256W3A_BLOCKS;
+        memset(raw,0xFF,RAWSIZE);
+        for(p=0;p<(long) blocks*PAGESPERBLOCK;p++)
+            fwrite(raw,RAWSIZE,1,nf->file);
+    }
+
+    nand->pagesize      = PAGESIZE;
+    nand->sparesize     = SPARESIZE;
+    nand->pagesperblock = PAGESPERBLOCK;
+    nand->blocks        = blocks;
+    nand->badblockpos   = NAND256W3A_BADBLOCKPOS;
+    nand->read          = nf_read;
+    nand->program       = nf_program;
+    nand->erase         = nf_erase;
+    nand->isbad         = nf_isbad;
+    nand->markbad       = nf_markbad;
+    nand->dev           = nf;
+    return 0;
+}
+
+void NAND_File_Close(NANDFile_t *nf) {
+
+    if( nf->file )
+        fclose(nf->file);
+    nf->file = 0;
+}
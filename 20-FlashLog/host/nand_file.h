@@ -0,0 +1,31 @@
+#ifndef NAND_FILE_H
+#define NAND_FILE_H
+/**
+ * @file    nand_file.h
+ * @brief   NAND flash emulated in a file (host only)
+ *
+ * @note    Same geometry of the NAND256W3A in the STK3700
+ * @note    Behaves like a NAND: program only clears bits, erase sets all
+ *          bits of a block
+ * @note    Faults can be injected to test ECC and bad block handling
+ */
+#include <stdio.h>
+#include "nand.h"
+
+/**
+ * @typedef NANDFile_t
+ * @brief   Emulator state
+ */
+typedef struct {
+    FILE        *file;
+    int         bitflips;           ///< A bit is flipped on read once in bitflips reads (0=never)
+    int         failures;           ///< A program/erase fails once in failures calls (0=never)
+    unsigned    reads;              ///< Number of page reads
+    unsigned    programs;           ///< Number of page programs
+    unsigned    erases;             ///< Number of block erases
+} NANDFile_t;
+
+int  NAND_File_Init(NAND_t *nand, NANDFile_t *nf, const char *path, int blocks);
+void NAND_File_Close(NANDFile_t *nf);
+
+#endif // NAND_FILE_H
@@ -0,0 +1,151 @@
+/** ***************************************************************************
+ * @file    main.c
+ * @brief   Log structured store in NAND flash for EFM32GG_STK3700
+ * @version 1.0
+******************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+/*
+ * Including this file, it is possible to define which processor using command line
+ * E.g. -DEFM32GG995F1024
+ * The alternative is to include the processor specific file directly
+ * #include "efm32gg995f1024.h"
+ */
+#include "em_device.h"
+#include "clock_efm32gg.h"
+
+#include "led.h"
+#include "uart.h"
+#include "nand.h"
+#include "flashlog.h"
+
+
+/*************************************************************************//**
+ * @brief  Sys Tick Handler
+ */
+const int TickDivisor = 1000; // milliseconds
+
+volatile uint64_t tick = 0;
+
+void SysTick_Handler (void) {
+static int counter = 0;
+
+    tick++;
+
+    if( counter == 0 ) {
+        counter = TickDivisor;
+        // Process every second
+        LED_Toggle(LED0);
+    }
+    counter--;
+}
+
+/**
+ * @brief   Log store and NAND. Static because they are big
+ */
+static NAND_t nand;
+static FLog_t flog;
+static FLogCursor_t cursor;
+
+/**
+ * @brief   Record stored in log
+ */
+typedef struct {
+    uint32_t    counter;
+    uint32_t    timestamp;
+    uint8_t     payload[56];
+} Record_t;
+
+/**************************************************************************//**
+ * @brief  Prints statistics
+ */
+
+void PrintStats(void) {
+FLogStats_t st;
+
+    FLog_GetStats(&flog,&st);
+    printf("Blocks: %d free %d used %d bad\n",st.freeblocks,st.usedblocks,st.badblocks);
+    printf("Erase count: min %u max %u\n",st.minerases,st.maxerases);
+    printf("Pages written: %lu Erases: %lu\n",(unsigned long) st.pageswritten,(unsigned long) st.erases);
+    printf("ECC: %lu corrected %lu uncorrectable\n",(unsigned long) st.corrected,(unsigned long) st.uncorrectable);
+}
+
+/**************************************************************************//**
+ * @brief  Main function
+ *
+ * @note   Using external crystal oscillator
+ *         HFCLK = HFXO
+ *         HFCORECLK = HFCLK
+ *         HFPERCLK  = HFCLK
+ */
+
+int main(void) {
+Record_t rec = { 0 };
+uint64_t start,elapsed,next;
+int n,len;
+
+    /* Configure LEDs */
+    LED_Init(LED0|LED1);
+
+    // Set clock source to external crystal: 48 MHz
+    (void) SystemCoreClockSet(CLOCK_HFXO,1,1);
+
+    /* Turn on LEDs */
+    LED_Write(0,LED0|LED1);
+
+    /* Configure SysTick */
+    SysTick_Config(SystemCoreClock/TickDivisor);
+
+    /* Configure UART */
+    UART_Init();
+
+    __enable_irq();
+
+    printf("\r\n\n\n\rFlash Log\n\r");
+
+    /* Rebuild index from NAND */
+    NAND_EFM32GG_Init(&nand);
+    start = tick;
+    if( FLog_Mount(&flog,&nand) < 0 ) {
+        printf("Could not mount log\n");
+        while(1) {}
+    }
+    printf("Mount: %lu ms\n",(unsigned long) (tick-start));
+    PrintStats();
+
+    /* Count records already in log */
+    n = 0;
+    FLog_Rewind(&flog,&cursor);
+    while( (len = FLog_Read(&flog,&cursor,&rec,sizeof(rec))) >= 0 )
+        n++;
+    printf("Records in log: %d (last counter %lu)\n",n,(unsigned long) rec.counter);
+
+    /* Throughput */
+    start = tick;
+    for(n=0;n<1000;n++) {
+        rec.counter++;
+        rec.timestamp = tick;
+        FLog_Append(&flog,&rec,sizeof(rec));
+    }
+    FLog_Sync(&flog);
+    elapsed = tick-start;
+    printf("1000 records of %d bytes in %lu ms\n",(int) sizeof(rec),(unsigned long) elapsed);
+
+    /* Log a record every 100 ms */
+    next = tick;
+    while (1) {
+        if( tick >= next ) {
+            next += 100;
+            rec.counter++;
+            rec.timestamp = tick;
+            if( FLog_Append(&flog,&rec,sizeof(rec)) < 0 )
+                LED_On(LED1);
+            if( (rec.counter%100) == 0 ) {
+                FLog_Sync(&flog);
+                PrintStats();
+            }
+        }
+    }
+
+}
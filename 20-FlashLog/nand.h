@@ -0,0 +1,51 @@
+#ifndef NAND_H
+#define NAND_H
+/**
+ * @file    nand.h
+ * @brief   Interface to a NAND flash device
+ *
+ * @note    The log store (flashlog.c) only accesses the flash through this
+ *          interface. So it can use the NAND in the STK3700 (nand_efm32gg.c)
+ *          or a file emulating it in a host (host/nand_file.c).
+ * @note    All functions return 0 on success and -1 on failure.
+ */
+#include <stdint.h>
+
+/**
+ * @typedef NAND_t
+ * @brief   Geometry and access functions of a NAND flash
+ */
+typedef struct {
+    int     pagesize;               ///< Size of data area of a page (bytes)
+    int     sparesize;              ///< Size of spare area of a page (bytes)
+    int     pagesperblock;          ///< Number of pages in a block (erase unit)
+    int     blocks;                 ///< Number of blocks
+    int     badblockpos;            ///< Position of factory bad block marker in spare area
+    /// Read data and spare area of a page. Both data and spare can be 0
+    int     (*read)(void *dev, int page, uint8_t *data, uint8_t *spare);
+    /// Program data and spare area of a page. Only clears bits, so a page can be
+    /// programmed again with the bits already cleared (partial page programming)
+    int     (*program)(void *dev, int page, const uint8_t *data, const uint8_t *spare);
+    /// Erase a block
+    int     (*erase)(void *dev, int block);
+    /// Returns 1 when block is marked as bad
+    int     (*isbad)(void *dev, int block);
+    /// Marks block as bad
+    int     (*markbad)(void *dev, int block);
+    void    *dev;                   ///< Device specific data
+} NAND_t;
+
+/**
+ * @brief   NAND256W3A in the STK3700 (32 MB, 512+16 byte pages, 32 pages per block)
+ */
+///@{
+#define NAND256W3A_PAGESIZE         512
+#define NAND256W3A_SPARESIZE        16
+#define NAND256W3A_PAGESPERBLOCK    32
+#define NAND256W3A_BLOCKS           2048
+#define NAND256W3A_BADBLOCKPOS      5
+///@}
+
+int NAND_EFM32GG_Init(NAND_t *nand);
+
+#endif // NAND_H
@@ -0,0 +1,320 @@
+/** **************************************************************************
+ * @file    nand_efm32gg.c
+ * @brief   NAND flash driver for EFM32GG STK3700
+ * @version 1.0
+ *
+ * @note    The STK3700 has a NAND256W3A (32 MB, 512+16 byte pages, 32 pages
+ *          per block) connected to the EBI (External Bus Interface).
+ *
+ * @note    Connections
+ *
+ *          | Signal   | Pin       | Note                                 |
+ *          |----------|-----------|--------------------------------------|
+ *          | I/O0-7   | PE8-PE15  | EBI_AD00-EBI_AD07                    |
+ *          | ALE      | PC1       | EBI_A24. Address 0x81000000          |
+ *          | CLE      | PC2       | EBI_A25. Address 0x82000000          |
+ *          | WE#      | PF8       | EBI_NANDWEn                          |
+ *          | RE#      | PF9       | EBI_NANDREn                          |
+ *          | WP#      | PD13      | GPIO. Active low                     |
+ *          | CE#      | PD14      | GPIO. Active low                     |
+ *          | R/B#     | PD15      | GPIO. Low when busy                  |
+ *          | Power    | PB15      | GPIO. High to power NAND             |
+ *
+ * @note    Does not use the ECC hardware of the EBI. ECC is done by flashlog.c,
+ *          so the same code runs on the host emulator
+ *
+ *****************************************************************************/
+
+#include <stdint.h>
+#include "em_device.h"
+#include "nand.h"
+
+/**
+ * @brief   Macros to enhance portability
+ */
+#define BIT(N) (1U<<(N))
+
+/// NAND registers are accessed through EBI bank 0
+///@{
+#define NAND_DATA   (*(volatile uint8_t *) 0x80000000)
+#define NAND_ADDR   (*(volatile uint8_t *) 0x81000000)
+#define NAND_CMD    (*(volatile uint8_t *) 0x82000000)
+///@}
+
+/// NAND256W3A commands
+///@{
+#define CMD_READA       0x00
+#define CMD_READC       0x50
+#define CMD_PROGRAM     0x80
+#define CMD_PROGRAM2    0x10
+#define CMD_ERASE       0x60
+#define CMD_ERASE2      0xD0
+#define CMD_STATUS      0x70
+#define CMD_RESET       0xFF
+///@}
+
+/// Status bits
+///@{
+#define STATUS_FAIL     BIT(0)
+#define STATUS_READY    BIT(6)
+///@}
+
+/// GPIO Ports used
+///@{
+static GPIO_P_TypeDef * const GPIOB = &(GPIO->P[1]);
+static GPIO_P_TypeDef * const GPIOC = &(GPIO->P[2]);
+static GPIO_P_TypeDef * const GPIOD = &(GPIO->P[3]);
+static GPIO_P_TypeDef * const GPIOE = &(GPIO->P[4]);
+static GPIO_P_TypeDef * const GPIOF = &(GPIO->P[5]);
+///@}
+
+/// Control pins
+///@{
+#define WP_PIN      13
+#define CE_PIN      14
+#define RB_PIN      15
+#define POWER_PIN   15
+///@}
+
+/**
+ * @brief   Configures a pin
+ *
+ * @note    mode is one of _GPIO_P_MODEL_MODE0_xxx values
+ */
+
+static void
+pinmode(GPIO_P_TypeDef *port, int pin, uint32_t mode) {
+
+    if( pin < 8 ) {
+        port->MODEL = (port->MODEL&~(0xFUL<<(4*pin)))|(mode<<(4*pin));
+    } else {
+        pin -= 8;
+        port->MODEH = (port->MODEH&~(0xFUL<<(4*pin)))|(mode<<(4*pin));
+    }
+}
+
+/**
+ * @brief   Chip enable
+ */
+///@{
+static inline void select(void)   { GPIOD->DOUTCLR = BIT(CE_PIN); }
+static inline void deselect(void) { GPIOD->DOUTSET = BIT(CE_PIN); }
+///@}
+
+/**
+ * @brief   Waits while NAND is busy
+ *
+ * @note    R/B# goes low up to 100 ns (tWB) after the command
+ */
+
+static void
+waitready(void) {
+volatile int i;
+
+    for(i=0;i<10;i++) {}
+    while( (GPIOD->DIN&BIT(RB_PIN)) == 0 ) {}
+}
+
+/**
+ * @brief   Sends command and page address
+ *
+ * @note    Column address is always 0. NAND256W3A uses two cycles for row address
+ */
+
+static void
+sendaddress(uint8_t cmd, int page) {
+
+    NAND_CMD  = cmd;
+    NAND_ADDR = 0;
+    NAND_ADDR = page;
+    NAND_ADDR = page>>8;
+}
+
+/**
+ * @brief   Reads status after a program or erase operation
+ */
+
+static int
+status(void) {
+
+    NAND_CMD = CMD_STATUS;
+    return NAND_DATA;
+}
+
+/**
+ * @brief   Reads a page
+ *
+ * @note    When data is 0, reads only spare area (READ C command)
+ */
+
+static int
+nand_read(void *dev, int page, uint8_t *data, uint8_t *spare) {
+int i;
+
+    select();
+    sendaddress(data?CMD_READA:CMD_READC,page);
+    waitready();
+    if( data ) {
+        for(i=0;i<NAND256W3A_PAGESIZE;i++)
+            data[i] = NAND_DATA;
+    }
+    for(i=0;i<NAND256W3A_SPARESIZE;i++) {
+        if( spare )
+            spare[i] = NAND_DATA;
+        else
+            (void) NAND_DATA;
+    }
+    if( !data )
+        NAND_CMD = CMD_READA;               // Pointer back to area A
+    deselect();
+    return 0;
+}
+
+/**
+ * @brief   Programs a page
+ */
+
+static int
+nand_program(void *dev, int page, const uint8_t *data, const uint8_t *spare) {
+int i,st;
+
+    select();
+    NAND_CMD = CMD_READA;                   // Pointer to area A
+    sendaddress(CMD_PROGRAM,page);
+    for(i=0;i<NAND256W3A_PAGESIZE;i++)
+        NAND_DATA = data ? data[i] : 0xFF;
+    for(i=0;i<NAND256W3A_SPARESIZE;i++)
+        NAND_DATA = spare ? spare[i] : 0xFF;
+    NAND_CMD = CMD_PROGRAM2;
+    waitready();
+    st = status();
+    NAND_CMD = CMD_READA;
+    deselect();
+    return (st&STATUS_FAIL) ? -1 : 0;
+}
+
+/**
+ * @brief   Erases a block
+ */
+
+static int
+nand_erase(void *dev, int block) {
+int page = block*NAND256W3A_PAGESPERBLOCK;
+int st;
+
+    select();
+    NAND_CMD  = CMD_ERASE;
+    NAND_ADDR = page;
+    NAND_ADDR = page>>8;
+    NAND_CMD  = CMD_ERASE2;
+    waitready();
+    st = status();
+    NAND_CMD = CMD_READA;
+    deselect();
+    return (st&STATUS_FAIL) ? -1 : 0;
+}
+
+/**
+ * @brief   Verifies factory bad block marker
+ *
+ * @note    Block is bad when byte 5 of spare area of first or second page is not 0xFF
+ */
+
+static int
+nand_isbad(void *dev, int block) {
+uint8_t spare[NAND256W3A_SPARESIZE];
+int page = block*NAND256W3A_PAGESPERBLOCK;
+
+    nand_read(dev,page,0,spare);
+    if( spare[NAND256W3A_BADBLOCKPOS] != 0xFF )
+        return 1;
+    nand_read(dev,page+1,0,spare);
+    return spare[NAND256W3A_BADBLOCKPOS] != 0xFF;
+}
+
+/**
+ * @brief   Marks a block bad
+ */
+
+static int
+nand_markbad(void *dev, int block) {
+uint8_t spare[NAND256W3A_SPARESIZE];
+int i;
+
+    for(i=0;i<NAND256W3A_SPARESIZE;i++)
+        spare[i] = 0xFF;
+    spare[NAND256W3A_BADBLOCKPOS] = 0;
+    (void) nand_erase(dev,block);
+    return nand_program(dev,block*NAND256W3A_PAGESPERBLOCK,0,spare);
+}
+
+/**
+ * @brief   Initializes EBI and NAND
+ *
+ * @note    Timing for HFCORECLK up to 48 MHz (1 cycle = 21 ns)
+ */
+
+int NAND_EFM32GG_Init(NAND_t *nand) {
+int pin;
+
+    /* Enable clocks for GPIO and EBI */
+    CMU->HFPERCLKDIV |= CMU_HFPERCLKDIV_HFPERCLKEN;
+    CMU->HFPERCLKEN0 |= CMU_HFPERCLKEN0_GPIO;
+    CMU->HFCORECLKEN0 |= CMU_HFCORECLKEN0_EBI;
+
+    /* Power on NAND */
+    pinmode(GPIOB,POWER_PIN,_GPIO_P_MODEL_MODE0_PUSHPULL);
+    GPIOB->DOUTSET = BIT(POWER_PIN);
+
+    /* WP# high (writes allowed), CE# high (not selected), R/B# input */
+    pinmode(GPIOD,WP_PIN,_GPIO_P_MODEL_MODE0_PUSHPULL);
+    pinmode(GPIOD,CE_PIN,_GPIO_P_MODEL_MODE0_PUSHPULL);
+    pinmode(GPIOD,RB_PIN,_GPIO_P_MODEL_MODE0_INPUT);
+    GPIOD->DOUTSET = BIT(WP_PIN)|BIT(CE_PIN);
+
+    /* ALE, CLE */
+    pinmode(GPIOC,1,_GPIO_P_MODEL_MODE0_PUSHPULL);
+    pinmode(GPIOC,2,_GPIO_P_MODEL_MODE0_PUSHPULL);
+    GPIOC->DOUTCLR = BIT(1)|BIT(2);
+
+    /* I/O0-7 */
+    for(pin=8;pin<=15;pin++)
+        pinmode(GPIOE,pin,_GPIO_P_MODEL_MODE0_PUSHPULL);
+
+    /* WE#, RE# */
+    pinmode(GPIOF,8,_GPIO_P_MODEL_MODE0_PUSHPULL);
+    pinmode(GPIOF,9,_GPIO_P_MODEL_MODE0_PUSHPULL);
+    GPIOF->DOUTSET = BIT(8)|BIT(9);
+
+    /* EBI: 8 bit data and address, bank 0, NAND mode */
+    EBI->CTRL       = EBI_CTRL_MODE_D8A8|EBI_CTRL_NOIDLE;
+    EBI->ADDRTIMING = 0;
+    EBI->RDTIMING   = (2<<_EBI_RDTIMING_RDSTRB_SHIFT)|(1<<_EBI_RDTIMING_RDHOLD_SHIFT);
+    EBI->WRTIMING   = (2<<_EBI_WRTIMING_WRSTRB_SHIFT)|(1<<_EBI_WRTIMING_WRHOLD_SHIFT);
+    EBI->POLARITY   = _EBI_POLARITY_RESETVALUE;         // All active low
+    EBI->ROUTE      = EBI_ROUTE_EBIPEN|EBI_ROUTE_NANDPEN
+                     |EBI_ROUTE_ALB_A24|EBI_ROUTE_APEN_A26
+                     |EBI_ROUTE_LOCATION_LOC1;
+    EBI->NANDCTRL   = EBI_NANDCTRL_BANKSEL_BANK0|EBI_NANDCTRL_EN;
+    EBI->CTRL      |= EBI_CTRL_BANK0EN;
+
+    /* Reset NAND */
+    select();
+    NAND_CMD = CMD_RESET;
+    waitready();
+    deselect();
+
+    nand->pagesize      = NAND256W3A_PAGESIZE;
+    nand->sparesize     = NAND256W3A_SPARESIZE;
+    nand->pagesperblock = NAND256W3A_PAGESPERBLOCK;
+    nand->blocks        = NAND256W3A_BLOCKS;
+    nand->badblockpos   = NAND256W3A_BADBLOCKPOS;
+    nand->read          = nand_read;
+    nand->program       = nand_program;
+    nand->erase         = nand_erase;
+    nand->isbad         = nand_isbad;
+    nand->markbad       = nand_markbad;
+    nand->dev           = 0;
+
+    return 0;
+}
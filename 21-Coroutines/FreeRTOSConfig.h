@@ -0,0 +1,49 @@
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+/**
+ * @file    FreeRTOSConfig.h
+ * @brief   FreeRTOS configuration for the benchmark (bench_freertos.c)
+ *
+ * @note    Only static allocation is used, so no heap file is linked
+ *
+ * @see     http://www.freertos.org/a00110.html
+ */
+
+#define configUSE_PREEMPTION                    1
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     0
+#define configCPU_CLOCK_HZ                      ( ( unsigned long ) 48000000 )
+#define configTICK_RATE_HZ                      ( ( TickType_t ) 1000 )
+#define configMINIMAL_STACK_SIZE                ( ( unsigned short ) 100 )
+#define configMAX_TASK_NAME_LEN                 ( 3 )
+#define configUSE_TRACE_FACILITY                0
+#define configUSE_16_BIT_TICKS                  0
+#define configIDLE_SHOULD_YIELD                 0
+#define configUSE_CO_ROUTINES                   0
+#define configUSE_TIMERS                        0
+#define configUSE_MUTEXES                       0
+#define configMAX_PRIORITIES                    ( 2 )
+#define configSUPPORT_STATIC_ALLOCATION         1
+#define configSUPPORT_DYNAMIC_ALLOCATION        0
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+
+#define INCLUDE_vTaskPrioritySet                0
+#define INCLUDE_uxTaskPriorityGet               0
+#define INCLUDE_vTaskDelete                     0
+#define INCLUDE_vTaskCleanUpResources           0
+#define INCLUDE_vTaskSuspend                    0
+#define INCLUDE_vTaskDelayUntil                 0
+#define INCLUDE_vTaskDelay                      1
+
+#define configKERNEL_INTERRUPT_PRIORITY         255
+/* !!!! configMAX_SYSCALL_INTERRUPT_PRIORITY must not be set to zero !!!!
+See http://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html. */
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY    191 /* equivalent to 0xa0, or priority 5. */
+
+#define vPortSVCHandler                         SVC_Handler
+#define xPortPendSVHandler                      PendSV_Handler
+#define xPortSysTickHandler                     SysTick_Handler
+
+#endif /* FREERTOS_CONFIG_H */
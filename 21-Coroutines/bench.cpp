@@ -0,0 +1,161 @@
+/**
+ * @file        bench.cpp
+ * @brief       compares the cost of resuming a C++20 coroutine, a protothread
+ *              and a FreeRTOS task switch
+ *
+ * @note        Measured, in cycles per switch:
+ *              - coroutine resumed directly (handle.resume()), suspending at once
+ *              - two coroutines alternating with co_await coro::yield(), through
+ *                the ready queue of the executor
+ *              - a protothread called directly, returning with PT_YIELD
+ *              - two protothreads called in turn, as the main loop of
+ *                15-Protothreads does
+ *              - two FreeRTOS tasks alternating with taskYIELD (bench_freertos.c)
+ *
+ * @note        The loop overhead is included in all of them. The FreeRTOS
+ *              measurement also includes the tick interrupts.
+ * @note        Uses the DWT cycle counter
+ */
+
+#include <stdint.h>
+
+extern "C" {
+#include "em_device.h"
+#include "uart.h"
+#include "pt.h"
+}
+
+#include "coro.h"
+#include "bench.h"
+
+/// Number of switches for each measurement
+#define SWITCHES    (10000)
+
+Bench_t Bench_Results[BENCH_N];
+
+/**
+ * @brief   Coroutine suspending at each resume
+ */
+static coro::Task
+suspender(void) {
+
+    while(1)
+        co_await std::suspend_always();
+}
+
+/**
+ * @brief   Coroutine yielding n times to the executor
+ */
+static coro::Task
+yielder(unsigned n) {
+
+    for(unsigned i=0;i<n;i++)
+        co_await coro::yield();
+}
+
+/**
+ * @brief   Protothread yielding at each call. Not inlined, as when called
+ *          by a scheduler
+ */
+static __attribute__((noinline))
+PT_THREAD(ptyielder(struct pt *pt)) {
+
+    PT_BEGIN(pt);
+    while(1)
+        PT_YIELD(pt);
+    PT_END(pt);
+}
+
+/**
+ * @brief   Writes a number in decimal
+ */
+static void
+printnumber(unsigned n) {
+char s[12];
+int i = sizeof(s)-1;
+
+    s[i] = '\0';
+    do {
+        s[--i] = '0'+n%10;
+        n /= 10;
+    } while( n );
+    UART_SendString(&s[i]);
+}
+
+/**
+ * @details Writes cycles per switch with one decimal
+ */
+
+void Bench_Report(int k, const char *name, uint32_t count, uint32_t cycles) {
+uint32_t t;
+
+    Bench_Results[k].name   = name;
+    Bench_Results[k].count  = count;
+    Bench_Results[k].cycles = cycles;
+
+    t = (uint32_t) (((uint64_t) cycles*10+count/2)/count);
+    UART_SendString((char *) name);
+    UART_SendString((char *) ": ");
+    printnumber(t/10);
+    UART_SendString((char *) ".");
+    printnumber(t%10);
+    UART_SendString((char *) " cycles\r\n");
+}
+
+/**
+ * @details Coroutines and protothreads are measured before SysTick is
+ *          enabled. FreeRTOS starts it
+ */
+
+void Bench_Run(void) {
+std::coroutine_handle<> h;
+struct pt pt1, pt2;
+uint32_t c;
+int i;
+
+    CoreDebug->DEMCR = CoreDebug->DEMCR|CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL = DWT->CTRL|DWT_CTRL_CYCCNTENA_Msk;
+
+    UART_SendString((char *) "\r\nCycles per switch\r\n");
+
+    /* Coroutine resumed directly */
+    h = suspender().release();
+    h.resume();
+    c = DWT->CYCCNT;
+    for(i=0;i<SWITCHES;i++)
+        h.resume();
+    c = DWT->CYCCNT-c;
+    h.destroy();
+    Bench_Report(0,"Coroutine resume",SWITCHES,c);
+
+    /* Two coroutines through the executor */
+    coro::spawn(yielder(SWITCHES/2));
+    coro::spawn(yielder(SWITCHES/2));
+    c = DWT->CYCCNT;
+    coro::dispatch();
+    c = DWT->CYCCNT-c;
+    Bench_Report(1,"Coroutine yield (executor)",SWITCHES,c);
+
+    /* Protothread called directly */
+    PT_INIT(&pt1);
+    c = DWT->CYCCNT;
+    for(i=0;i<SWITCHES;i++)
+        ptyielder(&pt1);
+    c = DWT->CYCCNT-c;
+    Bench_Report(2,"Protothread call",SWITCHES,c);
+
+    /* Two protothreads in turn */
+    PT_INIT(&pt1);
+    PT_INIT(&pt2);
+    c = DWT->CYCCNT;
+    for(i=0;i<SWITCHES/2;i++) {
+        ptyielder(&pt1);
+        ptyielder(&pt2);
+    }
+    c = DWT->CYCCNT-c;
+    Bench_Report(3,"Protothread loop",SWITCHES,c);
+
+    /* FreeRTOS. Does not return */
+    Bench_FreeRTOS(4,SWITCHES);
+}
@@ -0,0 +1,58 @@
+#ifndef BENCH_H
+#define BENCH_H
+/**
+ * @file        bench.h
+ * @brief       compares the cost of resuming a C++20 coroutine, a protothread
+ *              and a FreeRTOS task switch
+ *
+ * @note        Only compiled with BENCHMARK defined (make BENCHMARK=1).
+ *              Results are left in Bench_Results, to be read with a debugger,
+ *              and written to the UART
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @typedef Bench_t
+ * @brief   Cycles for one switch, measured over many
+ */
+typedef struct {
+    const char  *name;
+    uint32_t    count;                  ///< number of switches measured
+    uint32_t    cycles;                 ///< total cycles
+} Bench_t;
+
+/// Number of measurements
+#define BENCH_N     (5)
+
+extern Bench_t Bench_Results[BENCH_N];
+
+/**
+ * @fn      Bench_Run
+ * @brief   Runs all measurements. Does not return (FreeRTOS scheduler is
+ *          started for the last one)
+ */
+void Bench_Run(void);
+
+/**
+ * @fn      Bench_Report
+ * @brief   Stores and writes result k
+ */
+void Bench_Report(int k, const char *name, uint32_t count, uint32_t cycles);
+
+/**
+ * @fn      Bench_FreeRTOS
+ * @brief   Measures count task switches between two tasks with the same
+ *          priority calling taskYIELD. Reports it as result k
+ */
+void Bench_FreeRTOS(int k, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BENCH_H
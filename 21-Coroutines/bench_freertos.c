@@ -0,0 +1,79 @@
+/**
+ * @file        bench_freertos.c
+ * @brief       measures FreeRTOS task switches (see bench.cpp)
+ *
+ * @note        Two tasks with the same priority alternate calling taskYIELD.
+ *              Tasks are created with static memory, so no heap is used.
+ * @note        Only compiled with BENCHMARK defined (make BENCHMARK=1)
+ */
+
+#include <stdint.h>
+
+#include "em_device.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+/// Stack size of the benchmark tasks (words)
+#define STACKSIZE   (configMINIMAL_STACK_SIZE)
+
+static StaticTask_t tcb[2];
+static StackType_t  stack[2][STACKSIZE];
+static StaticTask_t idletcb;
+static StackType_t  idlestack[configMINIMAL_STACK_SIZE];
+
+static volatile uint32_t remaining;
+static uint32_t total;
+static uint32_t start;
+static int result;
+static int started = 0;
+static int done = 0;
+
+/**
+ * @brief   Memory for the idle task (configSUPPORT_STATIC_ALLOCATION)
+ */
+void vApplicationGetIdleTaskMemory(StaticTask_t **tcbp, StackType_t **stackp, uint32_t *sizep) {
+
+    *tcbp   = &idletcb;
+    *stackp = idlestack;
+    *sizep  = configMINIMAL_STACK_SIZE;
+}
+
+/**
+ * @brief   Task yielding until all switches are done. The first one to see it
+ *          reports the result
+ */
+static void
+yielder(void *p) {
+
+    if( !started ) {
+        started = 1;
+        start = DWT->CYCCNT;
+    }
+    while( remaining > 0 ) {
+        remaining--;
+        taskYIELD();
+    }
+    if( !done ) {
+        done = 1;
+        Bench_Report(result,"FreeRTOS task switch",total,DWT->CYCCNT-start);
+    }
+    while(1)
+        vTaskDelay(portMAX_DELAY);
+}
+
+/**
+ * @details Starts the scheduler. Does not return
+ */
+
+void Bench_FreeRTOS(int k, uint32_t count) {
+
+    result    = k;
+    total     = count;
+    remaining = count;
+    xTaskCreateStatic(yielder,"Y0",STACKSIZE,0,1,stack[0],&tcb[0]);
+    xTaskCreateStatic(yielder,"Y1",STACKSIZE,0,1,stack[1],&tcb[1]);
+    vTaskStartScheduler();
+}
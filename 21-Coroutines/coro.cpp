@@ -0,0 +1,295 @@
+/**
+ * @file    coro.cpp
+ * @brief   Static executor and frame arena for C++20 coroutines
+ *
+ * @note    Ready coroutines are kept in a circular queue of handles. Each
+ *          coroutine is at most once in it, so CORO_FRAMES entries are enough.
+ *
+ * @note    Coroutines waiting for a timeout are in a list sorted by wakeup tick,
+ *          so only its head is checked. Coroutines waiting for an event are in
+ *          the list of the event. Both use the Waiter kept in the coroutine
+ *          frame by the awaitable, so no memory is allocated.
+ *
+ * @note    Interrupt routines only touch two words: tick increments the tick
+ *          counter and post sets bits of the pending events with LDREX/STREX.
+ *          The lists are only changed by dispatch and the coroutines.
+ *
+ * @note    Frames are blocks of a fixed arena. Free blocks are linked by their
+ *          first word. Blocks never used are taken in order, so the arena needs
+ *          no initialization.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "em_device.h"
+#include "coro.h"
+
+/**
+ * @brief   Macros to enhance portability
+ */
+#define LOAD_EXCLUSIVE(A)       __LDREXW((volatile uint32_t *)(A))
+#define STORE_EXCLUSIVE(V,A)    __STREXW((uint32_t)(V),(volatile uint32_t *)(A))
+
+#if CORO_FRAME_SIZE%8
+#error "CORO_FRAME_SIZE must be a multiple of 8"
+#endif
+
+namespace coro {
+
+/**
+ * @brief   Frame arena
+ */
+///@{
+alignas(8) static uint8_t arena[CORO_FRAMES][CORO_FRAME_SIZE];
+static void     *freelist = nullptr;
+static unsigned unused = 0;             ///< blocks never used start here
+static unsigned inuse = 0;
+static unsigned maxinuse = 0;
+static size_t   maxsize = 0;
+static unsigned refused = 0;
+///@}
+
+/**
+ * @brief   Executor
+ */
+///@{
+static std::coroutine_handle<> queue[CORO_FRAMES];
+static unsigned qfirst = 0;
+static unsigned qn = 0;
+static Waiter   *timers = nullptr;
+static Waiter   *events[CORO_EVENTS];
+static volatile uint32_t ticks = 0;
+static volatile uint32_t pending = 0;
+static uint32_t nresumes = 0;
+///@}
+
+/**
+ * @details Returns nullptr when the arena is full or n is too large.
+ *          Then the coroutine is not created (Task not valid)
+ */
+
+void *Arena::allocate(size_t n) noexcept {
+void *p;
+
+    if( n > maxsize )
+        maxsize = n;
+    if( n > CORO_FRAME_SIZE ) {
+        refused++;
+        return nullptr;
+    }
+    if( freelist ) {
+        p = freelist;
+        freelist = *(void **) p;
+    } else if( unused < CORO_FRAMES ) {
+        p = arena[unused++];
+    } else {
+        refused++;
+        return nullptr;
+    }
+    if( ++inuse > maxinuse )
+        maxinuse = inuse;
+    return p;
+}
+
+void Arena::release(void *p) noexcept {
+
+    *(void **) p = freelist;
+    freelist = p;
+    inuse--;
+}
+
+unsigned Arena::used(void) noexcept      { return inuse; }
+unsigned Arena::peak(void) noexcept      { return maxinuse; }
+size_t   Arena::largest(void) noexcept   { return maxsize; }
+unsigned Arena::failures(void) noexcept  { return refused; }
+
+/**
+ * @details Puts h at the end of the ready queue
+ */
+
+void schedule(std::coroutine_handle<> h) noexcept {
+
+    if( qn == CORO_FRAMES )             // can not happen: one entry per frame
+        return;
+    queue[(qfirst+qn)%CORO_FRAMES] = h;
+    qn++;
+}
+
+/**
+ * @details The coroutine is owned by the executor from now on
+ */
+
+bool spawn(Task &&t) noexcept {
+
+    if( !t || (qn == CORO_FRAMES) )
+        return false;
+    schedule(t.release());
+    return true;
+}
+
+/**
+ * @details Inserts w in the timer list, after the ones with same wakeup
+ */
+
+void wait_timer(Waiter *w) noexcept {
+Waiter **p = &timers;
+
+    while( *p && ((int32_t) ((*p)->wakeup-w->wakeup) <= 0) )
+        p = &(*p)->next;
+    w->next = *p;
+    *p = w;
+}
+
+/**
+ * @details w->cond is tested when the event is posted
+ */
+
+void wait_event(int e, Waiter *w) noexcept {
+
+    w->next = events[e];
+    events[e] = w;
+}
+
+/**
+ * @brief   Takes pending events and readies the coroutines waiting for them
+ *          whose condition is true
+ */
+
+static void
+wake_events(void) {
+uint32_t e;
+Waiter **p;
+Waiter *w;
+int i;
+
+    do {
+        e = LOAD_EXCLUSIVE(&pending);
+    } while( STORE_EXCLUSIVE(0,&pending) );
+
+    while( e ) {
+        i = 31-__CLZ(e);
+        e &= ~(1UL<<i);
+        p = &events[i];
+        while( (w=*p) != nullptr ) {
+            if( !w->cond || w->cond(w) ) {
+                *p = w->next;
+                schedule(w->handle);
+            } else {
+                p = &w->next;
+            }
+        }
+    }
+}
+
+/**
+ * @brief   Readies the coroutines whose timeout expired
+ */
+
+static void
+wake_timers(void) {
+uint32_t now = ticks;
+Waiter *w;
+
+    while( (w=timers) && ((int32_t) (w->wakeup-now) <= 0) ) {
+        timers = w->next;
+        schedule(w->handle);
+    }
+}
+
+/**
+ * @details Events and timeouts are checked before each resume. A coroutine
+ *          that ended is destroyed and its frame returns to the arena
+ */
+
+void dispatch(void) noexcept {
+std::coroutine_handle<> h;
+
+    while(1) {
+        if( pending )
+            wake_events();
+        wake_timers();
+        if( qn == 0 )
+            break;
+        h = queue[qfirst];
+        qfirst = (qfirst+1)%CORO_FRAMES;
+        qn--;
+        nresumes++;
+        h.resume();
+        if( h.done() )
+            h.destroy();
+    }
+}
+
+bool ready(void) noexcept {
+
+    return qn || pending || (timers && ((int32_t) (timers->wakeup-ticks) <= 0));
+}
+
+void tick(void) noexcept {
+
+    ticks = ticks+1;                    // ++ on volatile is deprecated in C++20
+}
+
+/**
+ * @details Sets the bits with LDREX/STREX, so it can be called by
+ *          interrupts of any priority
+ */
+
+void post(uint32_t e) noexcept {
+uint32_t v;
+
+    do {
+        v = LOAD_EXCLUSIVE(&pending);
+    } while( STORE_EXCLUSIVE(v|e,&pending) );
+}
+
+uint32_t time(void) noexcept {
+
+    return ticks;
+}
+
+uint32_t resumes(void) noexcept {
+
+    return nresumes;
+}
+
+/**
+ * @details Takes one count if there is one
+ */
+
+bool Semaphore::tryacquire(void) noexcept {
+
+    if( count == 0 )
+        return false;
+    count--;
+    return true;
+}
+
+void Semaphore::enqueue(Waiter *w) noexcept {
+
+    w->next = nullptr;
+    if( tail )
+        tail->next = w;
+    else
+        head = w;
+    tail = w;
+}
+
+/**
+ * @details The first waiting coroutine takes the count
+ */
+
+void Semaphore::release(void) noexcept {
+Waiter *w = head;
+
+    if( !w ) {
+        count++;
+        return;
+    }
+    head = w->next;
+    if( !head )
+        tail = nullptr;
+    schedule(w->handle);
+}
+
+} // namespace coro
@@ -0,0 +1,224 @@
+#ifndef CORO_H
+#define CORO_H
+/**
+ * @file    coro.h
+ * @brief   Stackless coroutines (C++20) with a static executor
+ *
+ * @note    A coroutine is a function returning coro::Task and using co_await.
+ *          Unlike protothreads, local variables are kept across suspension
+ *          points (they live in the coroutine frame) and switch statements
+ *          can be used freely.
+ *
+ *              coro::Task Blinker(void) {
+ *
+ *                  for(unsigned n=0;;n++) {
+ *                      LED_Toggle(LED0);
+ *                      co_await coro::delay(500);
+ *                  }
+ *              }
+ *              ...
+ *              coro::spawn(Blinker());
+ *
+ * @note    Frames come from a fixed arena of CORO_FRAMES blocks of
+ *          CORO_FRAME_SIZE bytes. There is no heap. When the arena is full or
+ *          the frame is too large, the Task is not valid and spawn fails.
+ *          Arena::largest gives the largest frame requested, to adjust
+ *          CORO_FRAME_SIZE.
+ *
+ * @note    All objects are constant initialized (constexpr constructors),
+ *          because the startup code does not run static constructors.
+ *
+ * @note    Interrupt routines only call coro::tick and coro::post. Everything
+ *          else must be called by coroutines or the main loop.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <coroutine>
+
+/// Number of frames in arena (maximum number of coroutines)
+#ifndef CORO_FRAMES
+#define CORO_FRAMES     (16)
+#endif
+
+/// Size of each frame (bytes). Must be a multiple of 8
+#ifndef CORO_FRAME_SIZE
+#define CORO_FRAME_SIZE (192)
+#endif
+
+/// Tick frequency (Hz)
+#ifndef CORO_TICK_HZ
+#define CORO_TICK_HZ    (1000)
+#endif
+
+/// Number of events. Event e is bit e in coro::post
+#define CORO_EVENTS     (32)
+
+namespace coro {
+
+/**
+ * @brief   Fixed arena of coroutine frames
+ */
+class Arena {
+public:
+    static void    *allocate(size_t n) noexcept;
+    static void     release(void *p) noexcept;
+    static unsigned used(void) noexcept;        ///< frames in use
+    static unsigned peak(void) noexcept;        ///< maximum frames in use
+    static size_t   largest(void) noexcept;     ///< largest frame requested
+    static unsigned failures(void) noexcept;    ///< allocations refused
+};
+
+/**
+ * @brief   Handle to a coroutine, returned by a coroutine function
+ *
+ * @note    The coroutine starts suspended. coro::spawn gives it to the
+ *          executor, which destroys it when it ends
+ */
+class Task {
+public:
+    struct promise_type {
+        static void *operator new(size_t n) noexcept { return Arena::allocate(n); }
+        static void  operator delete(void *p) noexcept { Arena::release(p); }
+        static Task  get_return_object_on_allocation_failure(void) noexcept { return Task(); }
+
+        Task get_return_object(void) noexcept {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend(void) noexcept { return {}; }
+        std::suspend_always final_suspend(void) noexcept { return {}; }
+        void return_void(void) noexcept {}
+        void unhandled_exception(void) noexcept { for(;;) {} }
+    };
+
+    constexpr Task() noexcept : handle() {}
+    explicit Task(std::coroutine_handle<promise_type> h) noexcept : handle(h) {}
+    Task(Task &&t) noexcept : handle(t.handle) { t.handle = nullptr; }
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+    ~Task() { if( handle ) handle.destroy(); }
+
+    /// Valid when the frame was allocated
+    explicit operator bool() const noexcept { return (bool) handle; }
+
+    /// Gives the handle away (used by spawn and the benchmark)
+    std::coroutine_handle<> release(void) noexcept {
+        std::coroutine_handle<> h = handle;
+        handle = nullptr;
+        return h;
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle;
+};
+
+/**
+ * @brief   A suspended coroutine waiting for a timeout or an event
+ *
+ * @note    Awaitables derive from Waiter, so it is kept in the coroutine
+ *          frame and the executor needs no memory for it. When the event is
+ *          posted, cond (if set) is called to tell if the coroutine can go on
+ */
+struct Waiter {
+    Waiter                  *next = nullptr;
+    std::coroutine_handle<> handle;
+    uint32_t                wakeup = 0;
+    bool                    (*cond)(Waiter *) = nullptr;
+};
+
+/**
+ * @brief   Executor
+ */
+///@{
+bool     spawn(Task &&t) noexcept;                  ///< false if t is not valid or queue full
+void     dispatch(void) noexcept;                   ///< runs until no coroutine is ready
+bool     ready(void) noexcept;                      ///< call with interrupts disabled
+void     tick(void) noexcept;                       ///< called by the timer interrupt
+void     post(uint32_t events) noexcept;            ///< can be called by interrupts
+uint32_t time(void) noexcept;                       ///< ticks since start
+uint32_t resumes(void) noexcept;                    ///< number of resumes
+///@}
+
+/**
+ * @brief   Used by awaitables
+ */
+///@{
+void     schedule(std::coroutine_handle<> h) noexcept;  ///< puts at end of ready queue
+void     wait_timer(Waiter *w) noexcept;                ///< until w->wakeup
+void     wait_event(int event, Waiter *w) noexcept;     ///< until event (and w->cond)
+///@}
+
+/**
+ * @brief   Awaitable for a delay until a tick
+ */
+struct DelayUntil : Waiter {
+    constexpr explicit DelayUntil(uint32_t tick) noexcept { wakeup = tick; }
+    bool await_ready(void) const noexcept { return (int32_t) (wakeup-time()) <= 0; }
+    void await_suspend(std::coroutine_handle<> h) noexcept { handle = h; wait_timer(this); }
+    void await_resume(void) const noexcept {}
+};
+
+/// Waits ticks ticks
+inline DelayUntil delay(uint32_t ticks) noexcept { return DelayUntil(time()+ticks); }
+
+/// Waits until tick tick. Used for periodic coroutines without drift
+inline DelayUntil delay_until(uint32_t tick) noexcept { return DelayUntil(tick); }
+
+/**
+ * @brief   Awaitable to let other ready coroutines run
+ */
+struct Yield {
+    bool await_ready(void) const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) const noexcept { schedule(h); }
+    void await_resume(void) const noexcept {}
+};
+
+inline Yield yield(void) noexcept { return Yield(); }
+
+/**
+ * @brief   Awaitable for an event posted by an interrupt
+ */
+struct Event : Waiter {
+    int event;
+    constexpr explicit Event(int e) noexcept : event(e) {}
+    bool await_ready(void) const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) noexcept { handle = h; wait_event(event,this); }
+    void await_resume(void) const noexcept {}
+};
+
+inline Event event(int e) noexcept { return Event(e); }
+
+/**
+ * @brief   Counting semaphore between coroutines (not for interrupts)
+ *
+ * @note    release gives the count directly to the first waiting coroutine,
+ *          so waiters are served in FIFO order
+ */
+class Semaphore {
+public:
+    constexpr explicit Semaphore(unsigned n = 0) noexcept : count(n), head(nullptr), tail(nullptr) {}
+
+    struct Acquire : Waiter {
+        Semaphore &s;
+        constexpr explicit Acquire(Semaphore &sem) noexcept : s(sem) {}
+        bool await_ready(void) noexcept { return s.tryacquire(); }
+        void await_suspend(std::coroutine_handle<> h) noexcept { handle = h; s.enqueue(this); }
+        void await_resume(void) const noexcept {}
+    };
+
+    Acquire  acquire(void) noexcept { return Acquire(*this); }
+    bool     tryacquire(void) noexcept;
+    void     release(void) noexcept;
+    unsigned value(void) const noexcept { return count; }
+
+private:
+    void enqueue(Waiter *w) noexcept;
+
+    unsigned    count;
+    Waiter      *head;
+    Waiter      *tail;
+};
+
+} // namespace coro
+
+#endif // CORO_H
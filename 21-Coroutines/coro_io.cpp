@@ -0,0 +1,79 @@
+/**
+ * @file    coro_io.cpp
+ * @brief   Awaitables for the UART and the buttons of the board
+ *
+ * @note    The interrupt routines only post an event. The conditions, that
+ *          read the data, run in dispatch, so the HALs are not called by
+ *          two coroutines at the same time.
+ */
+
+#include <stdint.h>
+
+extern "C" {
+#include "uart.h"
+#include "button.h"
+}
+
+#include "coro_io.h"
+
+namespace coro {
+
+/**
+ * @brief   Callbacks called by the interrupt routines
+ */
+///@{
+static void uart_received(void)         { post(1UL<<CORO_EVENT_UART); }
+static void button_changed(uint32_t)    { post(1UL<<CORO_EVENT_BUTTON); }
+///@}
+
+void io_init(void) noexcept {
+
+    UART_SetRxCallback(uart_received);
+    Button_SetCallback(button_changed);
+}
+
+/**
+ * @details Tells if there is a byte. If so, keeps it
+ */
+
+bool UartByte::get(Waiter *w) noexcept {
+UartByte *u = static_cast<UartByte *>(w);
+
+    u->ch = (char) UART_GetCharNoWait();
+    return u->ch != 0;
+}
+
+/**
+ * @details Stores the bytes received. Tells if the line is complete
+ */
+
+bool UartLine::get(Waiter *w) noexcept {
+UartLine *u = static_cast<UartLine *>(w);
+char ch;
+
+    while( (ch=(char) UART_GetCharNoWait()) != 0 ) {
+        if( (ch == '\r') || (ch == '\n') ) {
+            if( u->n > 0 )
+                break;
+            continue;
+        }
+        u->buf[u->n++] = ch;
+        if( u->n == u->size-1 )
+            break;
+    }
+    u->buf[u->n] = '\0';
+    return (ch != 0) && (u->n > 0);
+}
+
+/**
+ * @details Tells if a button changed. If so, keeps the changes
+ */
+
+bool ButtonChange::get(Waiter *w) noexcept {
+ButtonChange *b = static_cast<ButtonChange *>(w);
+
+    b->changes = Button_ReadChanges();
+    return b->changes != 0;
+}
+
+} // namespace coro
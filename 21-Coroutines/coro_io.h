@@ -0,0 +1,82 @@
+#ifndef CORO_IO_H
+#define CORO_IO_H
+/**
+ * @file    coro_io.h
+ * @brief   Awaitables for the UART and the buttons of the board
+ *
+ * @note    coro::io_init sets the callbacks of the receive interrupt
+ *          (uart.c) and of the button interrupts (button.c) to post
+ *          CORO_EVENT_UART and CORO_EVENT_BUTTON. UART_Init and Button_Init
+ *          must be called before.
+ *
+ *              char c = co_await coro::uart_byte();
+ *              int  n = co_await coro::uart_line(line,sizeof(line));
+ *              uint32_t b = co_await coro::button();
+ */
+
+#include <stdint.h>
+#include "coro.h"
+
+/// Events used by the interrupts
+///@{
+#define CORO_EVENT_UART     (0)
+#define CORO_EVENT_BUTTON   (1)
+///@}
+
+namespace coro {
+
+void io_init(void) noexcept;
+
+/**
+ * @brief   Awaitable for a byte from the UART
+ *
+ * @note    A received 0 is ignored, because UART_GetCharNoWait returns 0
+ *          when there is no data
+ */
+struct UartByte : Waiter {
+    char ch = 0;
+    static bool get(Waiter *w) noexcept;
+    bool await_ready(void) noexcept { return get(this); }
+    void await_suspend(std::coroutine_handle<> h) noexcept { handle = h; cond = get; wait_event(CORO_EVENT_UART,this); }
+    char await_resume(void) const noexcept { return ch; }
+};
+
+inline UartByte uart_byte(void) noexcept { return UartByte(); }
+
+/**
+ * @brief   Awaitable for a line from the UART
+ *
+ * @note    The line ends with CR or LF, which are not stored, or when the
+ *          buffer is full. It is always terminated by a 0. Empty lines
+ *          are ignored. Returns the length
+ */
+struct UartLine : Waiter {
+    char    *buf;
+    int     size;
+    int     n = 0;
+    UartLine(char *b, int s) noexcept : buf(b), size(s) {}
+    static bool get(Waiter *w) noexcept;
+    bool await_ready(void) noexcept { return get(this); }
+    void await_suspend(std::coroutine_handle<> h) noexcept { handle = h; cond = get; wait_event(CORO_EVENT_UART,this); }
+    int  await_resume(void) const noexcept { return n; }
+};
+
+inline UartLine uart_line(char *buf, int size) noexcept { return UartLine(buf,size); }
+
+/**
+ * @brief   Awaitable for a change of the buttons. Returns the buttons
+ *          changed (BUTTON0, BUTTON1). Button_Read gives their state
+ */
+struct ButtonChange : Waiter {
+    uint32_t changes = 0;
+    static bool get(Waiter *w) noexcept;
+    bool     await_ready(void) noexcept { return get(this); }
+    void     await_suspend(std::coroutine_handle<> h) noexcept { handle = h; cond = get; wait_event(CORO_EVENT_BUTTON,this); }
+    uint32_t await_resume(void) const noexcept { return changes; }
+};
+
+inline ButtonChange button(void) noexcept { return ButtonChange(); }
+
+} // namespace coro
+
+#endif // CORO_IO_H
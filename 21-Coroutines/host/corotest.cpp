@@ -0,0 +1,307 @@
+/**
+ * @file    corotest.cpp
+ * @brief   Host test of the coroutine executor (coro.cpp) and awaitables (coro_io.cpp)
+ *
+ * @note    Runs the coroutines of main.cpp, with the LEDs replaced by counters,
+ *          in virtual time: each step counts a tick and calls dispatch, as the
+ *          SysTick interrupt and the main loop do. The UART input and the
+ *          buttons are simulated and call the callbacks set by coro::io_init,
+ *          as the interrupts do.
+ *
+ * @note    Checks
+ *          - all coroutines are spawned (frames fit in CORO_FRAME_SIZE)
+ *          - the delays end at the right tick
+ *          - button presses reach Counter through the semaphore and
+ *            releases are ignored
+ *          - lines are received and answered, also while another
+ *            coroutine waits
+ *          - a frame too large and a full arena are refused
+ *
+ *          Prints PASS or the failed checks. The exit status is the number
+ *          of failures.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+extern "C" {
+#include "uart.h"
+#include "button.h"
+}
+
+#include "coro.h"
+#include "coro_io.h"
+
+/**
+ * @brief   Simulated UART
+ *
+ * @note    Chars up to rxavail can be read. Output is kept in txbuf
+ */
+///@{
+static const char   *rxdata = "";
+static unsigned     rxpos = 0;
+static unsigned     rxavail = 0;
+static void         (*rxcallback)(void) = 0;
+static char         txbuf[1000];
+static unsigned     txlen = 0;
+
+extern "C" unsigned UART_GetCharNoWait(void) {
+
+    if( rxpos < rxavail )
+        return (unsigned char) rxdata[rxpos++];
+    return 0;
+}
+
+extern "C" void UART_SendString(char *s) {
+
+    while( *s && (txlen < sizeof(txbuf)-1) )
+        txbuf[txlen++] = *s++;
+    txbuf[txlen] = '\0';
+}
+
+extern "C" void UART_SetRxCallback(void (*proc)(void)) {
+
+    rxcallback = proc;
+}
+
+/**
+ * @brief   Makes s available, as the receive interrupt does
+ */
+
+static void
+receive(const char *s) {
+
+    rxdata  = s;
+    rxpos   = 0;
+    rxavail = strlen(s);
+    if( rxcallback )
+        rxcallback();
+}
+///@}
+
+/**
+ * @brief   Simulated buttons, with the semantics of button.c
+ *
+ * @note    Buttons are active low. Both are released at start
+ */
+///@{
+static uint32_t     lastread    = BUTTON0|BUTTON1;
+static uint32_t     newestread  = BUTTON0|BUTTON1;
+static void         (*buttoncallback)(uint32_t) = 0;
+
+extern "C" uint32_t Button_Read(void) {
+
+    return newestread;
+}
+
+extern "C" uint32_t Button_ReadChanges(void) {
+uint32_t changes;
+
+    changes = newestread^lastread;
+    lastread = newestread;
+    return changes;
+}
+
+extern "C" void Button_SetCallback(void (*proc)(uint32_t parm)) {
+
+    buttoncallback = proc;
+}
+
+/**
+ * @brief   Changes button b, as the GPIO interrupt does
+ */
+
+static void
+button(uint32_t b, int pressed) {
+
+    lastread   = (lastread&~b)|(newestread&b);
+    newestread = pressed ? (newestread&~b) : (newestread|b);
+    if( buttoncallback )
+        buttoncallback(b);
+}
+///@}
+
+/**
+ * @brief   Results
+ */
+///@{
+static unsigned blinks = 0;             ///< LED0 changes
+static uint32_t lastblink = 0;          ///< tick of last LED0 change
+static unsigned toggles = 0;            ///< LED1 changes
+static unsigned counted = 0;            ///< presses counted by Counter
+static int      failures = 0;
+///@}
+
+static coro::Semaphore presses;
+
+/**
+ * @brief   Prints a failed check
+ */
+
+static void
+check(bool ok, const char *what) {
+
+    if( !ok ) {
+        printf("FAIL: %s\n",what);
+        failures++;
+    }
+}
+
+/**
+ * @brief   Coroutines of main.cpp. LEDs are counted
+ */
+///@{
+static coro::Task
+Blinker(void) {
+
+    for(unsigned n=0;;n++) {
+        blinks++;
+        lastblink = coro::time();
+        co_await coro::delay(500);
+    }
+}
+
+static coro::Task
+Buttons(void) {
+uint32_t changes;
+
+    while(1) {
+        changes = co_await coro::button();
+        // Pressed: changed and now low
+        if( changes&~Button_Read() ) {
+            toggles++;
+            presses.release();
+        }
+    }
+}
+
+static coro::Task
+Counter(void) {
+unsigned total = 0;
+
+    while(1) {
+        co_await presses.acquire();
+        total++;
+        counted = total;
+    }
+}
+
+static coro::Task
+Console(void) {
+char line[40];
+int n;
+
+    while(1) {
+        n = co_await coro::uart_line(line,sizeof(line));
+        switch( (n == 1) ? line[0] : 0 ) {
+        case 'b':
+            for(int i=0;i<10;i++) {
+                toggles++;
+                co_await coro::delay(100);
+            }
+            UART_SendString((char *) "blinked\r\n");
+            break;
+        default:
+            UART_SendString((char *) "Hello ");
+            UART_SendString(line);
+            UART_SendString((char *) "\r\n");
+            break;
+        }
+    }
+}
+///@}
+
+/**
+ * @brief   Coroutine with a frame larger than a block of the arena
+ */
+
+static coro::Task
+Large(void) {
+volatile char big[CORO_FRAME_SIZE];
+
+    big[0] = 0;
+    co_await coro::yield();
+    big[1] = big[0];
+}
+
+/**
+ * @brief   Coroutine that waits forever. Used to fill the arena
+ */
+
+static coro::Task
+Idle(void) {
+
+    co_await coro::event(CORO_EVENTS-1);
+}
+
+/**
+ * @brief   Runs until tick end, as SysTick and the main loop do
+ */
+
+static void
+rununtil(uint32_t end) {
+
+    while( coro::time() < end ) {
+        coro::tick();
+        coro::dispatch();
+    }
+}
+
+int main(void) {
+unsigned spawned,n;
+
+    coro::io_init();
+
+    check(coro::spawn(Blinker()),"spawn Blinker");
+    check(coro::spawn(Buttons()),"spawn Buttons");
+    check(coro::spawn(Counter()),"spawn Counter");
+    check(coro::spawn(Console()),"spawn Console");
+    coro::dispatch();
+    printf("Largest frame %u bytes, CORO_FRAME_SIZE %u\n",
+            (unsigned) coro::Arena::largest(),(unsigned) CORO_FRAME_SIZE);
+
+    // Blinker runs at 0, 500, ..., 10000
+    rununtil(10000);
+    check(blinks == 21,"Blinker runs every 500 ticks");
+    check(lastblink == 10000,"Blinker last run at tick 10000");
+
+    // A press, its release and a press of the other button
+    button(BUTTON0,1);
+    rununtil(10050);
+    button(BUTTON0,0);
+    rununtil(10100);
+    button(BUTTON1,1);
+    rununtil(10150);
+    check(counted == 2,"two presses counted, release ignored");
+    check(toggles == 2,"LED1 toggled once per press");
+
+    // A line while nothing waits, then a command with delays
+    receive("Ana\r");
+    rununtil(10200);
+    check(strstr(txbuf,"Hello Ana\r\n") != 0,"line answered");
+    receive("b\r");
+    rununtil(11000);
+    check(strstr(txbuf,"blinked") == 0,"b still waiting at tick 11000");
+    button(BUTTON1,0);
+    button(BUTTON0,1);
+    rununtil(11300);
+    check(counted == 3,"press counted while Console waits");
+    check(toggles == 13,"b toggles LED1 ten times");
+    check(strstr(txbuf,"blinked\r\n") != 0,"b ends after ten delays");
+
+    // Arena limits
+    check(!coro::spawn(Large()),"frame larger than CORO_FRAME_SIZE refused");
+    spawned = 0;
+    for(n=0;n<CORO_FRAMES+1;n++) {
+        if( coro::spawn(Idle()) )
+            spawned++;
+    }
+    check(spawned == CORO_FRAMES-4,"arena full after CORO_FRAMES frames");
+    check(coro::Arena::peak() == CORO_FRAMES,"peak is CORO_FRAMES");
+    check(coro::Arena::failures() == 6,"refused allocations counted");
+
+    if( failures == 0 )
+        printf("PASS\n");
+    return failures;
+}
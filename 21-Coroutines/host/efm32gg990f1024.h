@@ -0,0 +1,20 @@
+#ifndef EFM32GG990F1024_H
+#define EFM32GG990F1024_H
+/**
+ * @file    efm32gg990f1024.h
+ * @brief   Host replacement of the device header for the executor test
+ *
+ * @note    em_device.h includes this file instead of the one in the Gecko SDK,
+ *          because the host folder is first in the include path
+ *
+ * @note    Only the CMSIS intrinsics used by coro.cpp are provided. The test
+ *          has no interrupts, so exclusive accesses always succeed
+ */
+
+#include <stdint.h>
+
+static inline uint32_t __LDREXW(volatile uint32_t *a)               { return *a; }
+static inline uint32_t __STREXW(uint32_t v, volatile uint32_t *a)   { *a = v; return 0; }
+static inline uint32_t __CLZ(uint32_t x)                            { return x ? __builtin_clz(x) : 32; }
+
+#endif // EFM32GG990F1024_H
@@ -0,0 +1,233 @@
+/** ***************************************************************************
+ * @file    main.cpp
+ * @brief   C++20 coroutines demo for EFM32GG_STK3700
+ * @version 1.0
+ *
+ * @note    Four coroutines share the processor:
+ *          - Blinker toggles LED0 every 500 ms
+ *          - Buttons toggles LED1 when a button is pressed and releases a
+ *            semaphore
+ *          - Counter waits for the semaphore and prints the number of presses
+ *          - Console reads lines from the UART and answers them
+ *
+ * @note    With BENCHMARK defined (make BENCHMARK=1), only the benchmark
+ *          (bench.cpp) runs.
+******************************************************************************/
+
+#include <stdint.h>
+
+extern "C" {
+/*
+ * Including this file, it is possible to define which processor using command line
+ * E.g. -DEFM32GG995F1024
+ * The alternative is to include the processor specific file directly
+ * #include "efm32gg995f1024.h"
+ */
+#include "em_device.h"
+#include "clock_efm32gg.h"
+
+#include "led.h"
+#include "uart.h"
+#include "button.h"
+}
+
+#include "coro.h"
+#include "coro_io.h"
+#include "bench.h"
+
+#ifndef BENCHMARK
+
+/// Counts button presses
+static coro::Semaphore presses;
+
+/*****************************************************************************
+ * @brief  SysTick interrupt handler
+ *
+ * @note   Just counts the tick
+ * @note   Called every 1 ms
+ */
+
+extern "C" void SysTick_Handler(void) {
+    coro::tick();
+}
+
+/**
+ * @brief   Writes a number in decimal
+ */
+
+static void
+printnumber(unsigned n) {
+char s[12];
+int i = sizeof(s)-1;
+
+    s[i] = '\0';
+    do {
+        s[--i] = '0'+n%10;
+        n /= 10;
+    } while( n );
+    UART_SendString(&s[i]);
+}
+
+/*****************************************************************************
+ * @brief  Blinker coroutine
+ *
+ * @note   The counter is a local variable, kept in the frame
+ */
+
+static coro::Task
+Blinker(void) {
+
+    for(unsigned n=0;;n++) {
+        if( n%2 )
+            LED_On(LED0);
+        else
+            LED_Off(LED0);
+        co_await coro::delay(500);
+    }
+}
+
+/*****************************************************************************
+ * @brief  Buttons coroutine
+ */
+
+static coro::Task
+Buttons(void) {
+uint32_t changes;
+
+    while(1) {
+        changes = co_await coro::button();
+        // Pressed: changed and now low
+        if( changes&~Button_Read() ) {
+            LED_Toggle(LED1);
+            presses.release();
+        }
+    }
+}
+
+/*****************************************************************************
+ * @brief  Counter coroutine
+ */
+
+static coro::Task
+Counter(void) {
+unsigned total = 0;
+
+    while(1) {
+        co_await presses.acquire();
+        total++;
+        UART_SendString((char *) "Presses: ");
+        printnumber(total);
+        UART_SendString((char *) "\r\n");
+    }
+}
+
+/*****************************************************************************
+ * @brief  Console coroutine
+ *
+ * @note   A switch with co_await inside its cases, what protothreads can
+ *         not do
+ */
+
+static coro::Task
+Console(void) {
+char line[40];
+int n;
+
+    UART_SendString((char *) "\r\nCommands: b (blink LED1 5 times), t (time), or your name\r\n");
+    while(1) {
+        n = co_await coro::uart_line(line,sizeof(line));
+        switch( (n == 1) ? line[0] : 0 ) {
+        case 'b':
+            for(int i=0;i<10;i++) {
+                LED_Toggle(LED1);
+                co_await coro::delay(100);
+            }
+            break;
+        case 't':
+            printnumber(coro::time());
+            UART_SendString((char *) " ms\r\n");
+            break;
+        default:
+            UART_SendString((char *) "Hello ");
+            UART_SendString(line);
+            UART_SendString((char *) "\r\n");
+            break;
+        }
+    }
+}
+
+/*****************************************************************************
+ * @brief  Gives a coroutine to the executor. Stops when it can not
+ *
+ * @note   Its frame is larger than CORO_FRAME_SIZE or the arena is full.
+ *         The largest frame requested is printed, to adjust CORO_FRAME_SIZE
+ */
+
+static void
+spawn(coro::Task &&t, const char *name) {
+
+    if( coro::spawn(static_cast<coro::Task &&>(t)) )
+        return;
+    __enable_irq();                     // the UART output is interrupt driven
+    UART_SendString((char *) "\r\nCan not spawn ");
+    UART_SendString((char *) name);
+    UART_SendString((char *) ": largest frame ");
+    printnumber(coro::Arena::largest());
+    UART_SendString((char *) " bytes, CORO_FRAME_SIZE ");
+    printnumber(CORO_FRAME_SIZE);
+    UART_SendString((char *) "\r\n");
+    LED_On(LED0|LED1);
+    while(1) {}
+}
+
+#endif
+
+/*****************************************************************************
+ * @brief  Main function
+ *
+ * @note   Using external crystal oscillator
+ *         HFCLK = HFXO
+ *         HFCORECLK = HFCLK
+ *         HFPERCLK  = HFCLK
+ */
+
+int main(void) {
+
+    /* Configure LEDs */
+    LED_Init(LED0|LED1);
+
+    // Set clock source to external crystal: 48 MHz
+    (void) SystemCoreClockSet(CLOCK_HFXO,1,1);
+
+    /* Configure UART */
+    UART_Init();
+
+#ifdef BENCHMARK
+    __enable_irq();
+    Bench_Run();
+#else
+    /* Configure buttons */
+    Button_Init(BUTTON0|BUTTON1);
+    coro::io_init();
+
+    /* Create coroutines. Frames come from the arena */
+    spawn(Blinker(),"Blinker");
+    spawn(Buttons(),"Buttons");
+    spawn(Counter(),"Counter");
+    spawn(Console(),"Console");
+
+    /* Configure SysTick */
+    SysTick_Config(SystemCoreClock/CORO_TICK_HZ);
+
+    __enable_irq();
+
+    /* Run ready coroutines and sleep when there is none */
+    while (1) {
+        coro::dispatch();
+        __disable_irq();
+        if( !coro::ready() )
+            __WFI();
+        __enable_irq();
+    }
+#endif
+}